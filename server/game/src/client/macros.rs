@@ -151,22 +151,21 @@ macro_rules! gs_with_alloca_guarded {
 }
 
 /// i love over optimizing things!
-/// when invoked as `gs_inline_encode!(self, size, buf, {code})`, uses alloca to make space on the stack,
+/// when invoked as `gs_inline_encode!(self, size, buf, tcp, udp_seq, {code})`, uses alloca to make space on the stack,
 /// and lets you encode a packet. afterwards automatically tries a non-blocking send and on failure falls back to a Vec<u8> and an async send.
+/// `size` must include the 4 byte prefix, which is the packet length for tcp and `udp_seq` for udp.
 macro_rules! gs_inline_encode {
-    ($self:ident, $size:expr, $data:ident, $tcp:expr, $code:expr) => {
-        gs_inline_encode!($self, $size, $data, $tcp, _rawdata, $code)
+    ($self:ident, $size:expr, $data:ident, $tcp:expr, $seq:expr, $code:expr) => {
+        gs_inline_encode!($self, $size, $data, $tcp, $seq, _rawdata, $code)
     };
 
-    ($self:ident, $size:expr, $data:ident, $tcp:expr, $rawdata:ident, $code:expr) => {
+    ($self:ident, $size:expr, $data:ident, $tcp:expr, $seq:expr, $rawdata:ident, $code:expr) => {
         let retval: Result<Option<Vec<u8>>> = {
             gs_with_alloca_guarded!($self.game_server, $size, $rawdata, {
                 let mut $data = FastByteBuffer::new($rawdata);
 
-                if $tcp {
-                    // reserve space for packet length
-                    $data.write_u32(0);
-                }
+                // reserve space for packet length, or write the sequence number
+                $data.write_u32(if $tcp { 0 } else { $seq });
 
                 $code // user code
 
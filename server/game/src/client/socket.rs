@@ -32,6 +32,8 @@ pub struct ClientSocket {
     pub udp_peer: Option<SocketAddrV4>,
     crypto_box: OnceLock<ChaChaBox>,
     game_server: &'static GameServer,
+    /// sequence number of the next udp datagram, 0 is reserved for sessionless datagrams
+    udp_seq: u32,
 }
 
 // do not touch those, encryption related
@@ -49,6 +51,7 @@ impl ClientSocket {
             udp_peer: None,
             crypto_box: OnceLock::new(),
             game_server,
+            udp_seq: 1,
         }
     }
 
@@ -105,6 +108,13 @@ impl ClientSocket {
         self.udp_peer.replace(udp_peer);
     }
 
+    /// returns the sequence number for the next udp datagram
+    fn next_udp_seq(&mut self) -> u32 {
+        let seq = self.udp_seq;
+        self.udp_seq = self.udp_seq.wrapping_add(1).max(1);
+        seq
+    }
+
     pub fn decrypt<'a>(&self, message: &'a mut [u8]) -> Result<ByteReader<'a>> {
         if message.len() < PacketHeader::SIZE + NONCE_SIZE + MAC_SIZE {
             return Err(PacketHandlingError::MalformedCiphertext);
@@ -189,9 +199,12 @@ impl ClientSocket {
             self.print_packet::<P>(true, Some(if P::ENCRYPTED { "fast + encrypted" } else { "fast" }));
         }
 
+        // tcp packets are prefixed with their length, udp datagrams with a sequence number
+        let udp_seq = if P::SHOULD_USE_TCP { 0 } else { self.next_udp_seq() };
+
         if P::ENCRYPTED {
             // gs_inline_encode! doesn't work here because the borrow checker is silly :(
-            let header_start = if P::SHOULD_USE_TCP { size_of_types!(u32) } else { 0usize };
+            let header_start = size_of_types!(u32);
 
             let nonce_start = header_start + PacketHeader::SIZE;
             let mac_start = nonce_start + NONCE_SIZE;
@@ -203,10 +216,8 @@ impl ClientSocket {
             let to_send: Result<Option<Vec<u8>>> = gs_with_alloca!(total_size, data, {
                 let mut buf = FastByteBuffer::new(data);
 
-                if P::SHOULD_USE_TCP {
-                    // reserve space for packet length
-                    buf.write_u32(0);
-                }
+                // reserve space for packet length, or write the sequence number
+                buf.write_u32(udp_seq);
 
                 // write the header
                 buf.write_packet_header::<P>();
@@ -270,9 +281,7 @@ impl ClientSocket {
                 }
             }
         } else {
-            let prefix_sz = if P::SHOULD_USE_TCP { size_of_types!(u32) } else { 0usize };
-
-            gs_inline_encode!(self, prefix_sz + PacketHeader::SIZE + packet_size, buf, P::SHOULD_USE_TCP, {
+            gs_inline_encode!(self, size_of_types!(u32) + PacketHeader::SIZE + packet_size, buf, P::SHOULD_USE_TCP, udp_seq, {
                 buf.write_packet_header::<P>();
                 encode_fn(&mut buf);
             });
@@ -22,7 +22,7 @@ use crate::{
     data::*,
     managers::ComputedRole,
     server::GameServer,
-    util::{LockfreeMutCell, SimpleRateLimiter},
+    util::{seq_newer, LinkStats, LockfreeMutCell, SequenceOutcome, SequenceTracker, SimpleRateLimiter},
 };
 
 pub use super::*;
@@ -37,6 +37,7 @@ pub enum ServerThreadMessage {
     SmallPacket(([u8; INLINE_BUFFER_SIZE], usize)),
     Packet(Vec<u8>),
     BroadcastVoice(Arc<VoiceBroadcastPacket>),
+    BroadcastVoiceStream(Arc<VoiceStreamBroadcastPacket>),
     BroadcastText(ChatMessageBroadcastPacket),
     BroadcastNotice(ServerNoticePacket),
     BroadcastInvite(RoomInvitePacket),
@@ -75,8 +76,13 @@ pub struct ClientThread {
     message_notify: Notify,
     rate_limiter: LockfreeMutCell<SimpleRateLimiter>,
     voice_rate_limiter: LockfreeMutCell<SimpleRateLimiter>,
+    voice_stream_rate_limiter: LockfreeMutCell<SimpleRateLimiter>,
     chat_rate_limiter: Option<LockfreeMutCell<SimpleRateLimiter>>,
 
+    udp_sequence: SyncMutex<SequenceTracker>,
+    /// sequence number of the newest `PlayerDataPacket`, 0 if none was received yet
+    last_state_seq: AtomicU32,
+
     pub destruction_notify: Arc<Notify>,
 }
 
@@ -89,12 +95,14 @@ impl ClientThread {
     pub fn from_unauthorized(thread: UnauthorizedThread) -> Self {
         let game_server = thread.game_server;
 
-        let (rate_limiter, voice_rate_limiter, chat_rate_limiter) = {
+        let (rate_limiter, voice_rate_limiter, voice_stream_rate_limiter, chat_rate_limiter) = {
             let conf = game_server.bridge.central_conf.lock();
 
             (
                 SimpleRateLimiter::new(conf.tps as usize + 6, Duration::from_millis(900)),
                 SimpleRateLimiter::new(5, Duration::from_millis(1000)),
+                // streamed voice sends a packet per 20ms opus frame, leave some headroom for jitter
+                SimpleRateLimiter::new(60, Duration::from_millis(1000)),
                 if conf.chat_burst_interval != 0 && conf.chat_burst_limit != 0 {
                     Some(SimpleRateLimiter::new(
                         conf.chat_burst_limit as usize,
@@ -137,8 +145,12 @@ impl ClientThread {
             message_notify: Notify::new(),
             rate_limiter: LockfreeMutCell::new(rate_limiter),
             voice_rate_limiter: LockfreeMutCell::new(voice_rate_limiter),
+            voice_stream_rate_limiter: LockfreeMutCell::new(voice_stream_rate_limiter),
             chat_rate_limiter: chat_rate_limiter.map(LockfreeMutCell::new),
 
+            udp_sequence: SyncMutex::new(SequenceTracker::new()),
+            last_state_seq: AtomicU32::new(0),
+
             destruction_notify: thread.destruction_notify,
         }
     }
@@ -149,6 +161,37 @@ impl ClientThread {
 
     /* public api for the main server */
 
+    /// Records the sequence number of a udp datagram from this client, returns `false` if it should be dropped.
+    /// Duplicates are always dropped, and so is player data that is older than the last one we received,
+    /// as it would overwrite newer data. Sessionless datagrams (sequence number 0) are not tracked.
+    pub fn accept_udp_datagram(&self, seq: u32, data: &[u8]) -> bool {
+        if seq == 0 {
+            return true;
+        }
+
+        let mut sequence = self.udp_sequence.lock();
+
+        if sequence.record(seq) == SequenceOutcome::Duplicate {
+            return false;
+        }
+
+        let header = ByteReader::from_bytes(data).read_packet_header();
+        if header.is_ok_and(|h| h.packet_id == PlayerDataPacket::PACKET_ID) {
+            let last = self.last_state_seq.load(Ordering::Relaxed);
+            if last != 0 && !seq_newer(seq, last) {
+                return false;
+            }
+
+            self.last_state_seq.store(seq, Ordering::Relaxed);
+        }
+
+        true
+    }
+
+    pub fn link_stats(&self) -> LinkStats {
+        self.udp_sequence.lock().stats()
+    }
+
     async fn poll_for_messages(&self) -> Option<ServerThreadMessage> {
         {
             let mut mq = self.message_queue.lock().await;
@@ -320,7 +363,7 @@ impl ClientThread {
         self.send_packet_dynamic(&ServerBannedPacket { message, timestamp }).await
     }
 
-    fn is_chat_packet_allowed(&self, voice: bool, len: usize) -> bool {
+    fn is_chat_packet_allowed(&self, packet_id: u16, len: usize) -> bool {
         let accid = self.account_id.load(Ordering::Relaxed);
         if accid == 0 {
             // unauthorized
@@ -333,14 +376,20 @@ impl ClientThread {
         }
 
         // check for slowmode stuffs
-        if voice {
+        if packet_id == VoicePacket::PACKET_ID || packet_id == VoiceStreamPacket::PACKET_ID {
             if len > MAX_VOICE_PACKET_SIZE {
                 // voice packet is too big
                 return false;
             }
 
+            let limiter = if packet_id == VoiceStreamPacket::PACKET_ID {
+                &self.voice_stream_rate_limiter
+            } else {
+                &self.voice_rate_limiter
+            };
+
             // safety: only we can access the rate limiters of our user.
-            let block = !unsafe { self.voice_rate_limiter.get_mut().try_tick() };
+            let block = !unsafe { limiter.get_mut().try_tick() };
             if block {
                 return false;
             }
@@ -370,6 +419,7 @@ impl ClientThread {
             ServerThreadMessage::SmallPacket((mut packet, len)) => self.handle_packet(&mut packet[..len]).await?,
             ServerThreadMessage::BroadcastText(text_packet) => self.send_packet_static(&text_packet).await?,
             ServerThreadMessage::BroadcastVoice(voice_packet) => self.send_packet_dynamic(&*voice_packet).await?,
+            ServerThreadMessage::BroadcastVoiceStream(voice_packet) => self.send_packet_dynamic(&*voice_packet).await?,
             ServerThreadMessage::BroadcastNotice(packet) => {
                 self.send_packet_dynamic(&packet).await?;
                 info!("{} is receiving a notice: {}", self.account_data.lock().name, packet.message);
@@ -401,23 +451,27 @@ impl ClientThread {
             return Err(PacketHandlingError::MalformedMessage);
         }
 
+        let mut data = ByteReader::from_bytes(message);
+        let header = data.read_packet_header()?;
+
         // if we are ratelimited, just discard the packet.
+        // streamed voice is exempt, it has its own limiter in `is_chat_packet_allowed`,
+        // and at one packet per 20ms it would otherwise starve player data and keepalives.
         // safety: only we can use this ratelimiter.
-        if !unsafe { self.rate_limiter.get_mut() }.try_tick() {
+        if header.packet_id != VoiceStreamPacket::PACKET_ID && !unsafe { self.rate_limiter.get_mut() }.try_tick() {
             return Err(PacketHandlingError::Ratelimited);
         }
 
-        let mut data = ByteReader::from_bytes(message);
-        let header = data.read_packet_header()?;
-
         // by far the most common packet, so we try it early
         if header.packet_id == PlayerDataPacket::PACKET_ID {
             return self.handle_player_data(&mut data).await;
         }
 
         // also for optimization, reject the voice/text packet immediately on certain conditions
-        if (header.packet_id == VoicePacket::PACKET_ID || header.packet_id == ChatMessagePacket::PACKET_ID)
-            && !self.is_chat_packet_allowed(header.packet_id == VoicePacket::PACKET_ID, message.len())
+        if (header.packet_id == VoicePacket::PACKET_ID
+            || header.packet_id == VoiceStreamPacket::PACKET_ID
+            || header.packet_id == ChatMessagePacket::PACKET_ID)
+            && !self.is_chat_packet_allowed(header.packet_id, message.len())
         {
             #[cfg(debug_assertions)]
             log::warn!("blocking text/voice packet from {}", self.account_id.load(Ordering::Relaxed));
@@ -436,6 +490,7 @@ impl ClientThread {
             DisconnectPacket::PACKET_ID => self.handle_disconnect(&mut data),
             ConnectionTestPacket::PACKET_ID => self.handle_connection_test(&mut data).await,
             KeepaliveTCPPacket::PACKET_ID => self.handle_keepalive_tcp(&mut data).await,
+            ClockSyncPacket::PACKET_ID => self.handle_clock_sync(&mut data).await,
 
             /* general */
             SyncIconsPacket::PACKET_ID => self.handle_sync_icons(&mut data).await,
@@ -449,7 +504,9 @@ impl ClientThread {
             LevelJoinPacket::PACKET_ID => self.handle_level_join(&mut data).await,
             LevelLeavePacket::PACKET_ID => self.handle_level_leave(&mut data).await,
             PlayerDataPacket::PACKET_ID => self.handle_player_data(&mut data).await,
+            RequestLevelDataPacket::PACKET_ID => self.handle_request_level_data(&mut data).await,
             VoicePacket::PACKET_ID => self.handle_voice(&mut data).await,
+            VoiceStreamPacket::PACKET_ID => self.handle_voice_stream(&mut data).await,
             ChatMessagePacket::PACKET_ID => self.handle_chat_message(&mut data).await,
 
             /* room related */
@@ -1,4 +1,7 @@
-use std::sync::atomic::Ordering;
+use std::{
+    sync::atomic::Ordering,
+    time::{SystemTime, UNIX_EPOCH},
+};
 
 use super::*;
 
@@ -31,6 +34,20 @@ impl ClientThread {
         self.send_packet_static(&KeepaliveTCPResponsePacket).await
     });
 
+    gs_handler!(self, handle_clock_sync, ClockSyncPacket, packet, {
+        let _ = gs_needauth!(self);
+
+        let recv_time = SystemTime::now().duration_since(UNIX_EPOCH)?.as_micros() as u64;
+
+        self.send_packet_static(&ClockSyncResponsePacket {
+            id: packet.id,
+            client_time: packet.client_time,
+            server_recv_time: recv_time,
+            server_send_time: SystemTime::now().duration_since(UNIX_EPOCH)?.as_micros() as u64,
+        })
+        .await
+    });
+
     gs_handler!(self, handle_connection_test, ConnectionTestPacket, packet, {
         self.send_packet_dynamic(&ConnectionTestResponsePacket {
             uid: packet.uid,
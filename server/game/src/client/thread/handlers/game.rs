@@ -83,6 +83,45 @@ impl ClientThread {
             return Ok(());
         }
 
+        self.send_level_data(account_id, level_id, room_id, written_players).await?;
+
+        // send metadata
+        if !metadatas.is_empty() {
+            self.send_packet_dynamic(&LevelPlayerMetadataPacket { players: metadatas }).await?;
+        }
+
+        Ok(())
+    });
+
+    gs_handler!(self, handle_request_level_data, RequestLevelDataPacket, _packet, {
+        let account_id = gs_needauth!(self);
+
+        let level_id = self.level_id.load(Ordering::Relaxed);
+        if level_id == 0 {
+            return Err(PacketHandlingError::UnexpectedPlayerData);
+        }
+
+        let room_id = self.room_id.load(Ordering::Relaxed);
+
+        let written_players = self.game_server.state.room_manager.with_any(room_id, |pm| {
+            pm.manager.get_player_count_on_level(level_id).unwrap_or(1) - 1
+        });
+
+        if written_players == 0 {
+            return Ok(());
+        }
+
+        self.send_level_data(account_id, level_id, room_id, written_players).await
+    });
+
+    /// Sends the data of everyone on the level except `account_id`, fragmented if needed.
+    async fn send_level_data(
+        &self,
+        account_id: i32,
+        level_id: LevelId,
+        room_id: u32,
+        written_players: usize,
+    ) -> crate::client::Result<()> {
         let calc_size = size_of_types!(u32) + size_of_types!(AssociatedPlayerData) * written_players;
         let fragmentation_limit = self.fragmentation_limit.load(Ordering::Relaxed) as usize;
 
@@ -131,13 +170,8 @@ impl ClientThread {
             }
         }
 
-        // send metadata
-        if !metadatas.is_empty() {
-            self.send_packet_dynamic(&LevelPlayerMetadataPacket { players: metadatas }).await?;
-        }
-
         Ok(())
-    });
+    }
 
     gs_handler!(self, handle_request_profiles, RequestPlayerProfilesPacket, packet, {
         let _ = gs_needauth!(self);
@@ -206,6 +240,21 @@ impl ClientThread {
         Ok(())
     });
 
+    gs_handler!(self, handle_voice_stream, VoiceStreamPacket, packet, {
+        let account_id = gs_needauth!(self);
+
+        let vpkt = Arc::new(VoiceStreamBroadcastPacket {
+            player_id: account_id,
+            data: packet.data,
+        });
+
+        self.game_server
+            .broadcast_voice_stream_packet(&vpkt, self.level_id.load(Ordering::Relaxed), self.room_id.load(Ordering::Relaxed))
+            .await;
+
+        Ok(())
+    });
+
     gs_handler!(self, handle_chat_message, ChatMessagePacket, packet, {
         let account_id = gs_needauth!(self);
 
@@ -46,6 +46,13 @@ pub struct DisconnectPacket;
 #[packet(id = 10007)]
 pub struct KeepaliveTCPPacket;
 
+#[derive(Packet, Decodable)]
+#[packet(id = 10008)]
+pub struct ClockSyncPacket {
+    pub id: u32,
+    pub client_time: u64,
+}
+
 #[derive(Packet, Decodable)]
 #[packet(id = 10200)]
 pub struct ConnectionTestPacket {
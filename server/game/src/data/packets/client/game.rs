@@ -24,12 +24,25 @@ pub struct PlayerDataPacket {
     pub meta: Option<PlayerMetadata>,
 }
 
+/// Asks for the same response as `PlayerDataPacket` without changing the stored data,
+/// sent by clients whose own state hasn't changed since their last `PlayerDataPacket`
+#[derive(Packet, Decodable)]
+#[packet(id = 12004)]
+pub struct RequestLevelDataPacket;
+
 #[derive(Packet, Decodable)]
 #[packet(id = 12010, encrypted = true)]
 pub struct VoicePacket {
     pub data: FastEncodedAudioFrame,
 }
 
+/// A single opus frame, prefixed with its sequence number. Sent by clients in the low latency voice mode.
+#[derive(Packet, Decodable)]
+#[packet(id = 12012, encrypted = true)]
+pub struct VoiceStreamPacket {
+    pub data: FastEncodedAudioFrame,
+}
+
 #[derive(Packet, Decodable)]
 #[packet(id = 12011, encrypted = true)]
 pub struct ChatMessagePacket {
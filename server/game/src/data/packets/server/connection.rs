@@ -60,6 +60,16 @@ pub struct ClaimThreadFailedPacket;
 #[packet(id = 20009, tcp = true)]
 pub struct LoginRecoveryFailedPacket;
 
+// times are in microseconds, client_time is echoed back as-is, server times are since the unix epoch
+#[derive(Packet, Encodable, StaticSize)]
+#[packet(id = 20010, tcp = false)]
+pub struct ClockSyncResponsePacket {
+    pub id: u32,
+    pub client_time: u64,
+    pub server_recv_time: u64,
+    pub server_send_time: u64,
+}
+
 // used to communicate a simple message to the user
 #[derive(Packet, Encodable, DynamicSize, Clone)]
 #[packet(id = 20100, tcp = false)]
@@ -25,6 +25,13 @@ pub struct VoiceBroadcastPacket {
     pub data: FastEncodedAudioFrame,
 }
 
+#[derive(Packet, Encodable, DynamicSize)]
+#[packet(id = 22012, encrypted = true, tcp = false)]
+pub struct VoiceStreamBroadcastPacket {
+    pub player_id: i32,
+    pub data: FastEncodedAudioFrame,
+}
+
 #[derive(Clone, Packet, Encodable, StaticSize)]
 #[packet(id = 22011, encrypted = true, tcp = false)]
 pub struct ChatMessageBroadcastPacket {
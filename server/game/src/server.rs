@@ -332,6 +332,12 @@ impl GameServer {
                         // TODO
                         let udp_peer = unsafe { thread.socket.get() }.udp_peer.expect("no udp peer in established thread");
                         clients.remove(&udp_peer);
+
+                        let stats = thread.link_stats();
+                        debug!(
+                            "udp link stats for {udp_peer}: {} received, {} lost, {} reordered, {} duplicated",
+                            stats.received, stats.lost, stats.reordered, stats.duplicated
+                        );
                     }
 
                     // wait until there are no more references to the thread
@@ -397,18 +403,31 @@ impl GameServer {
             SocketAddr::V6(_) => bail!("rejecting request from ipv6 host"),
         };
 
+        // every datagram starts with a sequence number
+        if len < size_of_types!(u32) {
+            bail!("udp datagram from {peer} is too short ({len} bytes)");
+        }
+
+        let seq = u32::from_be_bytes([buf[0], buf[1], buf[2], buf[3]]);
+        let data = &buf[size_of_types!(u32)..len];
+        let len = data.len();
+
         // if it's a ping packet, we can handle it here. otherwise we send it to the appropriate thread.
-        if !self.try_udp_handle(&buf[..len], peer).await? {
+        if !self.try_udp_handle(data, peer).await? {
             let thread = { self.clients.lock().get(&peer).cloned() };
             if let Some(thread) = thread {
+                if !thread.accept_udp_datagram(seq, data) {
+                    return Ok(());
+                }
+
                 thread
                     .push_new_message(if len <= INLINE_BUFFER_SIZE {
                         let mut inline_buf = [0u8; INLINE_BUFFER_SIZE];
-                        inline_buf[..len].clone_from_slice(&buf[..len]);
+                        inline_buf[..len].clone_from_slice(data);
 
                         ServerThreadMessage::SmallPacket((inline_buf, len))
                     } else {
-                        ServerThreadMessage::Packet(buf[..len].to_vec())
+                        ServerThreadMessage::Packet(data.to_vec())
                     })
                     .await;
             }
@@ -435,6 +454,11 @@ impl GameServer {
             .await;
     }
 
+    pub async fn broadcast_voice_stream_packet(&self, vpkt: &Arc<VoiceStreamBroadcastPacket>, level_id: LevelId, room_id: u32) {
+        self.broadcast_user_message(&ServerThreadMessage::BroadcastVoiceStream(vpkt.clone()), vpkt.player_id, level_id, room_id)
+            .await;
+    }
+
     pub async fn broadcast_chat_packet(&self, tpkt: &ChatMessageBroadcastPacket, level_id: LevelId, room_id: u32) {
         self.broadcast_user_message(&ServerThreadMessage::BroadcastText(tpkt.clone()), tpkt.player_id, level_id, room_id)
             .await;
@@ -778,8 +802,9 @@ impl GameServer {
                     player_count: self.state.get_player_count(),
                 };
 
-                let mut buf_array = [0u8; PacketHeader::SIZE + PingResponsePacket::ENCODED_SIZE];
+                let mut buf_array = [0u8; size_of_types!(u32) + PacketHeader::SIZE + PingResponsePacket::ENCODED_SIZE];
                 let mut buf = FastByteBuffer::new(&mut buf_array);
+                buf.write_u32(0); // sessionless, no sequence number
                 buf.write_packet_header::<PingResponsePacket>();
                 buf.write_value(&response);
 
@@ -796,8 +821,9 @@ impl GameServer {
                     warn!("udp peer {peer} tried to claim an invalid thread (with key {})", pkt.secret_key);
 
                     // send a ClaimThreadFailedPacket
-                    let mut buf_array = [0u8; PacketHeader::SIZE];
+                    let mut buf_array = [0u8; size_of_types!(u32) + PacketHeader::SIZE];
                     let mut buf = FastByteBuffer::new(&mut buf_array);
+                    buf.write_u32(0); // sessionless, no sequence number
                     buf.write_packet_header::<ClaimThreadFailedPacket>();
 
                     let send_bytes = buf.as_bytes();
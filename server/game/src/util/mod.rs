@@ -1,9 +1,11 @@
 pub mod channel;
 pub mod lockfreemutcell;
 pub mod rate_limiter;
+pub mod sequence;
 pub mod word_filter;
 
 pub use channel::{SenderDropped, TokioChannel};
 pub use lockfreemutcell::LockfreeMutCell;
 pub use rate_limiter::SimpleRateLimiter;
+pub use sequence::{seq_newer, LinkStats, SequenceOutcome, SequenceTracker};
 pub use word_filter::WordFilter;
@@ -0,0 +1,100 @@
+/// Counters for the udp datagrams received from a client.
+#[derive(Default, Clone, Copy, Debug)]
+pub struct LinkStats {
+    pub received: u64,
+    /// datagrams that have not arrived, ones that arrive late are subtracted again
+    pub lost: u64,
+    pub reordered: u64,
+    pub duplicated: u64,
+}
+
+#[derive(PartialEq, Eq, Clone, Copy, Debug)]
+pub enum SequenceOutcome {
+    InOrder,
+    Reordered,
+    Duplicate,
+}
+
+/// a gap larger than this is assumed to be the start of a new sequence rather than loss or reordering
+const MAX_REORDER_DISTANCE: i32 = 1024;
+/// only this many recent sequence numbers are remembered for detecting duplicates
+const WINDOW_BITS: i32 = 64;
+
+/// Tracks the sequence numbers every udp datagram is prefixed with, to detect loss, reordering and duplicates.
+/// Not thread safe on its own.
+#[derive(Default)]
+pub struct SequenceTracker {
+    started: bool,
+    highest: u32,
+    /// bit N is set if `highest - N` was received
+    window: u64,
+    expected: u64,
+    received: u64,
+    reordered: u64,
+    duplicated: u64,
+}
+
+/// Returns `true` if `a` comes after `b`, taking wraparound into account.
+#[inline]
+pub fn seq_newer(a: u32, b: u32) -> bool {
+    (a.wrapping_sub(b) as i32) > 0
+}
+
+impl SequenceTracker {
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    pub fn record(&mut self, seq: u32) -> SequenceOutcome {
+        if !self.started {
+            self.started = true;
+            self.highest = seq;
+            self.window = 1;
+            self.expected = 1;
+            self.received = 1;
+            return SequenceOutcome::InOrder;
+        }
+
+        let diff = seq.wrapping_sub(self.highest) as i32;
+
+        if !(-MAX_REORDER_DISTANCE < diff && diff < MAX_REORDER_DISTANCE) {
+            self.highest = seq;
+            self.window = 1;
+            self.expected += 1;
+            self.received += 1;
+            return SequenceOutcome::InOrder;
+        }
+
+        if diff > 0 {
+            self.window = if diff >= WINDOW_BITS { 1 } else { (self.window << diff) | 1 };
+            self.highest = seq;
+            self.expected += diff as u64;
+            self.received += 1;
+            return SequenceOutcome::InOrder;
+        }
+
+        let back = -diff;
+        if back < WINDOW_BITS {
+            let bit = 1u64 << back;
+            if self.window & bit != 0 {
+                self.duplicated += 1;
+                return SequenceOutcome::Duplicate;
+            }
+
+            self.window |= bit;
+        }
+
+        self.received += 1;
+        self.reordered += 1;
+        SequenceOutcome::Reordered
+    }
+
+    pub fn stats(&self) -> LinkStats {
+        LinkStats {
+            received: self.received,
+            lost: self.expected.saturating_sub(self.received),
+            reordered: self.reordered,
+            duplicated: self.duplicated,
+        }
+    }
+}
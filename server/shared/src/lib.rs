@@ -38,7 +38,7 @@ pub mod logger;
 pub mod token_issuer;
 pub mod webhook;
 
-pub const SUPPORTED_PROTOCOLS: &[u16] = &[11];
+pub const SUPPORTED_PROTOCOLS: &[u16] = &[12];
 pub const MAX_SUPPORTED_PROTOCOL: u16 = *SUPPORTED_PROTOCOLS.last().unwrap();
 pub const MIN_SUPPORTED_PROTOCOL: u16 = *SUPPORTED_PROTOCOLS.first().unwrap();
 // used for communicating to the user the minimum required mod version for this protocol
@@ -1,10 +1,16 @@
 #pragma once
 
+#include "backend/backend.hpp"
+#include "backend/file_backend.hpp"
+#include "backend/fmod_backend.hpp"
 #include "decoder.hpp"
 #include "encoder.hpp"
 #include "frame.hpp"
 #include "manager.hpp"
 #include "sample_queue.hpp"
 #include "stream.hpp"
+#include "voice_activity.hpp"
+#include "voice_mixer.hpp"
+#include "voice_decode_pool.hpp"
 #include "voice_playback_manager.hpp"
 #include "voice_record_manager.hpp"
@@ -0,0 +1,47 @@
+#pragma once
+#include <defs/platform.hpp>
+
+#ifdef GLOBED_VOICE_SUPPORT
+
+#include <defs/minimal_geode.hpp>
+
+#include <functional>
+#include <memory>
+
+class AudioSampleQueue;
+
+// A mono sound at `VOICE_TARGET_SAMPLERATE` that keeps pulling its samples from a callback until it is destroyed.
+class AudioOutput {
+public:
+    virtual ~AudioOutput() = default;
+
+    virtual Result<> play() = 0;
+    virtual bool isPlaying() = 0;
+    virtual void setVolume(float volume) = 0;
+};
+
+// Everything the voice pipeline needs from the audio system, so it can also run without FMOD or any audio hardware.
+// Device enumeration and UI sounds are not part of this and always go through FMOD.
+class AudioBackend {
+public:
+    // must fill `out` with exactly `samples` samples, called from whatever thread the backend renders audio on
+    using PullCallback = std::function<void(float* out, size_t samples)>;
+
+    virtual ~AudioBackend() = default;
+
+    // start capturing mono audio at `VOICE_TARGET_SAMPLERATE` from the given recording device
+    virtual Result<> startCapture(int deviceId) = 0;
+    virtual void stopCapture() = 0;
+    virtual bool isCapturing() = 0;
+
+    // append everything that was captured since the last call to `out`, or discard it if `out` is null.
+    // returns the amount of captured samples.
+    virtual Result<size_t> readCapture(AudioSampleQueue* out) = 0;
+
+    virtual Result<std::unique_ptr<AudioOutput>> createOutput(PullCallback callback) = 0;
+
+    // called regularly from the audio thread while recording
+    virtual void update() = 0;
+};
+
+#endif // GLOBED_VOICE_SUPPORT
@@ -0,0 +1,148 @@
+#include "file_backend.hpp"
+
+#ifdef GLOBED_VOICE_SUPPORT
+
+#include <algorithm>
+
+#include <audio/constants.hpp>
+#include <audio/sample_queue.hpp>
+#include <util/pcm.hpp>
+#include <util/wav.hpp>
+
+class FileAudioBackend::Output : public AudioOutput {
+public:
+    Output(FileAudioBackend& backend, PullCallback&& callback) : backend(backend), callback(std::move(callback)) {}
+
+    ~Output() override {
+        auto st = backend.state.lock();
+        auto it = std::find(st->outputs.begin(), st->outputs.end(), this);
+        if (it != st->outputs.end()) {
+            st->outputs.erase(it);
+        }
+    }
+
+    Result<> play() override {
+        auto st = backend.state.lock();
+        if (std::find(st->outputs.begin(), st->outputs.end(), this) == st->outputs.end()) {
+            st->outputs.push_back(this);
+        }
+
+        return Ok();
+    }
+
+    bool isPlaying() override {
+        auto st = backend.state.lock();
+        return std::find(st->outputs.begin(), st->outputs.end(), this) != st->outputs.end();
+    }
+
+    void setVolume(float volume) override {
+        this->volume = volume;
+    }
+
+private:
+    friend class FileAudioBackend;
+
+    FileAudioBackend& backend;
+    PullCallback callback;
+    asp::AtomicF32 volume = 1.f;
+};
+
+FileAudioBackend::FileAudioBackend() {}
+
+Result<> FileAudioBackend::setCaptureFile(const std::filesystem::path& path) {
+    GLOBED_UNWRAP_INTO(util::wav::readFile(path), auto wavData);
+
+    if (wavData.sampleRate != VOICE_TARGET_SAMPLERATE) {
+        return Err(fmt::format("capture file must be {}hz, got {}hz", VOICE_TARGET_SAMPLERATE, wavData.sampleRate));
+    }
+
+    this->setCaptureData(std::move(wavData.samples));
+
+    return Ok();
+}
+
+void FileAudioBackend::setCaptureData(std::vector<float> samples) {
+    auto st = state.lock();
+    st->captureSource = std::move(samples);
+    st->captureSourcePos = 0;
+}
+
+void FileAudioBackend::advance(size_t samples) {
+    auto st = state.lock();
+
+    if (st->capturing) {
+        if (st->captureSource.empty()) {
+            st->captured.resize(st->captured.size() + samples, 0.f);
+        } else {
+            for (size_t i = 0; i < samples; i++) {
+                st->captured.push_back(st->captureSource[st->captureSourcePos]);
+                st->captureSourcePos = (st->captureSourcePos + 1) % st->captureSource.size();
+            }
+        }
+    }
+
+    size_t start = st->rendered.size();
+    st->rendered.resize(start + samples, 0.f);
+    st->scratch.resize(samples);
+
+    // outputs can't be destroyed while the state is locked, so it is safe to call them here
+    for (auto* output : st->outputs) {
+        output->callback(st->scratch.data(), samples);
+        util::misc::mixPcm(st->rendered.data() + start, st->scratch.data(), samples, output->volume);
+    }
+
+    st->clock += samples;
+}
+
+uint64_t FileAudioBackend::getClock() {
+    return state.lock()->clock;
+}
+
+std::vector<float> FileAudioBackend::getOutput() {
+    return state.lock()->rendered;
+}
+
+Result<> FileAudioBackend::writeOutputFile(const std::filesystem::path& path) {
+    auto st = state.lock();
+    return util::wav::writeFile(path, st->rendered.data(), st->rendered.size(), VOICE_TARGET_SAMPLERATE);
+}
+
+Result<> FileAudioBackend::startCapture(int) {
+    auto st = state.lock();
+    st->capturing = true;
+    st->captured.clear();
+
+    return Ok();
+}
+
+void FileAudioBackend::stopCapture() {
+    auto st = state.lock();
+    st->capturing = false;
+    st->captured.clear();
+}
+
+bool FileAudioBackend::isCapturing() {
+    return state.lock()->capturing;
+}
+
+Result<size_t> FileAudioBackend::readCapture(AudioSampleQueue* out) {
+    auto st = state.lock();
+    GLOBED_REQUIRE_SAFE(st->capturing, "not capturing")
+
+    size_t captured = st->captured.size();
+    if (out) {
+        out->writeData(st->captured.data(), captured);
+    }
+
+    st->captured.clear();
+
+    return Ok(captured);
+}
+
+Result<std::unique_ptr<AudioOutput>> FileAudioBackend::createOutput(PullCallback callback) {
+    return Ok(std::unique_ptr<AudioOutput>(std::make_unique<Output>(*this, std::move(callback))));
+}
+
+void FileAudioBackend::update() {}
+
+#endif // GLOBED_VOICE_SUPPORT
@@ -0,0 +1,63 @@
+#pragma once
+#include "backend.hpp"
+
+#ifdef GLOBED_VOICE_SUPPORT
+
+#include <asp/sync.hpp>
+
+#include <filesystem>
+#include <vector>
+
+/*
+* Backend that needs no audio hardware, for benchmarks and soak tests.
+* Capture plays back a WAV file (or silence) in a loop, and every playing output is mixed into a buffer
+* that can be saved as a WAV file. Time only moves forward when `advance` is called, so runs are deterministic.
+* All outputs must be destroyed before the backend.
+* Used by `util::bench::voiceHeadless` inside the game, and by `audio_pipeline` in test/ without it.
+*/
+class FileAudioBackend : public AudioBackend {
+public:
+    FileAudioBackend();
+
+    // use this file as the microphone input, it must be mono or stereo at `VOICE_TARGET_SAMPLERATE`
+    Result<> setCaptureFile(const std::filesystem::path& path);
+    void setCaptureData(std::vector<float> samples);
+
+    // move the clock forward by `samples` samples. captures that many samples and pulls that many from every playing output.
+    void advance(size_t samples);
+    // the amount of samples that `advance` has moved the clock by
+    uint64_t getClock();
+
+    // everything that was played, mixed together
+    std::vector<float> getOutput();
+    Result<> writeOutputFile(const std::filesystem::path& path);
+
+    Result<> startCapture(int deviceId) override;
+    void stopCapture() override;
+    bool isCapturing() override;
+    Result<size_t> readCapture(AudioSampleQueue* out) override;
+
+    Result<std::unique_ptr<AudioOutput>> createOutput(PullCallback callback) override;
+
+    void update() override;
+
+private:
+    class Output;
+
+    struct State {
+        std::vector<float> captureSource;
+        size_t captureSourcePos = 0;
+        bool capturing = false;
+        std::vector<float> captured;
+
+        std::vector<Output*> outputs;
+        std::vector<float> rendered;
+        std::vector<float> scratch;
+
+        uint64_t clock = 0;
+    };
+
+    asp::Mutex<State> state;
+};
+
+#endif // GLOBED_VOICE_SUPPORT
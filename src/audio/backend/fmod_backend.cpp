@@ -0,0 +1,228 @@
+#include "fmod_backend.hpp"
+
+#ifdef GLOBED_VOICE_SUPPORT
+
+#include <audio/manager.hpp>
+#include <audio/sample_queue.hpp>
+
+using namespace geode::prelude;
+
+#define FMOD_ERR_CHECK_SAFE(res, msg) \
+    do { \
+        auto _res = (res); \
+        GLOBED_REQUIRE_SAFE(_res == FMOD_OK, GlobedAudioManager::formatFmodError(_res, msg)); \
+    } while (0); \
+
+namespace {
+    class FmodAudioOutput : public AudioOutput {
+    public:
+        FmodAudioOutput(AudioBackend::PullCallback&& callback) : callback(std::move(callback)) {}
+
+        ~FmodAudioOutput() override {
+            // the callback could still be running, make it bail out
+            if (sound) {
+                sound->setUserData(nullptr);
+            }
+
+            if (channel) {
+                channel->stop();
+            }
+
+            if (sound) {
+                sound->release();
+            }
+        }
+
+        Result<> init() {
+            FMOD_CREATESOUNDEXINFO exinfo = {};
+
+            exinfo.cbsize = sizeof(FMOD_CREATESOUNDEXINFO);
+            exinfo.numchannels = 1;
+            exinfo.format = FMOD_SOUND_FORMAT_PCMFLOAT;
+            exinfo.defaultfrequency = VOICE_TARGET_SAMPLERATE;
+            exinfo.userdata = this;
+            exinfo.length = sizeof(float) * exinfo.numchannels * exinfo.defaultfrequency * (VOICE_CHUNK_RECORD_TIME * 1);
+
+            exinfo.pcmreadcallback = [](FMOD_SOUND* sound_, void* data, unsigned int len) -> FMOD_RESULT {
+                FMOD::Sound* sound = reinterpret_cast<FMOD::Sound*>(sound_);
+                FmodAudioOutput* output = nullptr;
+                sound->getUserData((void**)&output);
+
+                if (!output || !data) {
+                    log::warn("audio output is nullptr in cb, ignoring");
+                    return FMOD_OK;
+                }
+
+                output->callback(reinterpret_cast<float*>(data), len / sizeof(float));
+
+                return FMOD_OK;
+            };
+
+            FMOD_ERR_CHECK_SAFE(
+                GlobedAudioManager::get().getSystem()->createStream(nullptr, FMOD_OPENUSER | FMOD_2D | FMOD_LOOP_NORMAL, &exinfo, &sound),
+                "System::createStream"
+            )
+
+            return Ok();
+        }
+
+        Result<> play() override {
+            if (channel) return Ok();
+
+            FMOD_ERR_CHECK_SAFE(
+                GlobedAudioManager::get().getSystem()->playSound(sound, nullptr, false, &channel),
+                "System::playSound"
+            )
+
+            return Ok();
+        }
+
+        bool isPlaying() override {
+            return channel != nullptr;
+        }
+
+        void setVolume(float volume) override {
+            if (channel) {
+                channel->setVolume(volume);
+            }
+        }
+
+    private:
+        AudioBackend::PullCallback callback;
+        FMOD::Sound* sound = nullptr;
+        FMOD::Channel* channel = nullptr;
+    };
+}
+
+FmodAudioBackend::~FmodAudioBackend() {
+    this->releaseRecordSound();
+}
+
+Result<> FmodAudioBackend::startCapture(int deviceId) {
+    this->releaseRecordSound();
+
+    auto system = GlobedAudioManager::get().getSystem();
+
+    FMOD_CREATESOUNDEXINFO exinfo = {};
+
+    exinfo.cbsize = sizeof(FMOD_CREATESOUNDEXINFO);
+    exinfo.numchannels = 1;
+    exinfo.format = FMOD_SOUND_FORMAT_PCMFLOAT;
+    exinfo.defaultfrequency = VOICE_TARGET_SAMPLERATE;
+    exinfo.length = sizeof(float) * exinfo.defaultfrequency * exinfo.numchannels;
+
+    recordChunkSize = exinfo.length;
+
+    FMOD_ERR_CHECK_SAFE(
+        system->createSound(nullptr, FMOD_2D | FMOD_OPENUSER | FMOD_LOOP_NORMAL, &exinfo, &recordSound),
+        "System::createSound"
+    )
+
+    FMOD_RESULT res = system->recordStart(deviceId, recordSound, true);
+
+    // invalid device most likely
+    if (res == FMOD_ERR_RECORD) {
+        return Err("Invalid audio device selected, unable to record");
+    }
+
+    FMOD_ERR_CHECK_SAFE(res, "System::recordStart")
+
+    recordDeviceId = deviceId;
+    recordLastPosition = 0;
+
+    return Ok();
+}
+
+void FmodAudioBackend::stopCapture() {
+    if (recordDeviceId != -1) {
+        FMOD_RESULT res = GlobedAudioManager::get().getSystem()->recordStop(recordDeviceId);
+        if (res != FMOD_OK) {
+            log::warn("{}", GlobedAudioManager::formatFmodError(res, "System::recordStop"));
+        }
+    }
+
+    this->releaseRecordSound();
+    recordDeviceId = -1;
+    recordLastPosition = 0;
+    recordChunkSize = 0;
+}
+
+bool FmodAudioBackend::isCapturing() {
+    if (recordDeviceId == -1) return false;
+
+    bool recording;
+    if (FMOD_OK != GlobedAudioManager::get().getSystem()->isRecording(recordDeviceId, &recording)) {
+        return false;
+    }
+
+    return recording;
+}
+
+Result<size_t> FmodAudioBackend::readCapture(AudioSampleQueue* out) {
+    GLOBED_REQUIRE_SAFE(recordSound != nullptr, "not capturing")
+
+    unsigned int pos;
+    FMOD_ERR_CHECK_SAFE(
+        GlobedAudioManager::get().getSystem()->getRecordPosition(recordDeviceId, &pos),
+        "System::getRecordPosition"
+    )
+
+    // if we are at the same position, do nothing
+    if (pos == recordLastPosition) {
+        return Ok(0);
+    }
+
+    float* pcmData;
+    unsigned int pcmLen;
+
+    FMOD_ERR_CHECK_SAFE(
+        recordSound->lock(0, recordChunkSize, (void**)&pcmData, nullptr, &pcmLen, nullptr),
+        "Sound::lock"
+    )
+
+    size_t captured;
+    unsigned int bufferSamples = pcmLen / sizeof(float);
+
+    if (pos > recordLastPosition) {
+        captured = pos - recordLastPosition;
+        if (out) out->writeData(pcmData + recordLastPosition, captured);
+    } else { // we have reached the end of the buffer
+        captured = bufferSamples - recordLastPosition + pos;
+
+        if (out) {
+            // write the data left at the end
+            out->writeData(pcmData + recordLastPosition, bufferSamples - recordLastPosition);
+            // write the data from beginning to current pos
+            out->writeData(pcmData, pos);
+        }
+    }
+
+    recordLastPosition = pos;
+
+    FMOD_ERR_CHECK_SAFE(
+        recordSound->unlock(pcmData, nullptr, pcmLen, 0),
+        "Sound::unlock"
+    )
+
+    return Ok(captured);
+}
+
+Result<std::unique_ptr<AudioOutput>> FmodAudioBackend::createOutput(PullCallback callback) {
+    auto output = std::make_unique<FmodAudioOutput>(std::move(callback));
+    GLOBED_UNWRAP(output->init());
+
+    return Ok(std::unique_ptr<AudioOutput>(std::move(output)));
+}
+
+void FmodAudioBackend::update() {
+    GlobedAudioManager::get().getSystem()->update();
+}
+
+void FmodAudioBackend::releaseRecordSound() {
+    if (recordSound) {
+        recordSound->release();
+        recordSound = nullptr;
+    }
+}
+
+#endif // GLOBED_VOICE_SUPPORT
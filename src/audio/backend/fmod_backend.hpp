@@ -0,0 +1,31 @@
+#pragma once
+#include "backend.hpp"
+
+#ifdef GLOBED_VOICE_SUPPORT
+
+#include <fmod.hpp>
+
+// The backend used in game, capture and playback go through the FMOD system of GD.
+class FmodAudioBackend : public AudioBackend {
+public:
+    ~FmodAudioBackend() override;
+
+    Result<> startCapture(int deviceId) override;
+    void stopCapture() override;
+    bool isCapturing() override;
+    Result<size_t> readCapture(AudioSampleQueue* out) override;
+
+    Result<std::unique_ptr<AudioOutput>> createOutput(PullCallback callback) override;
+
+    void update() override;
+
+private:
+    int recordDeviceId = -1;
+    FMOD::Sound* recordSound = nullptr;
+    size_t recordChunkSize = 0;
+    unsigned int recordLastPosition = 0;
+
+    void releaseRecordSound();
+};
+
+#endif // GLOBED_VOICE_SUPPORT
@@ -0,0 +1,16 @@
+#pragma once
+#include <defs/platform.hpp>
+
+#ifdef GLOBED_VOICE_SUPPORT
+
+#include <stddef.h>
+
+constexpr size_t VOICE_TARGET_SAMPLERATE = 24000;
+constexpr float VOICE_CHUNK_RECORD_TIME = 0.06f; // the audio buffer that is recorded at once (60ms)
+constexpr size_t VOICE_TARGET_FRAMESIZE = VOICE_TARGET_SAMPLERATE * VOICE_CHUNK_RECORD_TIME; // opus framesize
+constexpr float VOICE_STREAMING_RECORD_TIME = 0.02f; // the opus frame length used in low latency voice mode (20ms)
+constexpr size_t VOICE_STREAMING_FRAMESIZE = VOICE_TARGET_SAMPLERATE * VOICE_STREAMING_RECORD_TIME;
+constexpr size_t VOICE_CHANNELS = 1;
+constexpr int MAX_AUDIO_CHANNELS = 512;
+
+#endif // GLOBED_VOICE_SUPPORT
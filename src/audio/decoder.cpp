@@ -70,6 +70,9 @@ Result<DecodedOpusData> AudioDecoder::decode(const byte* data, size_t length) {
         GLOBED_UNWRAP(this->errcheck("opus_decode_float"));
     }
 
+    // `frameSize` is only the upper bound, streamed voice uses shorter frames
+    out.length = _res * channels;
+
     return Ok(out);
 }
 
@@ -77,6 +80,48 @@ Result<DecodedOpusData> AudioDecoder::decode(const EncodedOpusData& data) {
     return this->decode(data.ptr, data.length);
 }
 
+Result<DecodedOpusData> AudioDecoder::decodeLost(int samples) {
+    DecodedOpusData out;
+
+    out.length = samples * channels;
+    out.ptr = new float[out.length];
+
+    _res = opus_decode_float(decoder, nullptr, 0, out.ptr, samples, 0);
+
+    if (_res < 0) {
+        delete[] out.ptr;
+        GLOBED_UNWRAP(this->errcheck("opus_decode_float"));
+    }
+
+    out.length = _res * channels;
+
+    return Ok(out);
+}
+
+Result<size_t> AudioDecoder::decode(const byte* data, size_t length, std::span<float> out) {
+    _res = opus_decode_float(decoder, data, length, out.data(), out.size() / channels, 0);
+    if (_res < 0) {
+        GLOBED_UNWRAP(this->errcheck("opus_decode_float"));
+    }
+
+    return Ok(static_cast<size_t>(_res * channels));
+}
+
+Result<size_t> AudioDecoder::decodeLost(int samples, std::span<float> out) {
+    GLOBED_REQUIRE_SAFE(out.size() >= static_cast<size_t>(samples * channels), "output buffer is too small for packet loss concealment")
+
+    _res = opus_decode_float(decoder, nullptr, 0, out.data(), samples, 0);
+    if (_res < 0) {
+        GLOBED_UNWRAP(this->errcheck("opus_decode_float"));
+    }
+
+    return Ok(static_cast<size_t>(_res * channels));
+}
+
+size_t AudioDecoder::getMaxFrameSamples() const {
+    return frameSize * channels;
+}
+
 Result<> AudioDecoder::setSampleRate(int sampleRate) {
     this->sampleRate = sampleRate;
     return this->remakeDecoder();
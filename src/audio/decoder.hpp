@@ -37,6 +37,20 @@ public:
     // After you no longer need the decoded data, you must call `data.freeData()`, or (preferrably, for explicitness) `AudioDecoder::freeData(data)`
     [[nodiscard]] Result<DecodedOpusData> decode(const EncodedOpusData& data);
 
+    // Runs the Opus packet loss concealment, producing `samples` samples (per channel) in place of a lost frame.
+    // Same rules about freeing the data apply as with `decode`.
+    [[nodiscard]] Result<DecodedOpusData> decodeLost(int samples);
+
+    // Same as `decode`, but writes the samples into `out` instead of allocating. Returns the amount of samples written.
+    // `out` must be able to fit a whole frame, see `getMaxFrameSamples`.
+    [[nodiscard]] Result<size_t> decode(const util::data::byte* data, size_t length, std::span<float> out);
+
+    // Same as `decodeLost`, but writes the samples into `out` instead of allocating.
+    [[nodiscard]] Result<size_t> decodeLost(int samples, std::span<float> out);
+
+    // the maximum amount of samples (of all channels) that decoding a single frame can produce
+    size_t getMaxFrameSamples() const;
+
     static void freeData(DecodedOpusData& data) {
         data.freeData();
     }
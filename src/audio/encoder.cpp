@@ -28,7 +28,7 @@ template<> ByteBuffer::DecodeResult<EncodedOpusData> ByteBuffer::customDecode()
 
     GLOBED_UNWRAP_INTO(this->readU32(), out.length);
 
-    if (out.length > VOICE_MAX_BYTES_IN_FRAME) {
+    if (static_cast<size_t>(out.length) > VOICE_MAX_BYTES_IN_FRAME) {
         log::warn("Rejecting audio frame, size too large ({})", out.length);
         return Err(DecodeError::DataTooLong);
     }
@@ -99,6 +99,15 @@ Result<EncodedOpusData> AudioEncoder::encode(const float* data) {
     return Ok(out);
 }
 
+Result<size_t> AudioEncoder::encode(const float* data, std::span<byte> out) {
+    _res = opus_encode_float(encoder, data, frameSize, out.data(), out.size());
+    if (_res < 0) {
+        GLOBED_UNWRAP(this->errcheck("opus_encode_float"));
+    }
+
+    return Ok(static_cast<size_t>(_res));
+}
+
 Result<> AudioEncoder::setSampleRate(int sampleRate) {
     this->sampleRate = sampleRate;
     return this->remakeEncoder();
@@ -133,6 +142,11 @@ Result<> AudioEncoder::setVariableBitrate(bool variablebr) {
     return this->errcheck("AudioEncoder::setVariableBitrate");
 }
 
+Result<> AudioEncoder::setDtx(bool dtx) {
+    _res = opus_encoder_ctl(encoder, OPUS_SET_DTX(dtx ? 1 : 0));
+    return this->errcheck("AudioEncoder::setDtx");
+}
+
 Result<> AudioEncoder::remakeEncoder() {
     // if we are reinitializing, free the previous encoder
     if (encoder) {
@@ -6,6 +6,8 @@
 #include <defs/minimal_geode.hpp>
 #include <data/bytebuffer.hpp>
 
+#include <span>
+
 constexpr size_t VOICE_MAX_BYTES_IN_FRAME = 1000;
 
 struct OpusEncoder;
@@ -34,6 +36,9 @@ public:
     // After you no longer need the encoded data, you must call `data.freeData()`, or (preferrably, for explicitness) `AudioEncoder::freeData(data)`
     [[nodiscard]] Result<EncodedOpusData> encode(const float* data);
 
+    // Same as `encode`, but writes the encoded data into `out` instead of allocating. Returns the amount of bytes written.
+    [[nodiscard]] Result<size_t> encode(const float* data, std::span<util::data::byte> out);
+
     // Free the underlying buffer of the encoded frame
     static void freeData(EncodedOpusData& data) {
         data.freeData();
@@ -46,6 +51,15 @@ public:
     // sets the amount of channels that will be used and recreates the encoder
     Result<> setChannels(int channels);
 
+    // sets the bitrate for the encoder, in bits per second
+    Result<> setBitrate(int bitrate);
+
+    // sets whether to use VBR or CBR (if false)
+    Result<> setVariableBitrate(bool variablebr = true);
+
+    // sets whether to use discontinuous transmission (tiny packets during silence)
+    Result<> setDtx(bool dtx = true);
+
 private:
     // EXPERIMENTAL ZONE
     //
@@ -56,15 +70,9 @@ private:
     // resets the internal state of the encoder
     Result<> resetState();
 
-    // sets the bitrate for the encoder
-    Result<> setBitrate(int bitrate);
-
     // sets the encoder complexity (1-10)
     Result<> setComplexity(int complexity);
 
-    // sets whether to use VBR or CBR (if false)
-    Result<> setVariableBitrate(bool variablebr = true);
-
 protected:
     OpusEncoder* encoder = nullptr;
 
@@ -16,24 +16,56 @@ Result<> EncodedAudioFrame::pushOpusFrame(const EncodedOpusData& frame) {
         return Err("tried to push an extra frame into EncodedAudioFrame, {} is the max", _capacity);
     }
 
-    frames.push_back(frame);
+    byte* dest = this->growSlab(frame.length);
+    std::copy(frame.ptr, frame.ptr + frame.length, dest);
+
+    frames.push_back(EncodedOpusData { .ptr = dest, .length = frame.length });
+    slabUsed += frame.length;
+
     return Ok();
 }
 
+Result<std::span<byte>> EncodedAudioFrame::reserveOpusFrame() {
+    if (frames.size() >= _capacity) {
+        return Err("tried to push an extra frame into EncodedAudioFrame, {} is the max", _capacity);
+    }
+
+    byte* dest = this->growSlab(VOICE_MAX_BYTES_IN_FRAME);
+    return Ok(std::span<byte>(dest, VOICE_MAX_BYTES_IN_FRAME));
+}
+
+void EncodedAudioFrame::commitOpusFrame(size_t length) {
+    frames.push_back(EncodedOpusData { .ptr = slab.data() + slabUsed, .length = static_cast<int64_t>(length) });
+    slabUsed += length;
+}
+
+byte* EncodedAudioFrame::growSlab(size_t bytes) {
+    if (slab.size() < slabUsed + bytes) {
+        // reserve for the full capacity at once, so this rarely happens more than once
+        size_t wanted = std::max(slabUsed + bytes, _capacity * VOICE_MAX_BYTES_IN_FRAME);
+        auto* oldData = slab.data();
+        slab.resize(wanted);
+
+        // the frames must point into the new buffer
+        for (auto& frame : frames) {
+            frame.ptr = slab.data() + (frame.ptr - oldData);
+        }
+    }
+
+    return slab.data() + slabUsed;
+}
+
 void EncodedAudioFrame::setCapacity(size_t frames_) {
     _capacity = frames_;
-    while (frames.size() > _capacity) {
-        AudioEncoder::freeData(frames.back());
-        frames.pop_back();
+    if (frames.size() > _capacity) {
+        frames.resize(_capacity);
+        slabUsed = frames.empty() ? 0 : (frames.back().ptr - slab.data()) + frames.back().length;
     }
 }
 
 void EncodedAudioFrame::clear() {
-    for (auto& frame : frames) {
-        AudioEncoder::freeData(frame);
-    }
-
     frames.clear();
+    slabUsed = 0;
 }
 
 size_t EncodedAudioFrame::size() const {
@@ -68,18 +100,41 @@ template<> void ByteBuffer::customEncode(const EncodedAudioFrame& frame) {
 
 template<> ByteBuffer::DecodeResult<EncodedAudioFrame> ByteBuffer::customDecode() {
     EncodedAudioFrame eframe;
+    eframe.frames.reserve(EncodedAudioFrame::VOICE_MAX_FRAMES_IN_AUDIO_FRAME);
+
+    // all the opus frames are in the remaining data, so the slab never needs to be bigger than that
+    size_t remaining = this->size() - std::min(this->size(), this->getPosition());
+    size_t slabSize = std::min(remaining, EncodedAudioFrame::VOICE_MAX_FRAMES_IN_AUDIO_FRAME * VOICE_MAX_BYTES_IN_FRAME);
+    eframe.slab.reserve(slabSize);
 
+    // same layout as `std::optional<EncodedOpusData>`, but read straight into the slab
     for (size_t i = 0; i < EncodedAudioFrame::VOICE_MAX_FRAMES_IN_AUDIO_FRAME; i++) {
-        auto result = this->readValue<std::optional<EncodedOpusData>>();
-        if (result.isErr()) {
-            eframe.clear();
-            return Err(result.unwrapErr());
+        GLOBED_UNWRAP_INTO(this->readBool(), bool present);
+        if (!present) continue;
+
+        GLOBED_UNWRAP_INTO(this->readU32(), uint32_t length);
+
+        if (length > VOICE_MAX_BYTES_IN_FRAME) {
+            log::warn("Rejecting audio frame, size too large ({})", length);
+            return Err(DecodeError::DataTooLong);
         }
 
-        GLOBED_UNWRAP_INTO(result, auto frame);
-        if (frame) eframe.frames.push_back(frame.value());
+        size_t offset = eframe.slab.size();
+        eframe.slab.resize(offset + length);
+        GLOBED_UNWRAP(this->readBytesInto(eframe.slab.data() + offset, length));
+
+        eframe.frames.push_back(EncodedOpusData { .ptr = nullptr, .length = length });
     }
 
+    // now that the slab won't move anymore, point the frames into it
+    size_t offset = 0;
+    for (auto& frame : eframe.frames) {
+        frame.ptr = eframe.slab.data() + offset;
+        offset += frame.length;
+    }
+
+    eframe.slabUsed = offset;
+
     return Ok(std::move(eframe));
 }
 
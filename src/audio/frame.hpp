@@ -5,7 +5,9 @@
 
 #include "encoder.hpp"
 
-// Represents an audio frame that contains multiple encoded opus frames
+// Represents an audio frame that contains multiple encoded opus frames.
+// The opus frames are stored back to back in a single buffer (slab) owned by this frame,
+// so that recording and receiving voice doesn't need an allocation for every opus frame.
 class EncodedAudioFrame {
 public:
     friend class ByteBuffer;
@@ -23,7 +25,7 @@ public:
     EncodedAudioFrame(size_t capacity);
     ~EncodedAudioFrame();
 
-    // prevent copying since we manually free the opus frames in the dtor
+    // prevent copying since the opus frames point into the slab
     EncodedAudioFrame(const EncodedAudioFrame&) = delete;
     EncodedAudioFrame operator=(const EncodedAudioFrame& other) = delete;
 
@@ -31,9 +33,14 @@ public:
     EncodedAudioFrame(EncodedAudioFrame&& other) noexcept = default;
     EncodedAudioFrame& operator=(EncodedAudioFrame&&) noexcept = default;
 
-    // adds this audio frame to the list
+    // copies this opus frame into the slab and adds it to the list. the caller keeps the ownership of `frame`
     Result<> pushOpusFrame(const EncodedOpusData& frame);
 
+    // returns space for the next opus frame in the slab, so it can be encoded in place.
+    // must be followed by `commitOpusFrame` with the amount of bytes written, or the space is simply reused next time.
+    Result<std::span<util::data::byte>> reserveOpusFrame();
+    void commitOpusFrame(size_t length);
+
     // set the capacity of the audio frame, in individual opus frames
     void setCapacity(size_t frames);
 
@@ -47,6 +54,12 @@ public:
 protected:
     mutable std::vector<EncodedOpusData> frames;
     size_t _capacity;
+
+    std::vector<util::data::byte> slab;
+    size_t slabUsed = 0;
+
+    // makes sure `bytes` more bytes fit into the slab, and returns a pointer to them
+    util::data::byte* growSlab(size_t bytes);
 };
 
 
@@ -11,6 +11,7 @@
 #include <opus.h>
 #include <Geode/utils/permission.hpp>
 
+#include "backend/fmod_backend.hpp"
 #include <managers/error_queues.hpp>
 #include <managers/settings.hpp>
 #include <util/debug.hpp>
@@ -26,15 +27,10 @@ using permission::Permission;
         GLOBED_REQUIRE(_res == FMOD_OK, GlobedAudioManager::formatFmodError(_res, msg)); \
     } while (0); \
 
-#define FMOD_ERR_CHECK_SAFE(res, msg) \
-    do { \
-        auto _res = (res); \
-        GLOBED_REQUIRE_SAFE(_res == FMOD_OK, GlobedAudioManager::formatFmodError(_res, msg)); \
-    } while (0); \
-
 
 GlobedAudioManager::GlobedAudioManager()
-    : encoder(VOICE_TARGET_SAMPLERATE, VOICE_TARGET_FRAMESIZE, VOICE_CHANNELS) {
+    : encoder(VOICE_TARGET_SAMPLERATE, VOICE_TARGET_FRAMESIZE, VOICE_CHANNELS),
+      backend(std::make_unique<FmodAudioBackend>()) {
 
     audioThreadHandle.setLoopFunction(&GlobedAudioManager::audioThreadFunc);
 
@@ -62,6 +58,7 @@ GlobedAudioManager::GlobedAudioManager()
 }
 
 GlobedAudioManager::~GlobedAudioManager() {
+    this->wakeAudioThread();
     audioThreadHandle.stopAndWait();
 
     log::info("audio thread halted.");
@@ -220,6 +217,18 @@ void GlobedAudioManager::setRecordBufferCapacity(size_t frames) {
     recordFrame.setCapacity(frames);
 }
 
+void GlobedAudioManager::setRecordFrameSize(size_t samples) {
+    GLOBED_REQUIRE(samples > 0 && samples <= VOICE_TARGET_FRAMESIZE, "invalid record frame size")
+
+    queuedRecordFrameSize = samples;
+}
+
+void GlobedAudioManager::setRecordBitrate(int bitrate) {
+    GLOBED_REQUIRE(bitrate >= 0, "invalid record bitrate")
+
+    queuedRecordBitrate = bitrate;
+}
+
 Result<> GlobedAudioManager::startRecordingInternal(bool passive) {
     if (!permission::getPermissionStatus(Permission::RecordAudio)) {
         return Err("Recording failed, please grant microphone permission in Globed settings");
@@ -228,41 +237,24 @@ Result<> GlobedAudioManager::startRecordingInternal(bool passive) {
     GLOBED_REQUIRE_SAFE(this->recordDevice.id >= 0, "no recording device is set")
     GLOBED_REQUIRE_SAFE(!this->isRecording() && !recordActive, "attempting to record when already recording")
 
-    if (recordSound != nullptr) {
-        recordSound->release();
-        recordSound = nullptr;
-    }
-
-    FMOD_CREATESOUNDEXINFO exinfo = {};
-
-    exinfo.cbsize = sizeof(FMOD_CREATESOUNDEXINFO);
-    exinfo.numchannels = 1;
-    exinfo.format = FMOD_SOUND_FORMAT_PCMFLOAT;
-    exinfo.defaultfrequency = VOICE_TARGET_SAMPLERATE;
-    exinfo.length = sizeof(float) * exinfo.defaultfrequency * exinfo.numchannels;
-
-    recordChunkSize = exinfo.length;
+    // with dtx, opus produces tiny packets during silence which are then not sent at all
+    int bitrate = queuedRecordBitrate;
+    GLOBED_UNWRAP(encoder.setBitrate(bitrate > 0 ? bitrate : OPUS_AUTO));
+    GLOBED_UNWRAP(encoder.setVariableBitrate(true));
+    GLOBED_UNWRAP(encoder.setDtx(true));
 
-    FMOD_ERR_CHECK_SAFE(
-        this->getSystem()->createSound(nullptr, FMOD_2D | FMOD_OPENUSER | FMOD_LOOP_NORMAL, &exinfo, &recordSound),
-        "System::createSound"
-    )
-
-    FMOD_RESULT res = this->getSystem()->recordStart(recordDevice.id, recordSound, true);
-
-    // invalid device most likely
-    if (res == FMOD_ERR_RECORD) {
-        return Err("Invalid audio device selected, unable to record");
-    }
+    GLOBED_UNWRAP(backend->startCapture(recordDevice.id));
 
-    FMOD_ERR_CHECK_SAFE(res, "System::recordStart")
+    recordFrameSize = queuedRecordFrameSize;
+    encoder.setFrameSize(recordFrameSize);
 
     recordQueuedStop = false;
     recordQueuedHalt = false;
-    recordLastPosition = 0;
     recordActive = true;
     recordingPassive = passive;
 
+    this->wakeAudioThread();
+
     return Ok();
 }
 
@@ -287,10 +279,7 @@ Result<> GlobedAudioManager::startRecordingRaw(std::function<void(const float*,
 }
 
 void GlobedAudioManager::internalStopRecording() {
-    FMOD_ERR_CHECK(
-        this->getSystem()->recordStop(recordDevice.id),
-        "System::recordStop"
-    )
+    backend->stopCapture();
 
     // if halting instead of stopping, don't call the callback
     if (recordQueuedHalt) {
@@ -304,29 +293,25 @@ void GlobedAudioManager::internalStopRecording() {
     // cleanup
     recordCallback = [](const auto&){};
     recordRawCallback = [](const auto*, auto) {};
-    recordLastPosition = 0;
-    recordChunkSize = 0;
+    recordFilter = {};
     recordingRaw = false;
     recordingPassive = false;
     recordingPassiveActive = false;
     recordQueue.clear();
 
-    if (recordSound) {
-        recordSound->release();
-        recordSound = nullptr;
-    }
-
     recordActive = false;
     recordQueuedStop = false;
 }
 
 void GlobedAudioManager::stopRecording() {
     recordQueuedStop = true;
+    this->wakeAudioThread();
 }
 
 void GlobedAudioManager::haltRecording() {
     recordQueuedStop = true;
     recordQueuedHalt = true;
+    this->wakeAudioThread();
 }
 
 bool GlobedAudioManager::isRecording() {
@@ -338,21 +323,18 @@ bool GlobedAudioManager::isRecording() {
         return recordingPassiveActive;
     }
 
-    bool recording;
-
-    if (FMOD_OK != this->getSystem()->isRecording(this->recordDevice.id, &recording)) {
-        this->recordDevice.id = -1;
-        return false;
-    }
-
-    return recording;
+    return backend->isCapturing();
 }
 
-Result<> GlobedAudioManager::startPassiveRecording(std::function<void(const EncodedAudioFrame&)> callback) {
+Result<> GlobedAudioManager::startPassiveRecording(
+    std::function<void(const EncodedAudioFrame&)> callback,
+    std::function<bool(const float*, size_t)> filter
+) {
     auto result = this->startRecordingInternal(true);
     if (result.isErr()) return result;
 
     recordCallback = callback;
+    recordFilter = filter;
     recordingRaw = false;
 
     return Ok();
@@ -364,6 +346,23 @@ void GlobedAudioManager::resumePassiveRecording() {
 
 void GlobedAudioManager::pausePassiveRecording() {
     recordingPassiveActive = false;
+    // wake up to send out the remaining audio
+    this->wakeAudioThread();
+}
+
+AudioBackend& GlobedAudioManager::getBackend() {
+    return *backend;
+}
+
+void GlobedAudioManager::setBackend(std::unique_ptr<AudioBackend> backend) {
+    GLOBED_REQUIRE(!recordActive, "attempting to replace the audio backend while recording")
+
+    this->backend = std::move(backend);
+}
+
+void GlobedAudioManager::queueAudioThreadTask(std::function<void()> task) {
+    audioThreadTasks.lock()->push_back(std::move(task));
+    this->wakeAudioThread();
 }
 
 FMOD::Channel* GlobedAudioManager::playSound(FMOD::Sound* sound) {
@@ -473,10 +472,13 @@ void GlobedAudioManager::recordInvokeRawCallback(float* pcm, size_t samples) {
 }
 
 void GlobedAudioManager::audioThreadFunc(decltype(audioThreadHandle)::StopToken&) {
-    // if we are not recording right now, sleep
+    this->audioThreadRunTasks();
+
+    // if we are not recording right now, sleep until someone starts recording or queues a task.
+    // the timeout is only there so the thread can notice when it's being stopped.
     if (!recordActive) {
         audioThreadSleeping = true;
-        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        this->audioThreadWait(std::chrono::milliseconds(250));
         return;
     }
 
@@ -496,76 +498,104 @@ void GlobedAudioManager::audioThreadFunc(decltype(audioThreadHandle)::StopToken&
         ErrorQueues::get().warn(result.unwrapErr());
         audioThreadSleeping = true;
         this->internalStopRecording();
+        return;
     }
+
+    this->audioThreadWait(this->recordWaitTime());
 }
 
-Result<> GlobedAudioManager::audioThreadWork() {
-    float* pcmData;
-    unsigned int pcmLen;
+void GlobedAudioManager::audioThreadRunTasks() {
+    std::vector<std::function<void()>> tasks;
+    std::swap(tasks, *audioThreadTasks.lock());
 
-    unsigned int pos;
-    FMOD_ERR_CHECK_SAFE(
-        this->getSystem()->getRecordPosition(recordDevice.id, &pos),
-        "System::getRecordPosition"
-    )
+    for (auto& task : tasks) {
+        try {
+            task();
+        } catch (const std::exception& e) {
+            ErrorQueues::get().error(std::string("Exception in audio thread task: ") + e.what());
+        }
+    }
+}
 
-    // if we are at the same position, do nothing
-    if (pos == recordLastPosition) {
-        this->getSystem()->update();
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
-        return Ok();
+void GlobedAudioManager::wakeAudioThread() {
+    {
+        std::lock_guard lock(audioThreadWakeMutex);
+        audioThreadWakeup = true;
     }
 
-    FMOD_ERR_CHECK_SAFE(
-        recordSound->lock(0, recordChunkSize, (void**)&pcmData, nullptr, &pcmLen, nullptr),
-        "Sound::lock"
-    )
+    audioThreadWakeCv.notify_one();
+}
 
-    // don't write any data if we are in passive recording and not currently recording
-    if (!recordingPassive || recordingPassiveActive) {
-        if (pos > recordLastPosition) {
-            recordQueue.writeData(pcmData + recordLastPosition, pos - recordLastPosition);
-        } else if (pos < recordLastPosition) { // we have reached the end of the buffer
-            // write the data left at the end
-            recordQueue.writeData(pcmData + recordLastPosition, pcmLen / sizeof(float) - recordLastPosition);
-            // write the data from beginning to current pos
-            recordQueue.writeData(pcmData, pos);
-        }
-    }
+void GlobedAudioManager::audioThreadWait(std::chrono::microseconds timeout) {
+    std::unique_lock lock(audioThreadWakeMutex);
+    audioThreadWakeCv.wait_for(lock, timeout, [this] { return audioThreadWakeup; });
+    audioThreadWakeup = false;
+}
 
-    recordLastPosition = pos;
+std::chrono::microseconds GlobedAudioManager::recordWaitTime() {
+    // raw callbacks don't need full frames, but are still delivered in frame sized steps
+    size_t frameSize = recordingRaw ? VOICE_STREAMING_FRAMESIZE : recordFrameSize;
+    size_t queued = recordingRaw ? 0 : recordQueue.size();
+    size_t missing = queued >= frameSize ? 0 : frameSize - queued;
 
-    FMOD_ERR_CHECK_SAFE(
-        recordSound->unlock(pcmData, nullptr, pcmLen, 0),
-        "Sound::unlock"
-    )
+    // FMOD advances the record position in blocks, so give it a little extra time to reach the end of the frame
+    auto wait = std::chrono::microseconds(missing * 1'000'000 / VOICE_TARGET_SAMPLERATE) + std::chrono::milliseconds(1);
+
+    return wait;
+}
+
+Result<> GlobedAudioManager::audioThreadWork() {
+    // don't keep any data if we are in passive recording and not currently recording
+    bool keep = !recordingPassive || recordingPassiveActive;
+
+    GLOBED_UNWRAP_INTO(backend->readCapture(keep ? &recordQueue : nullptr), size_t captured);
+
+    // if nothing new was captured, do nothing
+    if (captured == 0) {
+        backend->update();
+        return Ok();
+    }
 
     if (recordingRaw) {
         // raw recording, call the raw callback with the pcm data directly.
-        float* pcm = recordQueue.data();
-        size_t samples = recordQueue.size();
-        this->recordInvokeRawCallback(pcm, samples);
-        recordQueue.clear();
+        float pcmbuf[VOICE_TARGET_FRAMESIZE];
+        while (size_t samples = recordQueue.copyTo(pcmbuf, VOICE_TARGET_FRAMESIZE)) {
+            this->recordInvokeRawCallback(pcmbuf, samples);
+        }
     } else {
-        // encoded recording, encode the data and push to the frame.
-        if (recordQueue.size() >= VOICE_TARGET_FRAMESIZE) {
+        // encoded recording, encode every full frame of data and push it to the frame.
+        while (recordQueue.size() >= recordFrameSize) {
             float pcmbuf[VOICE_TARGET_FRAMESIZE];
-            recordQueue.copyTo(pcmbuf, VOICE_TARGET_FRAMESIZE);
+            recordQueue.copyTo(pcmbuf, recordFrameSize);
+
+            bool silent = recordFilter && !recordFilter(pcmbuf, recordFrameSize);
+
+            if (!silent) {
+                // encode straight into the frame
+                GLOBED_UNWRAP_INTO(recordFrame.reserveOpusFrame(), auto space);
+                GLOBED_UNWRAP_INTO(encoder.encode(pcmbuf, space), size_t written);
 
-            GLOBED_UNWRAP_INTO(encoder.encode(pcmbuf), auto opusFrame);
-            GLOBED_UNWRAP(recordFrame.pushOpusFrame(opusFrame));
+                // opus returns 2 bytes or less when dtx decides the frame doesn't need to be transmitted
+                if (written > 2) {
+                    recordFrame.commitOpusFrame(written);
+                } else {
+                    silent = true;
+                }
+            }
+
+            // send what we have right away when speech stops, or if we are at capacity
+            if (silent || recordFrame.size() >= recordFrame.capacity()) {
+                this->recordInvokeCallback();
+            }
         }
 
-        // if we are at capacity, or we just stopped passive recording, call the callback
-        if (recordFrame.size() >= recordFrame.capacity() || (recordFrame.size() > 0 && recordingPassive && !recordingPassiveActive)) {
+        // if we just stopped passive recording, call the callback
+        if (recordFrame.size() > 0 && recordingPassive && !recordingPassiveActive) {
             this->recordInvokeCallback();
         }
     }
 
-    this->getSystem()->update();
-
-    std::this_thread::sleep_for(std::chrono::milliseconds(2));
-    // std::this_thread::yield();
+    backend->update();
 
     return Ok();
 }
@@ -10,8 +10,14 @@
 #include <asp/sync.hpp>
 #include <asp/thread.hpp>
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include "constants.hpp"
 #include "frame.hpp"
 #include "sample_queue.hpp"
+#include "backend/backend.hpp"
 
 struct AudioRecordingDevice {
     int id = -1;
@@ -32,12 +38,6 @@ struct AudioPlaybackDevice {
     int speakerModeChannels;
 };
 
-constexpr size_t VOICE_TARGET_SAMPLERATE = 24000;
-constexpr float VOICE_CHUNK_RECORD_TIME = 0.06f; // the audio buffer that is recorded at once (60ms)
-constexpr size_t VOICE_TARGET_FRAMESIZE = VOICE_TARGET_SAMPLERATE * VOICE_CHUNK_RECORD_TIME; // opus framesize
-constexpr size_t VOICE_CHANNELS = 1;
-constexpr int MAX_AUDIO_CHANNELS = 512;
-
 // This class might thread safe ?
 class GlobedAudioManager : public SingletonBase<GlobedAudioManager> {
 protected:
@@ -73,6 +73,12 @@ public:
 
     // set the amount of record frames in a buffer (used by the lowerAudioLatency setting)
     void setRecordBufferCapacity(size_t frames);
+    // set the amount of samples in a single encoded opus frame, at most `VOICE_TARGET_FRAMESIZE`.
+    // takes effect the next time recording is started.
+    void setRecordFrameSize(size_t samples);
+    // set the target bitrate of the encoder in bits per second, 0 lets opus pick it.
+    // takes effect the next time recording is started.
+    void setRecordBitrate(int bitrate);
 
     // start recording the voice and call the callback once a full frame is ready.
     // if `stopRecording()` is called at any point, the callback will be called with the remaining data.
@@ -93,13 +99,30 @@ public:
 
     // start recording, similar to `startRecording` but the callback is not automatically called,
     // unless `resumePassiveRecording` has been called.
-    Result<> startPassiveRecording(std::function<void(const EncodedAudioFrame&)> callback);
+    // if `filter` is set, it is called with every frame before it gets encoded, and frames it returns false for are dropped.
+    // WARNING: the filter is also called from the audio thread.
+    Result<> startPassiveRecording(
+        std::function<void(const EncodedAudioFrame&)> callback,
+        std::function<bool(const float*, size_t)> filter = {}
+    );
 
     void resumePassiveRecording();
     void pausePassiveRecording();
 
+    /* Backend */
+
+    // the backend that voice capture and playback go through, FMOD unless replaced
+    AudioBackend& getBackend();
+    // replace the backend, e.g. with a `FileAudioBackend` to run without audio hardware.
+    // must not be called while recording or while any streams are alive.
+    void setBackend(std::unique_ptr<AudioBackend> backend);
+
     /* Misc */
 
+    // run `task` on the audio thread, before any more recorded audio is processed.
+    // tasks run in the order they were queued.
+    void queueAudioThreadTask(std::function<void()> task);
+
     // play a sound and return the channel associated with it
     [[nodiscard]] FMOD::Channel* playSound(FMOD::Sound* sound);
 
@@ -134,12 +157,13 @@ private:
     asp::AtomicBool recordingRaw = false;
     asp::AtomicBool recordingPassive = false;
     asp::AtomicBool recordingPassiveActive = false;
-    FMOD::Sound* recordSound = nullptr;
-    size_t recordChunkSize = 0;
+    size_t recordFrameSize = VOICE_TARGET_FRAMESIZE;
+    asp::AtomicSizeT queuedRecordFrameSize = VOICE_TARGET_FRAMESIZE;
+    asp::AtomicI32 queuedRecordBitrate = 0;
     std::function<void(const EncodedAudioFrame&)> recordCallback;
+    std::function<bool(const float*, size_t)> recordFilter;
     std::function<void(const float*, size_t)> recordRawCallback;
     AudioSampleQueue recordQueue;
-    unsigned int recordLastPosition = 0;
     EncodedAudioFrame recordFrame;
 
     Result<> startRecordingInternal(bool passive = false);
@@ -152,12 +176,24 @@ private:
 
     /* misc */
     FMOD::System* cachedSystem = nullptr;
+    std::unique_ptr<AudioBackend> backend;
 
     asp::AtomicBool audioThreadSleeping = true;
     asp::Thread<GlobedAudioManager*> audioThreadHandle;
+    asp::Mutex<std::vector<std::function<void()>>> audioThreadTasks;
+
+    // the audio thread sleeps on this until a full frame of audio should be ready, or something wakes it up early
+    std::mutex audioThreadWakeMutex;
+    std::condition_variable audioThreadWakeCv;
+    bool audioThreadWakeup = false;
 
     void audioThreadFunc(decltype(audioThreadHandle)::StopToken&);
     Result<> audioThreadWork();
+    void audioThreadRunTasks();
+    void wakeAudioThread();
+    void audioThreadWait(std::chrono::microseconds timeout);
+    // how long until the next recorded frame is complete
+    std::chrono::microseconds recordWaitTime();
 };
 
 #else
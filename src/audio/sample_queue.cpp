@@ -2,39 +2,65 @@
 
 #ifdef GLOBED_VOICE_SUPPORT
 
-void AudioSampleQueue::writeData(const DecodedOpusData& data) {
-    this->writeData(data.ptr, data.length);
+#include <algorithm>
+#include <bit>
+
+AudioSampleQueue::AudioSampleQueue(size_t capacity) {
+    capacity = std::bit_ceil(std::max<size_t>(capacity, 1));
+
+    buf = std::make_unique<float[]>(capacity);
+    mask = capacity - 1;
 }
 
-void AudioSampleQueue::writeData(const float* pcm, size_t length) {
-    buf.insert(buf.end(), pcm, pcm + length);
+size_t AudioSampleQueue::writeData(const DecodedOpusData& data) {
+    return this->writeData(data.ptr, data.length);
+}
+
+size_t AudioSampleQueue::writeData(const float* pcm, size_t length) {
+    size_t h = head.load(std::memory_order::relaxed);
+    size_t t = tail.load(std::memory_order::acquire);
+
+    size_t count = std::min(length, this->capacity() - (h - t));
+
+    // the free space may wrap around the end of the buffer
+    size_t start = h & mask;
+    size_t first = std::min(count, this->capacity() - start);
+    std::copy(pcm, pcm + first, buf.get() + start);
+    std::copy(pcm + first, pcm + count, buf.get());
+
+    head.store(h + count, std::memory_order::release);
+
+    return count;
 }
 
 size_t AudioSampleQueue::copyTo(float* dest, size_t samples) {
-    if (buf.size() < samples) {
-        size_t total = buf.size();
+    size_t t = tail.load(std::memory_order::relaxed);
+    size_t h = head.load(std::memory_order::acquire);
+
+    size_t count = std::min(samples, h - t);
 
-        std::copy(buf.data(), buf.data() + total, dest);
-        buf.clear();
-        return total;
-    }
+    size_t start = t & mask;
+    size_t first = std::min(count, this->capacity() - start);
+    std::copy(buf.get() + start, buf.get() + start + first, dest);
+    std::copy(buf.get(), buf.get() + count - first, dest + first);
 
-    std::copy(buf.data(), buf.data() + samples, dest);
-    buf.erase(buf.begin(), buf.begin() + samples);
+    tail.store(t + count, std::memory_order::release);
 
-    return samples;
+    return count;
 }
 
 size_t AudioSampleQueue::size() const {
-    return buf.size();
+    // tail first, so that the head can't be older than it
+    size_t t = tail.load(std::memory_order::acquire);
+    return head.load(std::memory_order::acquire) - t;
 }
 
-void AudioSampleQueue::clear() {
-    buf.clear();
+size_t AudioSampleQueue::capacity() const {
+    return mask + 1;
 }
 
-float* AudioSampleQueue::data() {
-    return buf.data();
+void AudioSampleQueue::clear() {
+    tail.store(head.load(std::memory_order::acquire), std::memory_order::release);
 }
 
-#endif // GLOBED_VOICE_SUPPORT
\ No newline at end of file
+#endif // GLOBED_VOICE_SUPPORT
@@ -5,26 +5,44 @@
 
 #include "decoder.hpp"
 
+#include <atomic>
+#include <memory>
+
+// Fixed size ring of samples, allocated once when constructed.
+// It is a single producer, single consumer queue: one thread may write while another one reads, without any locking.
+// `clear` counts as reading. More than one writer or reader at a time needs outside synchronization.
 class AudioSampleQueue {
 public:
-    AudioSampleQueue() {};
-    // enable copying
-    AudioSampleQueue(const AudioSampleQueue&) = default;
-    AudioSampleQueue& operator=(const AudioSampleQueue&) = default;
-    // enable moving
-    AudioSampleQueue(AudioSampleQueue&&) = default;
-    AudioSampleQueue& operator=(AudioSampleQueue&&) = default;
-
-    void writeData(const DecodedOpusData& data);
-    void writeData(const float* pcm, size_t length);
-    // contrary to the name, this will erase the samples from this queue after copying them to `dest`
+    // a little over a second, enough for two full regular audio frames (2 x 600ms) waiting to be played
+    static constexpr size_t DEFAULT_CAPACITY = 32768;
+
+    // the capacity is rounded up to a power of two
+    AudioSampleQueue(size_t capacity = DEFAULT_CAPACITY);
+
+    // prevent copying and moving, the other thread could be using the queue
+    AudioSampleQueue(const AudioSampleQueue&) = delete;
+    AudioSampleQueue& operator=(const AudioSampleQueue&) = delete;
+    AudioSampleQueue(AudioSampleQueue&&) = delete;
+    AudioSampleQueue& operator=(AudioSampleQueue&&) = delete;
+
+    // writes as many samples as there is space for, returns the amount written. whatever doesn't fit is dropped.
+    size_t writeData(const DecodedOpusData& data);
+    size_t writeData(const float* pcm, size_t length);
+    // copies up to `samples` samples into `dest` and removes them from the queue, returns the amount copied
     size_t copyTo(float* dest, size_t samples);
     size_t size() const;
+    size_t capacity() const;
+    // removes every sample that was written so far
     void clear();
-    float* data();
 
 private:
-    std::vector<float> buf;
+    std::unique_ptr<float[]> buf;
+    size_t mask;
+
+    // both only ever increase, the index into `buf` is `pos & mask`.
+    // `head` is only written by the producer, `tail` only by the consumer.
+    std::atomic<size_t> head = 0;
+    std::atomic<size_t> tail = 0;
 };
 
 #endif // GLOBED_VOICE_SUPPORT
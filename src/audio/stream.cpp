@@ -2,139 +2,108 @@
 
 #ifdef GLOBED_VOICE_SUPPORT
 
-#include "manager.hpp"
-#include <util/misc.hpp>
+#include "constants.hpp"
 
-AudioStream::AudioStream(AudioDecoder&& decoder)
+AudioStream::AudioStream(AudioDecoder&& decoder, AudioBackend* backend)
     : decoder(std::move(decoder)),
       estimator(std::move(VolumeEstimator(VOICE_TARGET_SAMPLERATE))) {
-    FMOD_CREATESOUNDEXINFO exinfo = {};
-
-    exinfo.cbsize = sizeof(FMOD_CREATESOUNDEXINFO);
-    exinfo.numchannels = 1;
-    exinfo.format = FMOD_SOUND_FORMAT_PCMFLOAT;
-    exinfo.defaultfrequency = VOICE_TARGET_SAMPLERATE;
-    exinfo.userdata = this;
-    exinfo.length = sizeof(float) * exinfo.numchannels * exinfo.defaultfrequency * (VOICE_CHUNK_RECORD_TIME * 1);
-
-    exinfo.pcmreadcallback = [](FMOD_SOUND* sound_, void* data, unsigned int len) -> FMOD_RESULT {
-        FMOD::Sound* sound = reinterpret_cast<FMOD::Sound*>(sound_);
-        AudioStream* stream = nullptr;
-        sound->getUserData((void**)&stream);
-
-        if (!stream || !data) {
-            log::warn("audio stream is nullptr in cb, ignoring");
-            return FMOD_OK;
-        }
-
-        // write data..
-
-        size_t neededSamples = len / sizeof(float);
-        size_t copied = stream->queue.lock()->copyTo(reinterpret_cast<float*>(data), neededSamples);
-        stream->estimator.lock()->feedData(reinterpret_cast<const float*>(data), copied);
+    decodeScratch.resize(this->decoder.getMaxFrameSamples());
 
-        if (copied != neededSamples) {
-            stream->starving = true;
-            // fill the rest with the void to not repeat stuff
-            for (size_t i = copied; i < neededSamples; i++) {
-                ((float*)data)[i] = 0.0f;
-            }
-        } else {
-            stream->starving = false;
-            stream->lastPlaybackTime = util::time::now();
-        }
+    if (!backend) return;
 
-        return FMOD_OK;
-    };
+    auto result = backend->createOutput([this](float* out, size_t samples) {
+        this->readSamples(out, samples);
+    });
 
-    auto& vm = GlobedAudioManager::get();
+    GLOBED_REQUIRE(result.isOk(), result.unwrapErr())
 
-    FMOD_RESULT res;
-    auto system = vm.getSystem();
-    res = system->createStream(nullptr, FMOD_OPENUSER | FMOD_2D | FMOD_LOOP_NORMAL, &exinfo, &sound);
-
-    GLOBED_REQUIRE(res == FMOD_OK, GlobedAudioManager::formatFmodError(res, "System::createStream"))
+    output = std::move(result).unwrap();
 }
 
 AudioStream::~AudioStream() {
-    // honestly idk if this even does anything but i'm hoping it fixes a weird crash
-    if (sound) {
-        sound->setUserData(nullptr);
-    }
+    // must be gone before anything it reads from is destroyed
+    output.reset();
+}
 
-    if (channel) {
-        channel->stop();
+void AudioStream::start() {
+    if (!output || output->isPlaying()) {
+        return;
     }
 
-    if (sound) {
-        sound->release();
+    auto result = output->play();
+    if (result.isErr()) {
+        log::warn("failed to play audio stream: {}", result.unwrapErr());
     }
 }
 
-AudioStream::AudioStream(AudioStream&& other) noexcept {
-    sound = other.sound;
-    channel = other.channel;
-    other.sound = nullptr;
-    other.channel = nullptr;
+Result<> AudioStream::writeData(const EncodedAudioFrame& frame) {
+    const auto& frames = frame.getFrames();
+    for (const auto& opusFrame : frames) {
+        GLOBED_UNWRAP(this->decodeIntoQueue(opusFrame.ptr, opusFrame.length));
+    }
 
-    *queue.lock() = std::move(*other.queue.lock());
-    decoder = std::move(other.decoder);
-    *estimator.lock() = std::move(*other.estimator.lock());
+    return Ok();
 }
 
-AudioStream& AudioStream::operator=(AudioStream&& other) noexcept {
-    if (this != &other) {
-        if (this->sound) {
-            this->sound->release();
-        }
-
-        if (this->channel) {
-            this->channel->stop();
-        }
+Result<> AudioStream::decodeIntoQueue(const util::data::byte* data, size_t length) {
+    auto result = data ? decoder.decode(data, length, decodeScratch) : decoder.decodeLost(VOICE_STREAMING_FRAMESIZE, decodeScratch);
+    GLOBED_UNWRAP_INTO(result, size_t samples);
 
-        this->sound = other.sound;
-        this->channel = other.channel;
+    queue.writeData(decodeScratch.data(), samples);
 
-        other.sound = nullptr;
-        other.channel = nullptr;
+    return Ok();
+}
 
-        *queue.lock() = std::move(*other.queue.lock());
-        decoder = std::move(other.decoder);
-        *estimator.lock() = std::move(*other.estimator.lock());
-    }
+Result<> AudioStream::writeSequencedData(uint32_t sequence, const EncodedOpusData& frame) {
+    if (nextSequence) {
+        int32_t diff = static_cast<int32_t>(sequence - nextSequence.value());
 
-    return *this;
-}
+        if (diff < 0 && diff > -SEQUENCE_RESET_THRESHOLD) {
+            // late or duplicate frame, the audio is already played (or concealed)
+            return Ok();
+        }
 
-void AudioStream::start() {
-    if (this->channel) {
-        return;
+        if (diff > 0 && diff <= static_cast<int32_t>(MAX_CONCEALED_FRAMES)) {
+            for (int32_t i = 0; i < diff; i++) {
+                GLOBED_UNWRAP(this->decodeIntoQueue(nullptr, 0));
+            }
+        }
     }
 
-    this->channel = GlobedAudioManager::get().playSound(sound);
+    nextSequence = sequence + 1;
+
+    return this->decodeIntoQueue(frame.ptr, frame.length);
 }
 
-Result<> AudioStream::writeData(const EncodedAudioFrame& frame) {
-    const auto& frames = frame.getFrames();
-    for (const auto& opusFrame : frames) {
-        auto decodedFrame_ = decoder.decode(opusFrame);
-        GLOBED_UNWRAP_INTO(decodedFrame_, auto decodedFrame);
+void AudioStream::writeData(const float* pcm, size_t samples) {
+    queue.writeData(pcm, samples);
+}
 
-        queue.lock()->writeData(decodedFrame);
+size_t AudioStream::readSamples(float* out, size_t samples) {
+    size_t copied = queue.copyTo(out, samples);
+    estimator.lock()->feedData(out, copied);
 
-        AudioDecoder::freeData(decodedFrame);
+    if (copied != samples) {
+        starving = true;
+        // fill the rest with the void to not repeat stuff
+        for (size_t i = copied; i < samples; i++) {
+            out[i] = 0.0f;
+        }
+    } else {
+        starving = false;
+        lastPlaybackTime = util::time::now();
     }
 
-    return Ok();
+    return copied;
 }
 
-void AudioStream::writeData(const float* pcm, size_t samples) {
-    queue.lock()->writeData(pcm, samples);
+bool AudioStream::isStandalone() {
+    return output != nullptr;
 }
 
 void AudioStream::setVolume(float volume) {
-    if (channel) {
-        channel->setVolume(volume);
+    if (output) {
+        output->setVolume(volume);
     }
 
     this->volume = volume;
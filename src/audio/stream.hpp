@@ -7,30 +7,40 @@
 #include "sample_queue.hpp"
 #include "decoder.hpp"
 #include "volume_estimator.hpp"
+#include "backend/backend.hpp"
 
 #include <asp/sync.hpp>
 #include <util/time.hpp>
 
 class AudioStream {
 public:
-    AudioStream(AudioDecoder&& decoder);
+    // plays through an output of the given backend, usually `GlobedAudioManager::getBackend()`.
+    // if `backend` is null, no output is created and samples must be pulled with `readSamples` (see `VoiceMixer`)
+    AudioStream(AudioDecoder&& decoder, AudioBackend* backend);
     ~AudioStream();
 
-    // prevent copying since we manually free the sound
+    // prevent copying and moving since the output calls back into this stream
     AudioStream(const AudioStream&) = delete;
     AudioStream operator=(const AudioStream& other) = delete;
+    AudioStream(AudioStream&&) = delete;
+    AudioStream& operator=(AudioStream&&) = delete;
 
-    // allow moving
-    AudioStream(AudioStream&& other) noexcept;
-    AudioStream& operator=(AudioStream&& other) noexcept;
-
-    // start playing this stream
+    // start playing this stream. does nothing if the stream is not standalone
     void start();
     // write an audio frame to this stream. returns error if opus decoding failed
     Result<> writeData(const EncodedAudioFrame& frame);
+    // write a single sequenced opus frame (low latency voice) to this stream.
+    // late and duplicate frames are dropped, small gaps are filled in with packet loss concealment.
+    Result<> writeSequencedData(uint32_t sequence, const EncodedOpusData& frame);
     // write raw audio data to this stream
     void writeData(const float* pcm, size_t samples);
 
+    // pull up to `samples` samples into `out`, filling the rest with silence. returns the amount of real samples.
+    // this is what the output calls, for non-standalone streams the mixer calls it instead.
+    size_t readSamples(float* out, size_t samples);
+
+    bool isStandalone();
+
     // set the volume of the stream (0.0f - 1.0f, beyond 1.0f amplifies)
     void setVolume(float volume);
 
@@ -45,13 +55,25 @@ public:
     asp::AtomicBool starving = false; // true if there aren't enough samples in the queue
 
 private:
-    FMOD::Sound* sound = nullptr;
-    FMOD::Channel* channel = nullptr;
-    asp::Mutex<AudioSampleQueue> queue;
+    std::unique_ptr<AudioOutput> output;
+    // written by the `VoiceDecodePool` worker of the player (or the recording thread for raw audio), read by the output or the mixer
+    AudioSampleQueue queue;
     AudioDecoder decoder;
+    // decoded samples go here before being copied into the queue, so the reader never waits for opus
+    std::vector<float> decodeScratch;
     asp::Mutex<VolumeEstimator> estimator;
-    float volume = 0.f;
+    asp::AtomicF32 volume = 0.f;
     util::time::time_point lastPlaybackTime;
+    // only used by `writeSequencedData`, which is always called from the same thread
+    std::optional<uint32_t> nextSequence;
+
+    // decodes an opus frame into the queue, or runs packet loss concealment if `data` is null
+    Result<> decodeIntoQueue(const util::data::byte* data, size_t length);
+
+    // bigger gaps are not concealed, playback just continues from the new frame
+    static constexpr uint32_t MAX_CONCEALED_FRAMES = 3;
+    // a frame this far behind means that the sender has restarted the sequence
+    static constexpr int32_t SEQUENCE_RESET_THRESHOLD = 50;
 };
 
 #else
@@ -0,0 +1,57 @@
+#include "voice_activity.hpp"
+
+#ifdef GLOBED_VOICE_SUPPORT
+
+#include <algorithm>
+#include <cmath>
+
+#include "manager.hpp"
+#include <util/misc.hpp>
+
+VoiceActivityDetector::VoiceActivityDetector(size_t sampleRate) : sampleRate(sampleRate) {}
+
+VoiceActivityDetector::VoiceActivityDetector() : VoiceActivityDetector(VOICE_TARGET_SAMPLERATE) {}
+
+bool VoiceActivityDetector::process(const float* pcm, size_t samples) {
+    if (samples == 0) return false;
+
+    float frameTime = static_cast<float>(samples) / static_cast<float>(sampleRate);
+    float rms = util::misc::calculatePcmRms(pcm, samples);
+    float zcr = static_cast<float>(util::misc::countPcmZeroCrossings(pcm, samples)) / static_cast<float>(samples);
+
+    bool loud = rms > std::max(MIN_SPEECH_RMS, noiseFloor * SPEECH_RATIO);
+    bool speech = loud && (zcr < MAX_SPEECH_ZCR || rms > noiseFloor * LOUD_RATIO);
+
+    // the noise floor follows quieter frames quickly and louder frames slowly,
+    // so that short bursts of speech barely move it but a constant hum is eventually ignored
+    if (rms < noiseFloor) {
+        noiseFloor += (rms - noiseFloor) * 0.5f;
+    } else {
+        noiseFloor += (rms - noiseFloor) * std::min(1.f, frameTime / NOISE_RISE_TIME);
+    }
+
+    noiseFloor = std::clamp(noiseFloor, MIN_NOISE_FLOOR, MAX_NOISE_FLOOR);
+
+    if (speech) {
+        hangover = HANGOVER_TIME;
+        return true;
+    }
+
+    if (hangover > 0.f) {
+        hangover -= frameTime;
+        return true;
+    }
+
+    return false;
+}
+
+void VoiceActivityDetector::reset() {
+    noiseFloor = MIN_NOISE_FLOOR * 4.f;
+    hangover = 0.f;
+}
+
+float VoiceActivityDetector::getNoiseFloor() {
+    return noiseFloor;
+}
+
+#endif // GLOBED_VOICE_SUPPORT
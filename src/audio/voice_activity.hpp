@@ -0,0 +1,44 @@
+#pragma once
+#include <defs/platform.hpp>
+
+#ifdef GLOBED_VOICE_SUPPORT
+
+#include <stddef.h>
+
+// Decides whether a recorded frame contains speech, so that silence doesn't have to be encoded and sent.
+// A frame is considered speech if it is loud enough compared to the (adaptive) background noise level,
+// and its zero crossing rate is not as high as with broadband noise like fans or hissing.
+class VoiceActivityDetector {
+public:
+    VoiceActivityDetector(size_t sampleRate);
+    VoiceActivityDetector();
+
+    // returns whether the frame should be transmitted
+    bool process(const float* pcm, size_t samples);
+
+    void reset();
+
+    float getNoiseFloor();
+
+private:
+    // how long to keep transmitting after the last speech frame, so that quiet word endings aren't cut off
+    static constexpr float HANGOVER_TIME = 0.3f;
+    // frames quieter than this are never speech, no matter how quiet the background is
+    static constexpr float MIN_SPEECH_RMS = 0.004f;
+    static constexpr float MIN_NOISE_FLOOR = 0.0005f;
+    static constexpr float MAX_NOISE_FLOOR = 0.05f;
+    // how much louder than the noise floor a frame must be
+    static constexpr float SPEECH_RATIO = 2.5f;
+    // frames this much louder than the noise floor are speech even with a high zero crossing rate
+    static constexpr float LOUD_RATIO = 6.f;
+    // fraction of adjacent samples with a sign change, above which a frame is considered noise
+    static constexpr float MAX_SPEECH_ZCR = 0.4f;
+    // time constant for the noise floor rising towards louder backgrounds
+    static constexpr float NOISE_RISE_TIME = 5.f;
+
+    size_t sampleRate;
+    float noiseFloor = MIN_NOISE_FLOOR * 4.f;
+    float hangover = 0.f;
+};
+
+#endif // GLOBED_VOICE_SUPPORT
@@ -0,0 +1,58 @@
+#include "voice_decode_pool.hpp"
+
+#ifdef GLOBED_VOICE_SUPPORT
+
+#include <managers/error_queues.hpp>
+
+VoiceDecodePool::VoiceDecodePool() {
+    for (size_t i = 0; i < WORKER_COUNT; i++) {
+        auto& worker = workers[i];
+        worker.thread.setStartFunction([] { geode::utils::thread::setName("Voice Decode Thread"); });
+        worker.thread.setLoopFunction(&Worker::threadFunc);
+        worker.thread.start(&worker);
+    }
+}
+
+VoiceDecodePool::~VoiceDecodePool() {
+    for (auto& worker : workers) {
+        // wake the worker up with an empty task, it won't block on the queue again afterwards
+        worker.stopping = true;
+        worker.queue.push(Task {});
+        worker.thread.stopAndWait();
+    }
+}
+
+void VoiceDecodePool::submit(int playerId, std::shared_ptr<AudioStream> stream, std::shared_ptr<const EncodedAudioFrame> frame) {
+    this->workerFor(playerId).queue.push(Task {
+        .stream = std::move(stream),
+        .frame = std::move(frame),
+    });
+}
+
+void VoiceDecodePool::submitSequenced(int playerId, std::shared_ptr<AudioStream> stream, uint32_t sequence, std::shared_ptr<const EncodedOpusData> frame) {
+    this->workerFor(playerId).queue.push(Task {
+        .stream = std::move(stream),
+        .opusFrame = std::move(frame),
+        .sequence = sequence,
+    });
+}
+
+VoiceDecodePool::Worker& VoiceDecodePool::workerFor(int playerId) {
+    return workers[static_cast<uint32_t>(playerId) % WORKER_COUNT];
+}
+
+void VoiceDecodePool::Worker::threadFunc(decltype(thread)::StopToken&) {
+    if (stopping) return;
+
+    auto task = queue.pop();
+    if (!task.stream) return;
+
+    auto result = task.frame
+        ? task.stream->writeData(*task.frame)
+        : task.stream->writeSequencedData(task.sequence, *task.opusFrame);
+    if (result.isErr()) {
+        ErrorQueues::get().debugWarn(std::string("Failed to play a voice frame: ") + result.unwrapErr());
+    }
+}
+
+#endif // GLOBED_VOICE_SUPPORT
@@ -0,0 +1,58 @@
+#pragma once
+#include <defs/geode.hpp>
+
+#ifdef GLOBED_VOICE_SUPPORT
+
+#include "stream.hpp"
+
+#include <asp/sync.hpp>
+#include <asp/thread.hpp>
+
+#include <atomic>
+
+/*
+* VoiceDecodePool decodes incoming voice frames on a few background threads,
+* so that the cocos thread only has to route the frames to the correct stream.
+* Every player is pinned to a single worker, so their frames are always decoded in order,
+* and the decoder state of a stream is never touched by two threads at once.
+*/
+class VoiceDecodePool {
+public:
+    static constexpr size_t WORKER_COUNT = 2;
+
+    VoiceDecodePool();
+    ~VoiceDecodePool();
+
+    VoiceDecodePool(const VoiceDecodePool&) = delete;
+    VoiceDecodePool& operator=(const VoiceDecodePool&) = delete;
+
+    // queue the frame to be decoded and written into `stream`.
+    // the stream is kept alive until the frame has been decoded, even if it gets removed in the meantime.
+    void submit(int playerId, std::shared_ptr<AudioStream> stream, std::shared_ptr<const EncodedAudioFrame> frame);
+    // same as `submit`, but for a single sequenced opus frame (low latency voice)
+    void submitSequenced(int playerId, std::shared_ptr<AudioStream> stream, uint32_t sequence, std::shared_ptr<const EncodedOpusData> frame);
+
+private:
+    // a task without a stream only wakes up the worker
+    struct Task {
+        std::shared_ptr<AudioStream> stream;
+        // either a full frame, or a single sequenced opus frame
+        std::shared_ptr<const EncodedAudioFrame> frame;
+        std::shared_ptr<const EncodedOpusData> opusFrame;
+        uint32_t sequence = 0;
+    };
+
+    struct Worker {
+        asp::Channel<Task> queue;
+        asp::Thread<Worker*> thread;
+        std::atomic_bool stopping = false;
+
+        void threadFunc(decltype(thread)::StopToken&);
+    };
+
+    std::array<Worker, WORKER_COUNT> workers;
+
+    Worker& workerFor(int playerId);
+};
+
+#endif // GLOBED_VOICE_SUPPORT
@@ -0,0 +1,83 @@
+#include "voice_mixer.hpp"
+
+#ifdef GLOBED_VOICE_SUPPORT
+
+#include "manager.hpp"
+#include <util/misc.hpp>
+
+VoiceMixer::VoiceMixer() {}
+
+VoiceMixer::~VoiceMixer() {
+    this->stop();
+}
+
+void VoiceMixer::start() {
+    if (output) return;
+
+    auto result = GlobedAudioManager::get().getBackend().createOutput([this](float* out, size_t samples) {
+        this->mixInto(out, samples);
+    });
+
+    GLOBED_REQUIRE(result.isOk(), result.unwrapErr())
+
+    output = std::move(result).unwrap();
+
+    auto playResult = output->play();
+    GLOBED_REQUIRE(playResult.isOk(), playResult.unwrapErr())
+}
+
+void VoiceMixer::stop() {
+    output.reset();
+}
+
+bool VoiceMixer::isPlaying() {
+    return output && output->isPlaying();
+}
+
+void VoiceMixer::addSource(AudioStream* stream) {
+    auto srcs = sources.lock();
+    if (std::find(srcs->begin(), srcs->end(), stream) == srcs->end()) {
+        srcs->push_back(stream);
+    }
+}
+
+void VoiceMixer::removeSource(AudioStream* stream) {
+    auto srcs = sources.lock();
+    auto it = std::find(srcs->begin(), srcs->end(), stream);
+    if (it != srcs->end()) {
+        // order does not matter, swap with the last one
+        *it = srcs->back();
+        srcs->pop_back();
+    }
+}
+
+size_t VoiceMixer::sourceCount() {
+    return sources.lock()->size();
+}
+
+void VoiceMixer::mixInto(float* out, size_t samples) {
+    std::fill_n(out, samples, 0.f);
+
+    auto srcs = sources.lock();
+
+    if (scratch.size() < samples) {
+        scratch.resize(samples);
+    }
+
+    for (AudioStream* stream : *srcs) {
+        // always read, even when muted, so that the queue gets drained and the loudness stays up to date
+        size_t copied = stream->readSamples(scratch.data(), samples);
+        float gain = stream->getVolume();
+
+        if (copied == 0 || gain == 0.f) continue;
+
+        util::misc::mixPcm(out, scratch.data(), copied, gain);
+    }
+
+    // several loud speakers can sum past full scale, soft clip instead of letting the output wrap or hard clip.
+    // the curve doesn't touch anything below its knee, so it's applied to every block rather than only the ones that clip,
+    // otherwise the gain would jump between blocks
+    util::misc::softClipPcm(out, samples);
+}
+
+#endif // GLOBED_VOICE_SUPPORT
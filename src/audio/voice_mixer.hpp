@@ -0,0 +1,43 @@
+#pragma once
+#include <defs/geode.hpp>
+
+#ifdef GLOBED_VOICE_SUPPORT
+
+#include "stream.hpp"
+
+#include <asp/sync.hpp>
+
+/*
+* VoiceMixer plays any amount of non-standalone `AudioStream`s through a single output of the audio backend,
+* summing them in software with their volume applied as a gain.
+* Adding and removing sources is thread safe, the streams must outlive their membership in the mixer.
+*/
+class VoiceMixer {
+public:
+    VoiceMixer();
+    ~VoiceMixer();
+
+    VoiceMixer(const VoiceMixer&) = delete;
+    VoiceMixer& operator=(const VoiceMixer&) = delete;
+
+    // create the output and start playing it
+    void start();
+    // stop playing and release the output
+    void stop();
+    bool isPlaying();
+
+    void addSource(AudioStream* stream);
+    void removeSource(AudioStream* stream);
+    size_t sourceCount();
+
+    // mix `samples` samples from every source into `out`, overwriting its previous contents.
+    void mixInto(float* out, size_t samples);
+
+private:
+    std::unique_ptr<AudioOutput> output;
+    asp::Mutex<std::vector<AudioStream*>> sources;
+    // only touched inside of `mixInto`, while `sources` is locked
+    std::vector<float> scratch;
+};
+
+#endif // GLOBED_VOICE_SUPPORT
@@ -1,17 +1,25 @@
 #include "voice_playback_manager.hpp"
 
 #include "manager.hpp"
+#include <managers/settings.hpp>
 
 #ifdef GLOBED_VOICE_SUPPORT
 
-Result<> VoicePlaybackManager::playFrameStreamed(int playerId, const EncodedAudioFrame& frame) {
+void VoicePlaybackManager::playFrameStreamed(int playerId, std::shared_ptr<const EncodedAudioFrame> frame) {
     // if the stream doesn't exist yet, create it
     if (!streams.contains(playerId)) {
         this->prepareStream(playerId);
     }
 
-    auto& stream = streams.at(playerId);
-    return stream->writeData(frame);
+    decodePool.submit(playerId, streams.at(playerId), std::move(frame));
+}
+
+void VoicePlaybackManager::playSequencedFrame(int playerId, uint32_t sequence, std::shared_ptr<const EncodedOpusData> frame) {
+    if (!streams.contains(playerId)) {
+        this->prepareStream(playerId);
+    }
+
+    decodePool.submitSequenced(playerId, streams.at(playerId), sequence, std::move(frame));
 }
 
 void VoicePlaybackManager::playRawDataStreamed(int playerId, const float* pcm, size_t samples) {
@@ -24,7 +32,14 @@ void VoicePlaybackManager::playRawDataStreamed(int playerId, const float* pcm, s
 }
 
 void VoicePlaybackManager::stopAllStreams() {
+    for (const auto& [_, stream] : streams) {
+        if (!stream->isStandalone()) {
+            mixer.removeSource(stream.get());
+        }
+    }
+
     streams.clear();
+    mixer.stop();
 }
 
 void VoicePlaybackManager::prepareStream(int playerId) {
@@ -32,13 +47,37 @@ void VoicePlaybackManager::prepareStream(int playerId) {
 
     AudioDecoder decoder(VOICE_TARGET_SAMPLERATE, VOICE_TARGET_FRAMESIZE, VOICE_CHANNELS);
 
-    auto stream = std::make_unique<AudioStream>(std::move(decoder));
-    stream->start();
+    bool mixed = GlobedSettings::get().communication.softwareMixer;
+
+    auto stream = std::make_shared<AudioStream>(std::move(decoder), mixed ? nullptr : &GlobedAudioManager::get().getBackend());
+
+    if (mixed) {
+        mixer.addSource(stream.get());
+
+        if (!mixer.isPlaying()) {
+            mixer.start();
+        }
+    } else {
+        stream->start();
+    }
+
     streams.emplace(playerId, std::move(stream));
 }
 
 void VoicePlaybackManager::removeStream(int playerId) {
-    streams.erase(playerId);
+    auto it = streams.find(playerId);
+    if (it == streams.end()) return;
+
+    if (!it->second->isStandalone()) {
+        // must be removed before the stream gets destroyed, as the mixer might be reading from it
+        mixer.removeSource(it->second.get());
+
+        if (mixer.sourceCount() == 0) {
+            mixer.stop();
+        }
+    }
+
+    streams.erase(it);
 }
 
 bool VoicePlaybackManager::isSpeaking(int playerId) {
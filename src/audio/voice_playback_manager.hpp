@@ -3,18 +3,23 @@
 #include <defs/minimal_geode.hpp>
 
 #include "stream.hpp"
+#include "voice_mixer.hpp"
+#include "voice_decode_pool.hpp"
 #include <util/time.hpp>
 #include <util/singleton.hpp>
 
 /*
 * VoicePlaybackManager is responsible for playing voices of multiple people
 * at the same time efficiently and without memory leaks (?).
-* Not thread safe.
+* Not thread safe, though the decoding of voice frames happens asynchronously in `VoiceDecodePool`.
 */
 class VoicePlaybackManager : public SingletonBase<VoicePlaybackManager> {
 public:
 #ifdef GLOBED_VOICE_SUPPORT
-    Result<> playFrameStreamed(int playerId, const EncodedAudioFrame& frame);
+    // queues the frame to be decoded on a background thread, errors are reported through `ErrorQueues`
+    void playFrameStreamed(int playerId, std::shared_ptr<const EncodedAudioFrame> frame);
+    // same as `playFrameStreamed`, but for a single opus frame sent in low latency mode
+    void playSequencedFrame(int playerId, uint32_t sequence, std::shared_ptr<const EncodedOpusData> frame);
 #endif
     void playRawDataStreamed(int playerId, const float* pcm, size_t samples);
     void stopAllStreams();
@@ -37,6 +42,10 @@ public:
 
 private:
 #ifdef GLOBED_VOICE_SUPPORT
-    std::unordered_map<int, std::unique_ptr<AudioStream>> streams;
+    // shared, as the decode workers may still be writing to a stream after it's removed
+    std::unordered_map<int, std::shared_ptr<AudioStream>> streams;
+    // used instead of a separate FMOD stream per player when the software mixer is enabled
+    VoiceMixer mixer;
+    VoiceDecodePool decodePool;
 #endif
 };
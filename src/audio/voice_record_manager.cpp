@@ -5,82 +5,87 @@
 #include <data/packets/client/misc.hpp>
 #include <data/packets/client/game.hpp>
 #include <managers/error_queues.hpp>
+#include <managers/settings.hpp>
 #include <audio/manager.hpp>
 #include <net/manager.hpp>
-#include <util/time.hpp>
 
-VoiceRecordingManager::VoiceRecordingManager() {
-    thread.setStartFunction([] { geode::utils::thread::setName("Record Thread"); });
-    thread.setLoopFunction(&VoiceRecordingManager::threadFunc);
-    thread.start(this);
-}
+VoiceRecordingManager::VoiceRecordingManager() {}
 
 void VoiceRecordingManager::startRecording() {
-    queuedStart = true;
+    GlobedAudioManager::get().queueAudioThreadTask([this] {
+        this->startRecordingInternal();
+    });
 }
 
 void VoiceRecordingManager::stopRecording() {
-    queuedStop = true;
+    GlobedAudioManager::get().queueAudioThreadTask([] {
+        auto& vm = GlobedAudioManager::get();
+        if (vm.isRecording()) {
+            vm.stopRecording();
+        }
+    });
 }
 
-void VoiceRecordingManager::threadFunc(decltype(thread)::StopToken&) {
+void VoiceRecordingManager::startRecordingInternal() {
     auto& vm = GlobedAudioManager::get();
 
-    if (queuedStop) {
-        if (vm.isRecording()) {
-            vm.stopRecording();
-        }
+    if (vm.isRecording()) return;
+
+    vm.validateDevices();
 
-        this->resetBools(false);
+    // make sure the recording device is valid
+    if (!vm.isRecordingDeviceSet()) {
+        ErrorQueues::get().debugWarn("Unable to record audio, no recording device is set");
         return;
     }
 
-    if (queuedStart) {
-        if (!vm.isRecording()) {
-            vm.validateDevices();
+    auto& settings = GlobedSettings::get();
+    bool streamed = settings.communication.lowLatencyVoice;
 
-            // make sure the recording device is valid
-            if (!vm.isRecordingDeviceSet()) {
-                ErrorQueues::get().debugWarn("Unable to record audio, no recording device is set");
-                this->resetBools(false);
-                return;
-            }
+    vm.setRecordBitrate(settings.communication.voiceBitrate);
+
+    std::function<bool(const float*, size_t)> filter;
+    if (settings.communication.voiceActivityDetection) {
+        vad.reset();
+        filter = [this](const float* pcm, size_t samples) {
+            return vad.process(pcm, samples);
+        };
+    }
 
-            auto result = vm.startPassiveRecording([](const auto& frame) {
-                auto& nm = NetworkManager::get();
-                if (!nm.established()) return;
+    auto result = vm.startPassiveRecording([this, streamed](const auto& frame) {
+        auto& nm = NetworkManager::get();
+        if (!nm.established()) return;
 
-                // `frame` does not live long enough and will be destructed at the end of this callback.
-                // so we can't pass it directly in a `VoicePacket` and we use a `RawPacket` instead.
+        // `frame` does not live long enough and will be destructed at the end of this callback.
+        // so we can't pass it directly in a `VoicePacket` and we use a `RawPacket` instead.
 
+        if (streamed) {
+            // in low latency mode every opus frame is sent separately, with a sequence number
+            for (const auto& opusFrame : frame.getFrames()) {
                 ByteBuffer buf;
-                buf.writeValue(frame);
-
-                nm.send(RawPacket::create<VoicePacket>(std::move(buf)));
-            });
+                buf.writeU32(streamSequence++);
+                buf.writeValue(opusFrame);
 
-            if (result.isErr()) {
-                ErrorQueues::get().warn(result.unwrapErr());
-                log::warn("unable to record audio: {}", result.unwrapErr());
-                this->resetBools(false);
-                return;
+                nm.send(RawPacket::create<VoiceStreamPacket>(std::move(buf)));
             }
+
+            return;
         }
-    }
 
-    this->resetBools(vm.isRecording());
+        ByteBuffer buf;
+        buf.writeValue(frame);
 
-    std::this_thread::sleep_for(util::time::millis(10));
-}
+        nm.send(RawPacket::create<VoicePacket>(std::move(buf)));
+    }, std::move(filter));
 
-void VoiceRecordingManager::resetBools(bool recording) {
-    this->recording = recording;
-    queuedStart = false;
-    queuedStop = false;
+    if (result.isErr()) {
+        ErrorQueues::get().warn(result.unwrapErr());
+        log::warn("unable to record audio: {}", result.unwrapErr());
+    }
 }
 
 bool VoiceRecordingManager::isRecording() {
-    return recording;
+    return GlobedAudioManager::get().isRecording();
 }
 
 #else
@@ -88,7 +93,6 @@ bool VoiceRecordingManager::isRecording() {
 VoiceRecordingManager::VoiceRecordingManager() {}
 void VoiceRecordingManager::startRecording() {}
 void VoiceRecordingManager::stopRecording() {}
-void VoiceRecordingManager::resetBools(bool recording) {}
 bool VoiceRecordingManager::isRecording() {
     return false;
 }
@@ -1,10 +1,8 @@
 #pragma once
 #include <defs/platform.hpp>
 
-#include <asp/thread/Thread.hpp>
-#include <asp/sync/Atomic.hpp>
-
 #include <util/singleton.hpp>
+#include <audio/voice_activity.hpp>
 
 class VoiceRecordingManager : public SingletonBase<VoiceRecordingManager> {
 protected:
@@ -12,17 +10,18 @@ protected:
     friend class SingletonBase;
 
 public:
-#ifdef GLOBED_VOICE_SUPPORT
-    asp::Thread<VoiceRecordingManager*> thread;
-    asp::AtomicBool queuedStop = false, queuedStart = false, recording = false;
-
-    void threadFunc(decltype(thread)::StopToken&);
-#endif // GLOBED_VOICE_SUPPORT
-
+    // starting and stopping is done on the audio thread, these functions only queue it
     void startRecording();
     void stopRecording();
     bool isRecording();
 
 private:
-    void resetBools(bool recording);
+#ifdef GLOBED_VOICE_SUPPORT
+    // sequence number of the next streamed voice frame, only touched from the audio thread
+    uint32_t streamSequence = 0;
+    // only touched from the audio thread
+    VoiceActivityDetector vad;
+
+    void startRecordingInternal();
+#endif // GLOBED_VOICE_SUPPORT
 };
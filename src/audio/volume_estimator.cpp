@@ -1,24 +1,45 @@
 #include "volume_estimator.hpp"
 
-#include "manager.hpp"
-#include <util/misc.hpp>
+#include <util/pcm.hpp>
+
+#include <algorithm>
+#include <cmath>
 
 #ifdef GLOBED_VOICE_SUPPORT
 
 VolumeEstimator::VolumeEstimator(size_t sampleRate) {
     this->sampleRate = sampleRate;
+    this->blockSize = std::max<size_t>(1, static_cast<size_t>(static_cast<float>(sampleRate) * BLOCK_TIME));
 }
 
-VolumeEstimator::VolumeEstimator() {
-    this->sampleRate = 0;
-}
+VolumeEstimator::VolumeEstimator() : VolumeEstimator(0) {}
 
 void VolumeEstimator::feedData(const float* pcm, size_t samples) {
-    sampleQueue.writeData(pcm, samples);
+    while (samples > 0) {
+        size_t count = std::min(samples, blockSize - blockFill);
+
+        blockSum += util::misc::calculatePcmVolume(pcm, count) * static_cast<float>(count);
+        blockFill += count;
+        pcm += count;
+        samples -= count;
+
+        if (blockFill == blockSize) {
+            this->pushBlock(blockSum);
+            blockSum = 0.f;
+            blockFill = 0;
+        }
+    }
+}
 
-    if (sampleQueue.size() > static_cast<float>(sampleRate) * BUFFER_SIZE) {
-        sampleQueue.clear();
+void VolumeEstimator::pushBlock(float sum) {
+    // same as the old sample queue, if nobody consumes the data for too long, drop all of it
+    if (blockCount == MAX_BLOCKS) {
+        blockHead = 0;
+        blockCount = 0;
     }
+
+    blocks[(blockHead + blockCount) % MAX_BLOCKS] = sum;
+    blockCount++;
 }
 
 void VolumeEstimator::update(float dt) {
@@ -28,29 +49,31 @@ void VolumeEstimator::update(float dt) {
 
     dt = std::clamp(dt, 0.0f, 0.25f);
 
-    const size_t needed = static_cast<size_t>(static_cast<float>(sampleRate) * BUFFER_SIZE * dt);
+    pendingSamples += static_cast<float>(sampleRate) * dt;
+
+    const size_t needed = static_cast<size_t>(pendingSamples) / blockSize;
+    if (needed == 0) {
+        return;
+    }
 
-#ifdef __clang__
-    float buf[needed];
-#else
-    // yuck msvc
-    float* buf = reinterpret_cast<float*>(alloca(sizeof(float) * needed));
-#endif
-    size_t copied = sampleQueue.copyTo(buf, needed);
+    pendingSamples -= static_cast<float>(needed * blockSize);
 
-    if (copied < needed) {
-        // fill the rest with void
-        for (size_t i = copied; i < needed; i++) {
-            buf[i] = 0.f;
-        }
+    // if there aren't enough blocks, the missing ones count as silence
+    size_t available = std::min(needed, blockCount);
+
+    float sum = 0.f;
+    for (size_t i = 0; i < available; i++) {
+        sum += blocks[blockHead];
+        blockHead = (blockHead + 1) % MAX_BLOCKS;
     }
 
-    volume = util::misc::calculatePcmVolume(buf, needed);
+    blockCount -= available;
+
+    volume = sum / static_cast<float>(needed * blockSize);
 }
 
 float VolumeEstimator::getVolume() {
     return volume;
 }
 
-
-#endif // GLOBED_VOICE_SUPPORT
\ No newline at end of file
+#endif // GLOBED_VOICE_SUPPORT
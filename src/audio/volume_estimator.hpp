@@ -3,9 +3,11 @@
 
 #ifdef GLOBED_VOICE_SUPPORT
 
-#include "sample_queue.hpp"
-#include <util/collections.hpp>
+#include <array>
+#include <stddef.h>
 
+// Estimates the loudness (mean absolute amplitude) of played audio. Samples are never stored,
+// only the sum of absolute values of every 10ms block is kept until `update` consumes it.
 class VolumeEstimator {
 public:
     VolumeEstimator(size_t sampleRate);
@@ -25,10 +27,26 @@ public:
 
 private:
     static constexpr float BUFFER_SIZE = 1.0f;
+    static constexpr float BLOCK_TIME = 0.01f;
+    static constexpr size_t MAX_BLOCKS = static_cast<size_t>(BUFFER_SIZE / BLOCK_TIME);
 
-    float volume;
+    float volume = 0.f;
     size_t sampleRate;
-    AudioSampleQueue sampleQueue;
+    size_t blockSize;
+
+    // the block that is currently being filled
+    float blockSum = 0.f;
+    size_t blockFill = 0;
+
+    // ring of finished blocks, waiting to be consumed by `update`
+    std::array<float, MAX_BLOCKS> blocks;
+    size_t blockHead = 0;
+    size_t blockCount = 0;
+
+    // how many samples `update` should have consumed but couldn't, because they don't make up a full block
+    float pendingSamples = 0.f;
+
+    void pushBlock(float sum);
 };
 
-#endif // GLOBED_VOICE_SUPPORT
\ No newline at end of file
+#endif // GLOBED_VOICE_SUPPORT
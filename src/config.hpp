@@ -19,6 +19,7 @@
 // # define GLOBED_DEBUG_INTERPOLATION // dump all interpolation stuff
 // # define GLOBED_DEBUG_PACKETS // log all incoming and outgoing packets & bandwidth
 // # define GLOBED_DEBUG_PACKETS_PRINT // also print each packet
+// # define GLOBED_RECORD_SEND_TRACES // save our own player data in every level to send-traces/ in the save dir, for the send rate benchmark
 
 #endif // GLOBED_DEBUG
 
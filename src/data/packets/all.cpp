@@ -16,6 +16,7 @@ std::shared_ptr<Packet> matchPacket(packetid_t packetId) {
         PACKET(KeepaliveTCPResponsePacket);
         PACKET(ClaimThreadFailedPacket);
         PACKET(LoginRecoveryFailecPacket);
+        PACKET(ClockSyncResponsePacket);
 
         PACKET(ServerNoticePacket);
         PACKET(ServerBannedPacket);
@@ -35,6 +36,7 @@ std::shared_ptr<Packet> matchPacket(packetid_t packetId) {
         PACKET(LevelDataPacket);
         PACKET(LevelPlayerMetadataPacket);
         PACKET(VoiceBroadcastPacket);
+        PACKET(VoiceStreamBroadcastPacket);
         PACKET(ChatMessageBroadcastPacket);
 
         // room related
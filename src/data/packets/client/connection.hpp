@@ -113,6 +113,19 @@ class KeepaliveTCPPacket : public Packet {
 
 GLOBED_SERIALIZABLE_STRUCT(KeepaliveTCPPacket, ());
 
+// 10008 - ClockSyncPacket
+class ClockSyncPacket : public Packet {
+    GLOBED_PACKET(10008, ClockSyncPacket, false, false)
+
+    ClockSyncPacket() {}
+    ClockSyncPacket(uint32_t id, uint64_t clientTime) : id(id), clientTime(clientTime) {}
+
+    uint32_t id;
+    uint64_t clientTime; // micros
+};
+
+GLOBED_SERIALIZABLE_STRUCT(ClockSyncPacket, (id, clientTime));
+
 // 10200 - ConnectionTestPacket
 class ConnectionTestPacket : public Packet {
     GLOBED_PACKET(10200, ConnectionTestPacket, false, false)
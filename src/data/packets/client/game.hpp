@@ -45,6 +45,15 @@ class PlayerDataPacket : public Packet {
 };
 GLOBED_SERIALIZABLE_STRUCT(PlayerDataPacket, (data, meta));
 
+// 12004 - RequestLevelDataPacket
+// gets the same response as PlayerDataPacket, without updating our own data on the server
+class RequestLevelDataPacket : public Packet {
+    GLOBED_PACKET(12004, RequestLevelDataPacket, false, false)
+
+    RequestLevelDataPacket() {}
+};
+GLOBED_SERIALIZABLE_STRUCT(RequestLevelDataPacket, ());
+
 #ifdef GLOBED_VOICE_SUPPORT
 
 #include <audio/frame.hpp>
@@ -60,6 +69,17 @@ class VoicePacket : public Packet {
 };
 GLOBED_SERIALIZABLE_STRUCT(VoicePacket, (frame));
 
+// 12012 - VoiceStreamPacket
+class VoiceStreamPacket : public Packet {
+    GLOBED_PACKET(12012, VoiceStreamPacket, true, false)
+
+    VoiceStreamPacket() {}
+
+    uint32_t sequence;
+    EncodedOpusData frame;
+};
+GLOBED_SERIALIZABLE_STRUCT(VoiceStreamPacket, (sequence, frame));
+
 #endif // GLOBED_VOICE_SUPPORT
 
 // 12011 - ChatMessagePacket
@@ -103,6 +103,19 @@ class LoginRecoveryFailecPacket : public Packet {
 };
 GLOBED_SERIALIZABLE_STRUCT(LoginRecoveryFailecPacket, ());
 
+// 20010 - ClockSyncResponsePacket
+class ClockSyncResponsePacket : public Packet {
+    GLOBED_PACKET(20010, ClockSyncResponsePacket, false, false)
+
+    ClockSyncResponsePacket() {}
+
+    uint32_t id;
+    uint64_t clientTime;     // echoed from the request
+    uint64_t serverRecvTime; // micros since the unix epoch
+    uint64_t serverSendTime;
+};
+GLOBED_SERIALIZABLE_STRUCT(ClockSyncResponsePacket, (id, clientTime, serverRecvTime, serverSendTime));
+
 // 20100 - ServerNoticePacket
 class ServerNoticePacket : public Packet {
     GLOBED_PACKET(20100, ServerNoticePacket, false, false)
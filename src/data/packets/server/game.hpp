@@ -57,6 +57,31 @@ class VoiceBroadcastPacket : public Packet {
     GLOBED_SERIALIZABLE_STRUCT(VoiceBroadcastPacket, ());
 #endif // GLOBED_VOICE_SUPPORT
 
+// 22012 - VoiceStreamBroadcastPacket
+class VoiceStreamBroadcastPacket : public Packet {
+    GLOBED_PACKET(22012, VoiceStreamBroadcastPacket, true, false)
+
+    VoiceStreamBroadcastPacket() {}
+
+#ifdef GLOBED_VOICE_SUPPORT
+    ~VoiceStreamBroadcastPacket() {
+        if (frame.ptr) {
+            frame.freeData();
+        }
+    }
+
+    int sender;
+    uint32_t sequence;
+    EncodedOpusData frame = {nullptr, 0};
+#endif
+};
+
+#ifdef GLOBED_VOICE_SUPPORT
+    GLOBED_SERIALIZABLE_STRUCT(VoiceStreamBroadcastPacket, (sender, sequence, frame));
+#else
+    GLOBED_SERIALIZABLE_STRUCT(VoiceStreamBroadcastPacket, ());
+#endif // GLOBED_VOICE_SUPPORT
+
 // 22011 - ChatMessageBroadcastPacket
 class ChatMessageBroadcastPacket : public Packet {
     GLOBED_PACKET(22011, ChatMessageBroadcastPacket, true, false)
@@ -4,21 +4,6 @@
 
 using namespace cocos2d;
 
-void SpecificIconData::copyFlagsFrom(const SpecificIconData& other) {
-    iconType = other.iconType;
-    isDashing = other.isDashing;
-    isLookingLeft = other.isLookingLeft;
-    isUpsideDown = other.isUpsideDown;
-    isVisible = other.isVisible;
-    isMini = other.isMini;
-    isGrounded = other.isGrounded;
-    isStationary = other.isStationary;
-    isFalling = other.isFalling;
-    didJustJump = other.didJustJump;
-    isRotating = other.isRotating;
-    isSideways = other.isSideways;
-}
-
 template<> void ByteBuffer::customEncode(const SpecificIconData& data) {
     this->writeValue(data.position);
     this->writeValue(data.rotation);
@@ -23,7 +23,21 @@ struct SpiderTeleportData {
 GLOBED_SERIALIZABLE_STRUCT(SpiderTeleportData, (from, to));
 
 struct SpecificIconData {
-    void copyFlagsFrom(const SpecificIconData& other);
+    // everything besides the position, rotation and teleport
+    void copyFlagsFrom(const SpecificIconData& other) {
+        iconType = other.iconType;
+        isDashing = other.isDashing;
+        isLookingLeft = other.isLookingLeft;
+        isUpsideDown = other.isUpsideDown;
+        isVisible = other.isVisible;
+        isMini = other.isMini;
+        isGrounded = other.isGrounded;
+        isStationary = other.isStationary;
+        isFalling = other.isFalling;
+        didJustJump = other.didJustJump;
+        isRotating = other.isRotating;
+        isSideways = other.isSideways;
+    }
 
     cocos2d::CCPoint position;
     float rotation;
@@ -63,6 +77,19 @@ struct PlayerData {
     bool isLastDeathReal; // for deathlink, to prevent death chains
 };
 
+class AssociatedPlayerData {
+public:
+    AssociatedPlayerData(int accountId, const PlayerData& data) : accountId(accountId), data(data) {}
+    AssociatedPlayerData() {}
+
+    int accountId;
+    PlayerData data;
+};
+
+GLOBED_SERIALIZABLE_STRUCT(AssociatedPlayerData, (
+    accountId, data
+));
+
 struct PlayerMetadata {
     uint32_t localBest;
     int32_t attempts;
@@ -157,19 +157,6 @@ inline const PlayerAccountData PlayerAccountData::DEFAULT_DATA = PlayerAccountDa
     PlayerIconData::DEFAULT_ICONS
 );
 
-class AssociatedPlayerData {
-public:
-    AssociatedPlayerData(int accountId, const PlayerData& data) : accountId(accountId), data(data) {}
-    AssociatedPlayerData() {}
-
-    int accountId;
-    PlayerData data;
-};
-
-GLOBED_SERIALIZABLE_STRUCT(AssociatedPlayerData, (
-    accountId, data
-));
-
 class AssociatedPlayerMetadata {
 public:
     AssociatedPlayerMetadata(int accountId, const PlayerMetadata& data) : accountId(accountId), data(data) {}
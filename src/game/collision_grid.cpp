@@ -0,0 +1,77 @@
+#include "collision_grid.hpp"
+
+#include <cmath>
+
+using namespace geode::prelude;
+
+void CollisionGrid::clear() {
+    pending.clear();
+    entries.clear();
+    oversized.clear();
+}
+
+void CollisionGrid::insert(const CCRect& rect, uint32_t id) {
+    Entry entry {
+        .minX = rect.getMinX(),
+        .minY = rect.getMinY(),
+        .maxX = rect.getMaxX(),
+        .maxY = rect.getMaxY(),
+        .id = id,
+    };
+
+    if (entry.maxX - entry.minX > CELL_SIZE || entry.maxY - entry.minY > CELL_SIZE) {
+        oversized.push_back(entry);
+        return;
+    }
+
+    entry.cx = cellOf(entry.minX);
+    entry.cy = cellOf(entry.minY);
+    pending.push_back(entry);
+}
+
+void CollisionGrid::build() {
+    // about one bucket per entry, so that most buckets only hold a single cell
+    uint32_t bucketCount = 16;
+    while (bucketCount < pending.size()) {
+        bucketCount *= 2;
+    }
+
+    bucketMask = bucketCount - 1;
+    bucketStarts.assign(bucketCount + 1, 0);
+
+    for (const auto& entry : pending) {
+        bucketStarts[this->bucketOf(entry.cx, entry.cy) + 1]++;
+    }
+
+    for (uint32_t i = 0; i < bucketCount; i++) {
+        bucketStarts[i + 1] += bucketStarts[i];
+    }
+
+    entries.resize(pending.size());
+
+    // scatter, using the bucket starts as write cursors, after which each one points to the start of the next bucket
+    for (const auto& entry : pending) {
+        uint32_t bucket = this->bucketOf(entry.cx, entry.cy);
+        entries[bucketStarts[bucket]++] = entry;
+    }
+
+    // so shift them back by one
+    for (uint32_t i = bucketCount; i > 0; i--) {
+        bucketStarts[i] = bucketStarts[i - 1];
+    }
+    bucketStarts[0] = 0;
+}
+
+size_t CollisionGrid::size() const {
+    return pending.size() + oversized.size();
+}
+
+int32_t CollisionGrid::cellOf(float coord) {
+    // clamp so that the conversion can't overflow on garbage positions
+    return static_cast<int32_t>(std::floor(std::clamp(coord / CELL_SIZE, -1e9f, 1e9f)));
+}
+
+uint32_t CollisionGrid::bucketOf(int32_t cx, int32_t cy) const {
+    uint32_t hash = static_cast<uint32_t>(cx) * 73856093u ^ static_cast<uint32_t>(cy) * 19349663u;
+    return hash & bucketMask;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <defs/geode.hpp>
+
+#include <algorithm>
+#include <vector>
+
+// Uniform grid broadphase over the hitboxes of remote players.
+// Rebuilt from scratch whenever the players move (once per frame), then queried once per physics step for every local player,
+// so that the narrowphase only runs on players that are actually nearby.
+class CollisionGrid {
+public:
+    // in units, a bit larger than the hitbox of a regular size player (30 units), as almost every entry should fit in one cell
+    static constexpr float CELL_SIZE = 64.f;
+
+    void clear();
+    void insert(const cocos2d::CCRect& rect, uint32_t id);
+    // must be called after inserting and before querying
+    void build();
+
+    size_t size() const;
+
+    // calls `f(id, rect)` for every entry that intersects `rect`, the same entry is never reported twice
+    template <typename F>
+    void query(const cocos2d::CCRect& rect, F&& f) const {
+        float minX = rect.getMinX(), minY = rect.getMinY();
+        float maxX = rect.getMaxX(), maxY = rect.getMaxY();
+
+        auto check = [&](const Entry& entry) {
+            if (entry.minX <= maxX && entry.maxX >= minX && entry.minY <= maxY && entry.maxY >= minY) {
+                f(entry.id, entry.rect());
+            }
+        };
+
+        for (const auto& entry : oversized) {
+            check(entry);
+        }
+
+        if (entries.empty()) return;
+
+        // entries are stored in the cell of their bottom left corner, and are at most a cell large,
+        // so anything intersecting can also start one cell to the left or below
+        int32_t cx0 = cellOf(minX) - 1, cx1 = cellOf(maxX);
+        int32_t cy0 = cellOf(minY) - 1, cy1 = cellOf(maxY);
+
+        // a huge query is cheaper to check against everything
+        if (static_cast<int64_t>(cx1 - cx0 + 1) * (cy1 - cy0 + 1) > static_cast<int64_t>(entries.size())) {
+            for (const auto& entry : entries) {
+                check(entry);
+            }
+
+            return;
+        }
+
+        for (int32_t cy = cy0; cy <= cy1; cy++) {
+            for (int32_t cx = cx0; cx <= cx1; cx++) {
+                uint32_t bucket = bucketOf(cx, cy);
+
+                for (uint32_t i = bucketStarts[bucket]; i < bucketStarts[bucket + 1]; i++) {
+                    const auto& entry = entries[i];
+                    // other cells can share the bucket
+                    if (entry.cx == cx && entry.cy == cy) {
+                        check(entry);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    struct Entry {
+        int32_t cx = 0, cy = 0;
+        float minX, minY, maxX, maxY;
+        uint32_t id;
+
+        cocos2d::CCRect rect() const {
+            return cocos2d::CCRect{minX, minY, maxX - minX, maxY - minY};
+        }
+    };
+
+    // cells are hashed into buckets, and `entries` is grouped by bucket with a counting sort, which keeps the rebuild linear
+    std::vector<Entry> pending;
+    std::vector<Entry> entries;
+    std::vector<uint32_t> bucketStarts;
+    uint32_t bucketMask = 0;
+    // entries larger than a cell, checked on every query
+    std::vector<Entry> oversized;
+
+    static int32_t cellOf(float coord);
+    uint32_t bucketOf(int32_t cx, int32_t cy) const;
+};
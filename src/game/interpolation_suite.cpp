@@ -0,0 +1,256 @@
+#include "interpolation_suite.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+using namespace geode::prelude;
+
+namespace {
+    constexpr float DURATION = 20.f;
+    constexpr float RENDER_DELTA = 1.f / 240.f;
+    constexpr float BASE_LATENCY = 0.05f;
+    constexpr float SPEED = 311.58f;
+    constexpr float GROUND = 105.f;
+    constexpr float CEILING = 285.f;
+    constexpr float SPIDER_PERIOD = 0.8f;
+
+    // ground truth, `sendDelta` is only used to know which frame comes first after a teleport
+    struct Trajectory {
+        const char* name;
+        PlayerData (*frameAt)(float t, float sendDelta);
+    };
+
+    const Trajectory TRAJECTORIES[] = {
+        {"cube", [](float t, float) {
+            float jumps = std::floor(t / 1.2f);
+            float phase = std::fmod(t, 1.2f) / 0.4f;
+
+            float y = GROUND;
+            float rotation = 180.f * (jumps + 1.f);
+            if (phase < 1.f) {
+                y += 240.f * phase * (1.f - phase);
+                rotation = 180.f * (jumps + phase);
+            }
+
+            return InterpolationSuite::traceFrame(t, {SPEED * t, y}, rotation);
+        }},
+        {"ship", [](float t, float) {
+            float dy = 160.f * std::cos(2.f * t);
+            float rotation = -std::atan2(dy, SPEED) * 180.f / 3.14159265f;
+            return InterpolationSuite::traceFrame(t, {SPEED * t, 200.f + 80.f * std::sin(2.f * t)}, rotation, PlayerIconType::Ship);
+        }},
+        {"wave", [](float t, float) {
+            float segment = std::floor(t / 0.35f);
+            float phase = std::fmod(t, 0.35f);
+            bool up = static_cast<int>(segment) % 2 == 0;
+
+            float y = 200.f + (up ? phase : 0.35f - phase) * SPEED - 0.175f * SPEED;
+            return InterpolationSuite::traceFrame(t, {SPEED * t, y}, up ? -45.f : 45.f, PlayerIconType::Wave);
+        }},
+        // teleports between the floor and the ceiling
+        {"spider", [](float t, float sendDelta) {
+            float segment = std::floor(t / SPIDER_PERIOD);
+            bool onCeiling = static_cast<int>(segment) % 2 == 1;
+
+            auto data = InterpolationSuite::traceFrame(t, {SPEED * t, onCeiling ? CEILING : GROUND}, 0.f, PlayerIconType::Spider);
+            data.player1.isUpsideDown = onCeiling;
+            data.player1.isGrounded = true;
+
+            if (segment > 0.f && std::floor(std::max(t - sendDelta, 0.f) / SPIDER_PERIOD) < segment) {
+                data.player1.spiderTeleportData = SpiderTeleportData {
+                    .from = {SPEED * t, onCeiling ? GROUND : CEILING},
+                    .to = data.player1.position,
+                };
+            }
+
+            return data;
+        }},
+    };
+
+    struct Network {
+        const char* name;
+        uint32_t tps;
+        float jitter; // standard deviation of the latency, in seconds
+        float loss;
+    };
+
+    constexpr Network NETWORKS[] = {
+        {"30 tps, perfect", 30, 0.f, 0.f},
+        {"30 tps, 15ms jitter, 1% loss", 30, 0.015f, 0.01f},
+        {"30 tps, 40ms jitter, 5% loss", 30, 0.04f, 0.05f},
+        {"60 tps, 15ms jitter, 1% loss", 60, 0.015f, 0.01f},
+        {"15 tps, 15ms jitter, 1% loss", 15, 0.015f, 0.01f},
+    };
+
+    InterpolationSuite::Accuracy runAccuracy(const Trajectory& trajectory, const Network& network) {
+        float sendDelta = 1.f / static_cast<float>(network.tps);
+
+        std::mt19937 rng(42);
+        std::normal_distribution<float> jitterDist(0.f, network.jitter);
+        std::uniform_real_distribution<float> lossDist(0.f, 1.f);
+
+        std::vector<std::pair<float, PlayerData>> packets;
+        for (float t = 0.f; t < DURATION; t += sendDelta) {
+            if (lossDist(rng) < network.loss) continue;
+            packets.emplace_back(t + BASE_LATENCY + std::abs(jitterDist(rng)), trajectory.frameAt(t, sendDelta));
+        }
+
+        std::stable_sort(packets.begin(), packets.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        PlayerInterpolator interpolator(InterpolatorSettings {
+            .realtime = false,
+            .isPlatformer = false,
+            .expectedDelta = sendDelta,
+        });
+        interpolator.addPlayer(1);
+
+        size_t nextPacket = 0;
+        size_t ticks = 0, snaps = 0;
+        double errorSquared = 0.0;
+        float maxError = 0.f;
+
+        CCPoint lastShown, lastTruth;
+        float teleportedAt = -1.f;
+        bool started = false;
+
+        for (float now = 0.f; now < DURATION; now += RENDER_DELTA) {
+            while (nextPacket < packets.size() && packets[nextPacket].first <= now) {
+                interpolator.updatePlayer(1, packets[nextPacket].second);
+                nextPacket++;
+            }
+
+            interpolator.tick(RENDER_DELTA);
+
+            if (nextPacket == 0) continue;
+
+            float playout = interpolator.getPlayerStats(1).playoutTime;
+            auto shown = interpolator.getPlayerState(1).player1.position;
+            auto expected = trajectory.frameAt(playout, sendDelta).player1.position;
+
+            float error = shown.getDistance(expected);
+            errorSquared += static_cast<double>(error) * error;
+            maxError = std::max(maxError, error);
+
+            if (started) {
+                auto truthStep = expected - lastTruth;
+                auto shownStep = shown - lastShown;
+
+                // the receiver can't know exactly when a teleport happened, so it gets a couple of packets of leeway
+                if (truthStep.getLength() > InterpolationSuite::SNAP_DISTANCE) {
+                    teleportedAt = playout;
+                }
+
+                bool nearTeleport = teleportedAt >= 0.f && playout - teleportedAt <= sendDelta * 2.f;
+                if (!nearTeleport && (shownStep - truthStep).getLength() > InterpolationSuite::SNAP_DISTANCE) {
+                    snaps++;
+                }
+            }
+
+            lastShown = shown;
+            lastTruth = expected;
+            started = true;
+            ticks++;
+        }
+
+        auto stats = interpolator.getPlayerStats(1);
+
+        return InterpolationSuite::Accuracy {
+            .trajectory = trajectory.name,
+            .network = network.name,
+            .rmsError = static_cast<float>(std::sqrt(errorSquared / std::max<size_t>(ticks, 1))),
+            .maxError = maxError,
+            .snaps = snaps,
+            .clockSnaps = stats.clockSnaps,
+            .starvedTicks = stats.starvedTicks,
+            .droppedFrames = stats.droppedFrames,
+        };
+    }
+}
+
+std::vector<InterpolationSuite::Accuracy> InterpolationSuite::measureAccuracy() {
+    std::vector<Accuracy> results;
+
+    for (const auto& trajectory : TRAJECTORIES) {
+        for (const auto& network : NETWORKS) {
+            results.push_back(runAccuracy(trajectory, network));
+        }
+    }
+
+    return results;
+}
+
+std::vector<InterpolationSuite::Cost> InterpolationSuite::measureCost(int players) {
+    constexpr size_t TICKS = 2400;
+    constexpr float SEND_DELTA = 1.f / 30.f;
+
+    std::vector<Cost> results;
+
+    for (const auto& trajectory : TRAJECTORIES) {
+        std::vector<PlayerData> trace;
+        for (float t = 0.f; t < 10.f; t += SEND_DELTA) {
+            trace.push_back(trajectory.frameAt(t, SEND_DELTA));
+        }
+
+        PlayerInterpolator interpolator(InterpolatorSettings {
+            .realtime = false,
+            .isPlatformer = false,
+            .expectedDelta = SEND_DELTA,
+        });
+
+        for (int id = 0; id < players; id++) {
+            interpolator.addPlayer(id);
+        }
+
+        // what one packet of the whole room looks like
+        std::vector<AssociatedPlayerData> packet, unknown;
+        packet.reserve(players);
+
+        float now = 0.f;
+        size_t sent = 0;
+        std::chrono::nanoseconds ingestTook{};
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (size_t tick = 0; tick < TICKS; tick++) {
+            if (tick % 8 == 0) {
+                packet.clear();
+                for (int id = 0; id < players; id++) {
+                    packet.emplace_back(id, trace[(sent + id * 7) % trace.size()]);
+                    packet.back().data.timestamp = now;
+                }
+
+                auto ingestStart = std::chrono::steady_clock::now();
+                interpolator.updatePlayers(packet, unknown);
+                ingestTook += std::chrono::steady_clock::now() - ingestStart;
+
+                sent++;
+            }
+
+            interpolator.tick(RENDER_DELTA);
+            now += RENDER_DELTA;
+        }
+
+        auto took = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+        results.push_back(Cost {
+            .trajectory = trajectory.name,
+            .players = players,
+            .nanosPerPlayerTick = static_cast<double>(took.count()) / TICKS / players,
+            .nanosPerFrame = static_cast<double>(ingestTook.count()) / static_cast<double>(sent * players),
+        });
+    }
+
+    return results;
+}
+
+PlayerData InterpolationSuite::traceFrame(float t, CCPoint pos, float rotation, PlayerIconType icon) {
+    PlayerData data{};
+    data.timestamp = t;
+    data.player1.position = pos;
+    data.player1.rotation = rotation;
+    data.player1.iconType = icon;
+    data.player1.isVisible = true;
+    return data;
+}
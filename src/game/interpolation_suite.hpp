@@ -0,0 +1,41 @@
+#pragma once
+
+#include "interpolator.hpp"
+
+#include <vector>
+
+// Ground truth cube, ship, wave and spider (with teleports) trajectories, sampled at server tps and sent through `PlayerInterpolator`
+// over simulated networks with different jitter and packet loss.
+// Only depends on the interpolator, so it runs both from the in-mod benchmarks and from the standalone test project.
+class InterpolationSuite {
+public:
+    struct Accuracy {
+        const char* trajectory;
+        const char* network;
+        float rmsError;         // distance between the displayed and the real position at the playout time, in units
+        float maxError;
+        size_t snaps;           // displayed steps that were off from the real step by more than `SNAP_DISTANCE`, teleports excluded
+        size_t clockSnaps;
+        size_t starvedTicks;
+        size_t droppedFrames;
+    };
+
+    struct Cost {
+        const char* trajectory;
+        int players;
+        double nanosPerPlayerTick; // including packet ingestion
+        double nanosPerFrame;      // feeding one received frame into the interpolator
+    };
+
+    // a displayed step that is off from what the player really did by more than a block is a visible snap
+    static constexpr float SNAP_DISTANCE = 30.f;
+
+    // every trajectory over every network
+    static std::vector<Accuracy> measureAccuracy();
+
+    // a full room of players for every trajectory, all on the same one but each at a different point of it
+    static std::vector<Cost> measureCost(int players = 200);
+
+    // a visible player at `pos`, with everything else left default
+    static PlayerData traceFrame(float t, cocos2d::CCPoint pos, float rotation, PlayerIconType icon = PlayerIconType::Cube);
+};
@@ -1,35 +1,102 @@
 #include "interpolator.hpp"
 
-#include "lerp_logger.hpp"
-#include <hooks/gjbasegamelayer.hpp>
 #include <util/math.hpp>
-#include <util/debug.hpp>
-#include <util/format.hpp>
+
+#include <algorithm>
+#include <utility>
 
 using namespace geode::prelude;
 
 PlayerInterpolator::PlayerInterpolator(const InterpolatorSettings& settings) : settings(settings) {}
 
+PlayerInterpolator::~PlayerInterpolator() {
+    for (int playerId : slotIds) {
+        LerpLogger::get().releaseRing(playerId);
+    }
+}
+
 void PlayerInterpolator::addPlayer(int playerId) {
-    players.emplace(playerId, PlayerState {});
+    if (slots.contains(playerId)) return;
+
+    slots.emplace(playerId, states.size());
+    slotIds.push_back(playerId);
+    states.emplace_back();
+    states.back().lerpLog = LerpLogger::get().acquireRing(playerId);
+    this->resizeLanes();
+
 #ifdef GLOBED_DEBUG_INTERPOLATION
     LerpLogger::get().reset(playerId);
 #endif
 }
 
 void PlayerInterpolator::removePlayer(int playerId) {
-    players.erase(playerId);
+    auto it = slots.find(playerId);
+    if (it == slots.end()) return;
+
+    size_t slot = it->second;
+    size_t last = states.size() - 1;
+
+    if (slot != last) {
+        states[slot] = std::move(states[last]);
+        slotIds[slot] = slotIds[last];
+        slots[slotIds[slot]] = slot;
+    }
+
+    states.pop_back();
+    slotIds.pop_back();
+    slots.erase(it);
+    this->resizeLanes();
+
+    LerpLogger::get().releaseRing(playerId);
 }
 
 bool PlayerInterpolator::hasPlayer(int playerId) {
-    return players.contains(playerId);
+    return slots.contains(playerId);
+}
+
+PlayerInterpolator::PlayerState& PlayerInterpolator::getState(int playerId) {
+    return states[slots.at(playerId)];
+}
+
+void PlayerInterpolator::resizeLanes() {
+    for (size_t lane = 0; lane < LaneCount; lane++) {
+        lerpFrom[lane].resize(states.size());
+        lerpTo[lane].resize(states.size());
+    }
+
+    lerpRatios.resize(states.size());
+}
+
+void PlayerInterpolator::updatePlayers(const std::vector<AssociatedPlayerData>& frames, std::vector<AssociatedPlayerData>& unknown) {
+    for (const auto& frame : frames) {
+        if (!this->updatePlayer(frame.accountId, frame.data)) {
+            unknown.push_back(frame);
+        }
+    }
 }
 
-void PlayerInterpolator::updatePlayer(int playerId, const PlayerData& data, float updateCounter) {
-    auto& player = players.at(playerId);
-    player.updateCounter = updateCounter;
-    player.pendingRealFrame = true;
+bool PlayerInterpolator::updatePlayer(int playerId, const PlayerData& data) {
+    auto it = slots.find(playerId);
+    if (it == slots.end()) return false;
+
+    auto& player = states[it->second];
+    player.updateCounter = localTime;
+
+    if (!settings.realtime && player.history.size() > 0) {
+        float newestTs = player.history.newest().timestamp;
+
+        if (data.timestamp <= newestTs) {
+            if (newestTs - data.timestamp < CLOCK_RESET_THRESHOLD) {
+                this->insertLateFrame(playerId, player, data);
+                return true;
+            }
+
+            player.history.clear();
+        }
+    }
+
     player.totalFrames++;
+    player.stats.realFrames++;
 
     if (!util::math::equal(player.lastDeathTimestamp, data.lastDeathTimestamp)) {
         player.lastDeathTimestamp = data.lastDeathTimestamp;
@@ -44,104 +111,293 @@ void PlayerInterpolator::updatePlayer(int playerId, const PlayerData& data, floa
     player.frameFlags.pendingP1Jump = data.player1.didJustJump;
     player.frameFlags.pendingP2Jump = data.player1.didJustJump;
 
-    LerpLogger::get().logRealFrame(playerId, this->getLocalTs(), data.timestamp, data.player1);
+    LerpLogger::get().logRealFrame(playerId, localTime, data.timestamp, data.player1);
 
+    if (player.lerpLog) {
+        player.lerpLog->push(LerpLogger::EntryKind::Real, localTime, data.timestamp, data.player1);
+    }
+
+    // `tick` copies the frame over to the interpolated state
     if (settings.realtime) {
-        player.interpolatedState = data;
-        return;
+        player.history.clear();
+        player.history.push(data);
+        return true;
     }
 
-    player.olderFrame = player.newerFrame;
-    player.newerFrame = data;
+    auto& stats = player.stats;
 
-    player.timeCounter = player.olderFrame.timestamp;
-}
+    // rfc 3550 style jitter, how much the time between arrivals differs from the time between the sends
+    if (player.history.size() > 0) {
+        float sendDelta = data.timestamp - player.history.newest().timestamp;
+        float transitDelta = (localTime - player.newestArrival) - sendDelta;
+        stats.jitter += (std::abs(transitDelta) - stats.jitter) / 16.f;
 
-static inline void lerpSpecific(
-        const SpecificIconData& older,
-        const SpecificIconData& newer,
-        SpecificIconData& out,
-        float lerpRatio
-    ) {
+        if (sendDelta <= settings.expectedDelta * MAX_BUFFERED_GAP) {
+            stats.frameInterval = sendDelta > stats.frameInterval ? sendDelta : stats.frameInterval + (sendDelta - stats.frameInterval) / 16.f;
+        }
+    }
 
-    out.copyFlagsFrom(older);
+    player.newestArrival = localTime;
+    player.history.push(data);
 
-    // i hate spider
-    if (out.iconType == PlayerIconType::Spider && std::abs(older.position.y - newer.position.y) >= 33.f) {
-        out.position.x = std::lerp(older.position.x, newer.position.x, lerpRatio);
-        out.position.y = older.position.y;
-    } else {
-        out.position = older.position.lerp(newer.position, lerpRatio);
+    float interval = std::max(settings.expectedDelta, stats.frameInterval);
+
+    // the history has to hold every frame between the playout clock and the newest one, plus the one being lerped from,
+    // otherwise frames that weren't displayed yet get evicted and the player steps from frame to frame
+    float maxDelay = std::min(MAX_PLAYOUT_DELAY, interval * static_cast<float>(HISTORY_SIZE - 2));
+
+    stats.playoutDelay = std::clamp(
+        interval * (1.f + PLAYOUT_MARGIN) + JITTER_MULTIPLIER * stats.jitter,
+        settings.expectedDelta,
+        maxDelay
+    );
+
+    if (player.history.size() == 1) {
+        stats.playoutTime = data.timestamp - stats.playoutDelay;
     }
-    out.rotation = std::lerp(older.rotation, newer.rotation, lerpRatio);
+
+    return true;
 }
 
-static inline void lerpPlayer(
-        const VisualPlayerState& older,
-        const VisualPlayerState& newer,
-        VisualPlayerState& out,
-        float lerpRatio
-    ) {
+void PlayerInterpolator::insertLateFrame(int playerId, PlayerState& player, const PlayerData& data) {
+    // frames at or behind the one being lerped from can't be shown anymore, and duplicates add nothing
+    if (data.timestamp <= player.history[0].timestamp || !player.history.insert(data)) {
+        player.stats.droppedFrames++;
+        return;
+    }
+
+    player.totalFrames++;
+    player.stats.realFrames++;
+
+    // the newer frames already carry the death state, a late one could only bring back an old death timestamp.
+    // one-shot events would be lost though, so those are kept
+    if (data.player1.spiderTeleportData) player.frameFlags.pendingP1Teleport = data.player1.spiderTeleportData;
+    if (data.player2.spiderTeleportData) player.frameFlags.pendingP2Teleport = data.player2.spiderTeleportData;
+    player.frameFlags.pendingP1Jump |= data.player1.didJustJump;
+    player.frameFlags.pendingP2Jump |= data.player2.didJustJump;
+
+    LerpLogger::get().logRealFrame(playerId, localTime, data.timestamp, data.player1);
+
+    if (player.lerpLog) {
+        player.lerpLog->push(LerpLogger::EntryKind::Real, localTime, data.timestamp, data.player1);
+    }
+}
 
-    lerpSpecific(older.player1, newer.player1, out.player1, lerpRatio);
-    lerpSpecific(older.player2, newer.player2, out.player2, lerpRatio);
+// copies everything that doesn't get lerped
+static inline void copyUnlerped(const VisualPlayerState& from, VisualPlayerState& out) {
+    out.player1.copyFlagsFrom(from.player1);
+    out.player2.copyFlagsFrom(from.player2);
+
+    out.currentPercentage = from.currentPercentage;
+    out.isDead = from.isDead;
+    out.isPaused = from.isPaused;
+    out.isPracticing = from.isPracticing;
+    out.isDualMode = from.isDualMode;
+    out.isInEditor = from.isInEditor;
+    out.isEditorBuilding = from.isEditorBuilding;
+}
 
-    out.currentPercentage = older.currentPercentage;
-    out.isDead = older.isDead;
-    out.isPaused = older.isPaused;
-    out.isPracticing = older.isPracticing;
-    out.isDualMode = older.isDualMode;
-    out.isInEditor = older.isInEditor;
-    out.isEditorBuilding = older.isEditorBuilding;
+static inline LerpLogger::EntryKind toLogEntryKind(PlayerInterpolator::TickKind kind) {
+    switch (kind) {
+        case PlayerInterpolator::TickKind::Lerp: return LerpLogger::EntryKind::Lerp;
+        case PlayerInterpolator::TickKind::Extrapolate: return LerpLogger::EntryKind::Extrapolate;
+        default: return LerpLogger::EntryKind::Hold;
+    }
 }
 
 void PlayerInterpolator::tick(float dt) {
-    if (settings.realtime) return;
+    localTime += dt;
+
+    if (settings.realtime) {
+        for (auto& player : states) {
+            if (player.history.size() != 0) {
+                player.interpolatedState = player.history.newest().visual;
+            }
+        }
+
+        return;
+    }
+
+    size_t count = states.size();
+
+    for (size_t slot = 0; slot < count; slot++) {
+        auto& player = states[slot];
+
+        if (player.history.size() != 0) {
+            auto& stats = player.stats;
+
+            // the clock should trail the newest frame by the playout delay, steer it there without visible jumps
+            float target = player.history.newest().timestamp + (localTime - player.newestArrival) - stats.playoutDelay;
+            float error = target - stats.playoutTime;
+
+            if (std::abs(error) > CLOCK_SNAP_THRESHOLD) {
+                stats.playoutTime = target;
+                stats.clockSnaps++;
+            } else {
+                stats.playoutTime += dt * (1.f + std::clamp(error / CLOCK_CATCHUP_TIME, -MAX_CLOCK_SLEW, MAX_CLOCK_SLEW));
+            }
+        }
+
+        this->preparePlayer(slot);
+    }
 
-    for (auto& [playerId, player] : players) {
-        if (player.totalFrames < 2) continue;
+    // the lerp itself, for every player at once. results are written back into `lerpFrom`
+    for (size_t lane = 0; lane < LaneCount; lane++) {
+        util::math::lerpArrays(lerpFrom[lane].data(), lerpTo[lane].data(), lerpRatios.data(), lerpFrom[lane].data(), count);
+    }
+
+    for (size_t slot = 0; slot < count; slot++) {
+        auto& out = states[slot].interpolatedState;
+        out.player1.position = CCPoint{lerpFrom[P1X][slot], lerpFrom[P1Y][slot]};
+        out.player1.rotation = lerpFrom[P1Rotation][slot];
+        out.player2.position = CCPoint{lerpFrom[P2X][slot], lerpFrom[P2Y][slot]};
+        out.player2.rotation = lerpFrom[P2Rotation][slot];
+
+        if (auto* ring = states[slot].lerpLog) {
+            ring->push(toLogEntryKind(states[slot].lastTick), localTime, states[slot].stats.playoutTime, out.player1);
+        }
 
-        float frameDelta = player.newerFrame.timestamp - player.olderFrame.timestamp;
-        if (frameDelta == 0.f) {
-            LerpLogger::get().logLerpSkip(playerId, this->getLocalTs(), player.timeCounter, player.interpolatedState.player1);
-            continue;
+#ifdef GLOBED_DEBUG_INTERPOLATION
+        auto& player = states[slot];
+        int playerId = slotIds[slot];
+        float time = player.stats.playoutTime;
+
+        switch (player.lastTick) {
+            case TickKind::Hold:
+                LerpLogger::get().logLerpSkip(playerId, localTime, time, out.player1);
+                break;
+            case TickKind::Lerp:
+                LerpLogger::get().logLerpOperation(playerId, localTime, time, out.player1);
+                break;
+            case TickKind::Extrapolate:
+                LerpLogger::get().logExtrapolatedRealFrame(playerId, localTime, player.history.newest().timestamp, time, player.history.newest().visual.player1, out.player1);
+                break;
         }
+#endif
+    }
+}
+
+void PlayerInterpolator::setLanes(size_t slot, const VisualPlayerState& from, const VisualPlayerState& to, float ratio) {
+    lerpFrom[P1X][slot] = from.player1.position.x;
+    lerpFrom[P1Y][slot] = from.player1.position.y;
+    lerpFrom[P1Rotation][slot] = from.player1.rotation;
+    lerpFrom[P2X][slot] = from.player2.position.x;
+    lerpFrom[P2Y][slot] = from.player2.position.y;
+    lerpFrom[P2Rotation][slot] = from.player2.rotation;
+
+    lerpTo[P1X][slot] = to.player1.position.x;
+    lerpTo[P1Y][slot] = to.player1.position.y;
+    lerpTo[P1Rotation][slot] = to.player1.rotation;
+    lerpTo[P2X][slot] = to.player2.position.x;
+    lerpTo[P2Y][slot] = to.player2.position.y;
+    lerpTo[P2Rotation][slot] = to.player2.rotation;
+
+    // i hate spider
+    if (from.player1.iconType == PlayerIconType::Spider && std::abs(from.player1.position.y - to.player1.position.y) >= 33.f) {
+        lerpTo[P1Y][slot] = from.player1.position.y;
+    }
+
+    if (from.player2.iconType == PlayerIconType::Spider && std::abs(from.player2.position.y - to.player2.position.y) >= 33.f) {
+        lerpTo[P2Y][slot] = from.player2.position.y;
+    }
+
+    lerpRatios[slot] = ratio;
+}
+
+void PlayerInterpolator::preparePlayer(size_t slot) {
+    auto& player = states[slot];
+    auto& history = player.history;
+    auto& stats = player.stats;
+    float time = stats.playoutTime;
+
+    if (history.size() == 0) {
+        // nothing received yet, keep whatever is there
+        this->setLanes(slot, player.interpolatedState, player.interpolatedState, 0.f);
+        player.lastTick = TickKind::Hold;
+        return;
+    }
+
+    // keep one frame behind the clock to lerp from, or two if there's nothing ahead of it, for extrapolation
+    while (history.size() > 2 && history[1].timestamp <= time) {
+        history.popOldest();
+    }
+
+    if (time <= history[0].timestamp) {
+        player.interpolatedState = history[0].visual;
+        this->setLanes(slot, history[0].visual, history[0].visual, 0.f);
+        player.lastTick = TickKind::Hold;
+        return;
+    }
+
+    if (history.size() >= 2 && time < history[1].timestamp) {
+        const auto& older = history[0];
+        const auto& newer = history[1];
+
+        copyUnlerped(older.visual, player.interpolatedState);
+        this->setLanes(slot, older.visual, newer.visual, (time - older.timestamp) / (newer.timestamp - older.timestamp));
+        player.lastTick = TickKind::Lerp;
+        return;
+    }
+
+    // ran out of frames
+    stats.starvedTicks++;
+
+    const auto& newest = history.newest();
+
+    if (settings.extrapolation && history.size() >= 2) {
+        const auto& older = history[0];
 
-        float lerpRatio = (player.timeCounter - player.olderFrame.timestamp) / frameDelta;
-        lerpPlayer(player.olderFrame.visual, player.newerFrame.visual, player.interpolatedState, lerpRatio);
+        float frameDelta = newest.timestamp - older.timestamp;
+        float extraTime = std::min(time - newest.timestamp, settings.expectedDelta * MAX_EXTRAPOLATION_FRAMES);
 
-        LerpLogger::get().logLerpOperation(playerId, this->getLocalTs(), player.timeCounter, player.interpolatedState.player1);
+        // flags should still come from the newest frame and not the older one
+        copyUnlerped(newest.visual, player.interpolatedState);
+        this->setLanes(slot, older.visual, newest.visual, 1.f + extraTime / frameDelta);
 
-        player.timeCounter += dt;
+        stats.extrapolatedTicks++;
+        player.lastTick = TickKind::Extrapolate;
+        return;
     }
+
+    player.interpolatedState = newest.visual;
+    this->setLanes(slot, newest.visual, newest.visual, 0.f);
+    player.lastTick = TickKind::Hold;
 }
 
 VisualPlayerState& PlayerInterpolator::getPlayerState(int playerId) {
-    return players.at(playerId).interpolatedState;
+    return this->getState(playerId).interpolatedState;
 }
 
 FrameFlags PlayerInterpolator::swapFrameFlags(int playerId) {
-    auto& state = players.at(playerId);
+    auto& state = this->getState(playerId);
     FrameFlags out;
-    out.pendingDeath = util::misc::swapFlag(state.frameFlags.pendingDeath);
-    out.pendingRealDeath = util::misc::swapFlag(state.frameFlags.pendingRealDeath);
-    out.pendingP1Jump = util::misc::swapFlag(state.frameFlags.pendingP1Jump);
-    out.pendingP2Jump = util::misc::swapFlag(state.frameFlags.pendingP2Jump);
+    out.pendingDeath = std::exchange(state.frameFlags.pendingDeath, false);
+    out.pendingRealDeath = std::exchange(state.frameFlags.pendingRealDeath, false);
+    out.pendingP1Jump = std::exchange(state.frameFlags.pendingP1Jump, false);
+    out.pendingP2Jump = std::exchange(state.frameFlags.pendingP2Jump, false);
 
-    out.pendingP1Teleport = util::misc::swapOptional(state.frameFlags.pendingP1Teleport);
-    out.pendingP2Teleport = util::misc::swapOptional(state.frameFlags.pendingP2Teleport);
+    out.pendingP1Teleport = std::exchange(state.frameFlags.pendingP1Teleport, std::nullopt);
+    out.pendingP2Teleport = std::exchange(state.frameFlags.pendingP2Teleport, std::nullopt);
 
     return out;
 }
 
-bool PlayerInterpolator::isPlayerStale(int playerId, float lastServerPacket) {
-    auto uc = players.at(playerId).updateCounter;
+bool PlayerInterpolator::isPlayerStale(int playerId, float lastServerPacket, float threshold) {
+    auto uc = this->getState(playerId).updateCounter;
+
+    return uc != 0.f && std::abs(uc - lastServerPacket) > threshold;
+}
+
+float PlayerInterpolator::getLastUpdate(int playerId) {
+    return this->getState(playerId).updateCounter;
+}
 
-    return uc != 0.f && std::abs(uc - lastServerPacket) > 0.5f;
+PlayerInterpolator::PlayerStats PlayerInterpolator::getPlayerStats(int playerId) {
+    return this->getState(playerId).stats;
 }
 
 float PlayerInterpolator::getLocalTs() {
-    return GlobedGJBGL::get()->m_fields->timeCounter;
+    return localTime;
 }
 
 PlayerInterpolator::LerpFrame::LerpFrame() {
@@ -153,3 +409,62 @@ PlayerInterpolator::LerpFrame::LerpFrame(const PlayerData& data) {
     timestamp = data.timestamp;
     visual = data;
 }
+
+size_t PlayerInterpolator::FrameHistory::size() const {
+    return count;
+}
+
+void PlayerInterpolator::FrameHistory::push(const LerpFrame& frame) {
+    if (count == HISTORY_SIZE) {
+        this->popOldest();
+    }
+
+    frames[(head + count) % HISTORY_SIZE] = frame;
+    count++;
+}
+
+bool PlayerInterpolator::FrameHistory::insert(const LerpFrame& frame) {
+    // late frames are rarely more than a couple of frames late, so search from the newest end
+    size_t pos = count;
+    while (pos > 0 && (*this)[pos - 1].timestamp > frame.timestamp) {
+        pos--;
+    }
+
+    if (pos > 0 && (*this)[pos - 1].timestamp == frame.timestamp) {
+        return false;
+    }
+
+    if (count == HISTORY_SIZE) {
+        if (pos == 0) return false;
+
+        this->popOldest();
+        pos--;
+    }
+
+    for (size_t i = count; i > pos; i--) {
+        frames[(head + i) % HISTORY_SIZE] = frames[(head + i - 1) % HISTORY_SIZE];
+    }
+
+    frames[(head + pos) % HISTORY_SIZE] = frame;
+    count++;
+
+    return true;
+}
+
+void PlayerInterpolator::FrameHistory::popOldest() {
+    head = (head + 1) % HISTORY_SIZE;
+    count--;
+}
+
+void PlayerInterpolator::FrameHistory::clear() {
+    head = 0;
+    count = 0;
+}
+
+const PlayerInterpolator::LerpFrame& PlayerInterpolator::FrameHistory::operator[](size_t idx) const {
+    return frames[(head + idx) % HISTORY_SIZE];
+}
+
+const PlayerInterpolator::LerpFrame& PlayerInterpolator::FrameHistory::newest() const {
+    return (*this)[count - 1];
+}
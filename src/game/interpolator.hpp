@@ -1,19 +1,27 @@
 #pragma once
 
 #include "visual_state.hpp"
+#include "lerp_logger.hpp"
 #include <data/types/game.hpp>
 
+#include <array>
+#include <unordered_map>
+#include <vector>
+
 struct InterpolatorSettings {
     bool realtime;      // no interpolation at all
     bool isPlatformer;  // platformer duh
     float expectedDelta;
+    bool extrapolation = false; // when no new data arrives in time, keep the player moving instead of freezing them
 };
 
 class PlayerInterpolator {
 public:
     struct PlayerState;
+    struct PlayerStats;
 
     PlayerInterpolator(const InterpolatorSettings& settings);
+    ~PlayerInterpolator();
 
     PlayerInterpolator(PlayerInterpolator&) = delete;
     PlayerInterpolator& operator=(PlayerInterpolator&) = delete;
@@ -23,27 +31,82 @@ public:
     bool hasPlayer(int playerId);
 
     // Update the last known state of the player. Should be called only when new data is received.
-    void updatePlayer(int playerId, const PlayerData& data, float updateCounter);
+    // Returns `false` and does nothing if the player wasn't added.
+    bool updatePlayer(int playerId, const PlayerData& data);
+
+    // Calls `updatePlayer` for every frame, frames of players that weren't added are appended to `unknown`.
+    void updatePlayers(const std::vector<AssociatedPlayerData>& frames, std::vector<AssociatedPlayerData>& unknown);
 
     // Interpolate the player state. Should preferrably be called every frame.
     void tick(float dt);
 
-    // Get the current interpolated visual state of the player. This is what you pass into `RemotePlayer::updateData`
+    // Get the current interpolated visual state of the player. This is what you pass into `RemotePlayer::updateData`.
+    // The reference is invalidated when any player is added or removed.
     VisualPlayerState& getPlayerState(int playerId);
 
     // returns `true` if death animation needs to be played and sets the flag back to false (so next call won't return `true` again)
     FrameFlags swapFrameFlags(int playerId);
 
-    // returns `true` if the given time of the last packet doesn't match the last update time of the player
-    bool isPlayerStale(int playerId, float lastServerPacket);
+    // returns `true` if the last update time of the player is more than `threshold` seconds away from the given time of the last packet
+    bool isPlayerStale(int playerId, float lastServerPacket, float threshold = 0.5f);
+
+    // the local time of the last update of the player, 0 if they never got one
+    float getLastUpdate(int playerId);
+
+    // Get the playback statistics of the player, mostly useful for debugging and benchmarks
+    PlayerStats getPlayerStats(int playerId);
 
+    // Local time, advanced by every `tick` call
     float getLocalTs();
 
 private:
-    std::unordered_map<int, PlayerState> players;
-    InterpolatorSettings settings;
+    // players are stored densely, removing one moves the last player into its slot
+    std::unordered_map<int, size_t> slots;
+    std::vector<int> slotIds;
+    std::vector<PlayerState> states;
+
+    // values that get lerped every tick, one array per value with one element per slot, so all players are done in one pass
+    enum Lane : size_t {
+        P1X, P1Y, P1Rotation,
+        P2X, P2Y, P2Rotation,
+        LaneCount
+    };
 
-    constexpr static bool EXTRAPOLATION = false;
+    std::array<std::vector<float>, LaneCount> lerpFrom, lerpTo;
+    std::vector<float> lerpRatios;
+
+    InterpolatorSettings settings;
+    float localTime = 0.f;
+
+    // how many received frames are kept per player. enough to cover `MAX_PLAYOUT_DELAY` at 60 tps,
+    // at higher rates the playout delay is capped by this instead
+    constexpr static size_t HISTORY_SIZE = 32;
+    // the playout delay is one packet interval plus this fraction of one, so that a packet arriving exactly on time
+    // doesn't starve the buffer, plus this many times the measured jitter
+    constexpr static float PLAYOUT_MARGIN = 0.25f;
+    constexpr static float JITTER_MULTIPLIER = 3.0f;
+    constexpr static float MAX_PLAYOUT_DELAY = 0.5f;
+    // the playout clock speeds up or slows down by at most this much to catch up with the target delay..
+    constexpr static float MAX_CLOCK_SLEW = 0.05f;
+    constexpr static float CLOCK_CATCHUP_TIME = 0.5f;
+    // ..unless it is off by more than this, then it just jumps
+    constexpr static float CLOCK_SNAP_THRESHOLD = 0.25f;
+    // a timestamp going back by more than this means the player restarted their clock rather than the packet being late
+    constexpr static float CLOCK_RESET_THRESHOLD = 1.0f;
+    // how far past the newest frame extrapolation can go, in packet intervals
+    constexpr static float MAX_EXTRAPOLATION_FRAMES = 2.0f;
+    // senders may skip frames they consider predictable, gaps up to this many packet intervals are buffered for,
+    // anything longer is a player standing still and is better off being held in place
+    constexpr static float MAX_BUFFERED_GAP = 4.0f;
+
+    PlayerState& getState(int playerId);
+    void resizeLanes();
+    // a frame older than the newest one, put into the history in timestamp order if it can still be displayed
+    void insertLateFrame(int playerId, PlayerState& player, const PlayerData& data);
+
+    // picks the frames to lerp between for the slot and fills in everything that isn't lerped
+    void preparePlayer(size_t slot);
+    void setLanes(size_t slot, const VisualPlayerState& from, const VisualPlayerState& to, float ratio);
 
 public:
 
@@ -55,15 +118,55 @@ public:
         VisualPlayerState visual;
     };
 
+    struct PlayerStats {
+        size_t realFrames = 0;          // frames that were received
+        size_t droppedFrames = 0;       // frames that were duplicated or arrived too late to be displayed
+        size_t starvedTicks = 0;        // ticks where the playout clock was past the newest frame
+        size_t extrapolatedTicks = 0;   // starved ticks that were extrapolated
+        size_t clockSnaps = 0;          // times the playout clock had to jump instead of smoothly catching up
+        float jitter = 0.f;             // smoothed packet arrival jitter, in seconds
+        float frameInterval = 0.f;      // time between sent frames, follows increases immediately and decreases slowly
+        float playoutDelay = 0.f;       // how far behind the newest frame the player is displayed
+        float playoutTime = 0.f;        // the sender timestamp currently being displayed
+    };
+
+    // ring buffer of received frames, ordered by timestamp
+    class FrameHistory {
+    public:
+        size_t size() const;
+        void push(const LerpFrame& frame);
+        // puts the frame in timestamp order, returns `false` if a frame with the same timestamp is already there
+        bool insert(const LerpFrame& frame);
+        void popOldest();
+        void clear();
+
+        // 0 is the oldest frame
+        const LerpFrame& operator[](size_t idx) const;
+        const LerpFrame& newest() const;
+
+    private:
+        std::array<LerpFrame, HISTORY_SIZE> frames;
+        size_t head = 0;
+        size_t count = 0;
+    };
+
+    enum class TickKind : uint8_t {
+        Hold, Lerp, Extrapolate
+    };
+
     struct PlayerState {
         float updateCounter = 0.0f;
-        float timeCounter = 0.0f;
         float lastDeathTimestamp = 0.0f;
         size_t totalFrames = 0;
 
-        LerpFrame olderFrame, newerFrame;
+        FrameHistory history;
+        float newestArrival = 0.f;
+
         VisualPlayerState interpolatedState;
-        bool pendingRealFrame = false;
         FrameFlags frameFlags;
+        PlayerStats stats;
+        TickKind lastTick = TickKind::Hold;
+        // null if recording is disabled
+        LerpLogger::Ring* lerpLog = nullptr;
     };
-};
\ No newline at end of file
+};
@@ -0,0 +1,59 @@
+#include "join_queue.hpp"
+
+#include <algorithm>
+
+void PlayerJoinQueue::push(int playerId) {
+    if (this->contains(playerId)) return;
+
+    queue.push_back(Pending {
+        .playerId = playerId,
+        .queuedAt = util::time::now(),
+    });
+
+    stats.pending = queue.size();
+}
+
+bool PlayerJoinQueue::remove(int playerId) {
+    auto it = std::find_if(queue.begin(), queue.end(), [&](const Pending& p) {
+        return p.playerId == playerId;
+    });
+
+    if (it == queue.end()) return false;
+
+    queue.erase(it);
+    stats.pending = queue.size();
+
+    return true;
+}
+
+bool PlayerJoinQueue::contains(int playerId) const {
+    return std::any_of(queue.begin(), queue.end(), [&](const Pending& p) {
+        return p.playerId == playerId;
+    });
+}
+
+bool PlayerJoinQueue::empty() const {
+    return queue.empty();
+}
+
+void PlayerJoinQueue::clear() {
+    queue.clear();
+    stats.pending = 0;
+}
+
+const PlayerJoinQueue::Stats& PlayerJoinQueue::getStats() const {
+    return stats;
+}
+
+void PlayerJoinQueue::recordLatency(util::time::clock::duration latency) {
+    stats.materialized++;
+    stats.lastLatency = util::time::as<util::time::millis>(latency);
+    stats.maxLatency = std::max(stats.maxLatency, stats.lastLatency);
+}
+
+void PlayerJoinQueue::recordFrame(size_t joins, util::time::clock::duration cost) {
+    stats.pending = queue.size();
+    stats.lastFrameJoins = joins;
+    stats.lastFrameCost = util::time::as<util::time::micros>(cost);
+    stats.maxFrameCost = std::max(stats.maxFrameCost, stats.lastFrameCost);
+}
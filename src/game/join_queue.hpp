@@ -0,0 +1,75 @@
+#pragma once
+
+#include <util/time.hpp>
+
+#include <deque>
+
+// Players that showed up in the level data but don't have a node yet.
+// Building a remote player is expensive (two full `PlayerObject`s), so when many players join at once,
+// they get materialized over several frames, as many as fit in `FRAME_BUDGET` (but always at least one).
+class PlayerJoinQueue {
+public:
+    struct Stats {
+        size_t pending = 0;
+        size_t materialized = 0;
+        // joins and time spent on them in the last frame that had any
+        size_t lastFrameJoins = 0;
+        util::time::micros lastFrameCost{0};
+        util::time::micros maxFrameCost{0};
+        // time between a player first appearing and their node being created
+        util::time::millis lastLatency{0};
+        util::time::millis maxLatency{0};
+    };
+
+    static constexpr util::time::micros FRAME_BUDGET{2000};
+
+    // does nothing if the player is already queued
+    void push(int playerId);
+    // returns `false` if the player was not queued
+    bool remove(int playerId);
+    bool contains(int playerId) const;
+    bool empty() const;
+    void clear();
+
+    // calls `f(playerId)` for queued players in the order they joined, until the frame budget runs out
+    template <typename F>
+    void drain(F&& f) {
+        if (queue.empty()) return;
+
+        auto start = util::time::now();
+        size_t joins = 0;
+
+        do {
+            auto pending = queue.front();
+            queue.pop_front();
+
+            f(pending.playerId);
+            joins++;
+
+            this->recordLatency(util::time::now() - pending.queuedAt);
+        } while (!queue.empty() && util::time::now() - start < FRAME_BUDGET);
+
+        this->recordFrame(joins, util::time::now() - start);
+    }
+
+    template <typename F>
+    void forEach(F&& f) const {
+        for (const auto& pending : queue) {
+            f(pending.playerId);
+        }
+    }
+
+    const Stats& getStats() const;
+
+private:
+    struct Pending {
+        int playerId;
+        util::time::time_point queuedAt;
+    };
+
+    std::deque<Pending> queue;
+    Stats stats;
+
+    void recordLatency(util::time::clock::duration latency);
+    void recordFrame(size_t joins, util::time::clock::duration cost);
+};
@@ -2,6 +2,110 @@
 
 #include <defs/assert.hpp>
 
+#include <algorithm>
+#include <fstream>
+
+size_t LerpLogger::Ring::size() const {
+    return count;
+}
+
+LerpLogger::Ring* LerpLogger::acquireRing(int playerId) {
+    if (!ringsEnabled) return nullptr;
+
+    auto it = rings.find(playerId);
+    if (it != rings.end()) {
+        // rejoined, keep going in the same ring
+        it->second->users++;
+        return it->second.get();
+    }
+
+    std::unique_ptr<Ring> ring;
+
+    if (rings.size() >= MAX_RINGS) {
+        auto inactive = std::find_if(rings.begin(), rings.end(), [](const auto& entry) {
+            return entry.second->users == 0;
+        });
+
+        if (inactive != rings.end()) {
+            ring = std::move(inactive->second);
+            rings.erase(inactive);
+
+            ring->head = 0;
+            ring->count = 0;
+            ring->users = 1;
+        }
+    }
+
+    if (!ring) {
+        ring = std::make_unique<Ring>();
+    }
+
+    auto* ptr = ring.get();
+    rings.emplace(playerId, std::move(ring));
+
+    return ptr;
+}
+
+void LerpLogger::releaseRing(int playerId) {
+    auto it = rings.find(playerId);
+    if (it != rings.end() && it->second->users > 0) {
+        it->second->users--;
+    }
+}
+
+void LerpLogger::clearInactiveRings() {
+    std::erase_if(rings, [](const auto& entry) {
+        return entry.second->users == 0;
+    });
+}
+
+void LerpLogger::setRingsEnabled(bool state) {
+    ringsEnabled = state;
+}
+
+Result<size_t> LerpLogger::dumpRings(const std::filesystem::path& path) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return Err(fmt::format("failed to open {}", path));
+    }
+
+    size_t written = 0;
+    auto write = [&](const void* data, size_t size) {
+        file.write(static_cast<const char*>(data), size);
+        written += size;
+    };
+
+    auto writeU32 = [&](uint32_t value) {
+        write(&value, sizeof(value));
+    };
+
+    // header, then for every player their id, entry count and entries. all little endian
+    writeU32(RING_DUMP_MAGIC);
+    writeU32(RING_DUMP_FORMAT);
+    writeU32(RING_SIZE);
+    writeU32(rings.size());
+
+    for (const auto& [playerId, ring] : rings) {
+        writeU32(static_cast<uint32_t>(playerId));
+        writeU32(ring->count);
+
+        // the oldest entry is at `head` once the ring has wrapped around
+        size_t start = ring->count < RING_SIZE ? 0 : ring->head;
+        size_t firstPart = std::min(ring->count, RING_SIZE - start);
+
+        write(ring->entries.data() + start, firstPart * sizeof(Entry));
+        write(ring->entries.data(), (ring->count - firstPart) * sizeof(Entry));
+    }
+
+    if (!file) {
+        return Err(fmt::format("failed to write to {}", path));
+    }
+
+    log::debug("dumped interpolation rings of {} players to {} ({} bytes)", rings.size(), path, written);
+
+    return Ok(written);
+}
+
 void LerpLogger::reset(uint32_t id) {
 #ifdef GLOBED_DEBUG_INTERPOLATION
     auto& player = this->ensureExists(id);
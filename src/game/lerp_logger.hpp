@@ -1,7 +1,11 @@
 #pragma once
 #include <defs/geode.hpp>
 
+#include <array>
 #include <filesystem>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include <data/types/game.hpp>
 #include <util/singleton.hpp>
@@ -23,8 +27,73 @@ struct PlayerLog {
 GLOBED_SERIALIZABLE_STRUCT(PlayerLogData, (localTimestamp, timestamp, position, rotation));
 GLOBED_SERIALIZABLE_STRUCT(PlayerLog, (realFrames, realExtrapolatedFrames, lerpedFrames, lerpSkippedFrames));
 
+// Records what the interpolator did with every player, to find out where stutter comes from.
+// Every player gets a fixed size ring buffer of the last `RING_SIZE` real and interpolated frames, which is cheap enough
+// to always have on. Rings stay around after the level is left, so that they can be dumped with `dumpRings` after
+// a user notices stutter, and are dropped once the next level starts.
+// With `GLOBED_DEBUG_INTERPOLATION`, the full history is kept as well and can be saved with `makeDump`.
 class LerpLogger : public SingletonBase<LerpLogger> {
 public:
+    static constexpr size_t RING_SIZE = 512;
+    // rings of players that left get recycled once there are this many
+    static constexpr size_t MAX_RINGS = 256;
+
+    enum class EntryKind : uint32_t {
+        Real, Lerp, Hold, Extrapolate
+    };
+
+    // written to the dump as is
+    struct Entry {
+        float localTimestamp;
+        float timestamp;
+        float x, y;
+        float rotation;
+        EntryKind kind;
+    };
+
+    static_assert(sizeof(Entry) == 24);
+
+    class Ring {
+    public:
+        void push(EntryKind kind, float localts, float timestamp, const SpecificIconData& data) {
+            entries[head] = Entry {
+                .localTimestamp = localts,
+                .timestamp = timestamp,
+                .x = data.position.x,
+                .y = data.position.y,
+                .rotation = data.rotation,
+                .kind = kind,
+            };
+
+            head = (head + 1) % RING_SIZE;
+            if (count < RING_SIZE) count++;
+        }
+
+        size_t size() const;
+
+    private:
+        friend class LerpLogger;
+
+        std::array<Entry, RING_SIZE> entries;
+        // where the next entry goes
+        size_t head = 0;
+        size_t count = 0;
+        // interpolators that have the player, 0 once they left the level
+        size_t users = 1;
+    };
+
+    // the ring for a player who joined, null if recording is disabled. stays valid until a matching `releaseRing`
+    Ring* acquireRing(int playerId);
+    // the player left, their frames are kept until the next level starts
+    void releaseRing(int playerId);
+    // drops the rings of players that aren't in the level anymore
+    void clearInactiveRings();
+    // only affects players that join afterwards
+    void setRingsEnabled(bool state);
+
+    // writes every ring to `path`, oldest entries first. returns the amount of bytes written
+    Result<size_t> dumpRings(const std::filesystem::path& path);
+
     void reset(uint32_t player);
 
     // real frames logging
@@ -42,5 +111,11 @@ private:
     PlayerLogData makeLogData(const SpecificIconData& data, float localts, float timeCounter);
 
     std::unordered_map<uint32_t, PlayerLog> players;
+
+    static constexpr uint32_t RING_DUMP_MAGIC = 0x42524c47; // "GLRB"
+    static constexpr uint32_t RING_DUMP_FORMAT = 1;
+
+    std::unordered_map<int, std::unique_ptr<Ring>> rings;
+    bool ringsEnabled = true;
 };
 
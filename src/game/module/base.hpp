@@ -1,7 +1,10 @@
 #pragma once
 
+#include <concepts>
+#include <cstdint>
 #include <functional>
 #include <string>
+#include <type_traits>
 
 /* forward decls */
 
@@ -21,6 +24,39 @@ class GlobedPlayLayer;
 class GlobedLevelEditorLayer;
 class PlayerAccountData;
 
+// Events that happen often enough (every frame, every physics step, for every player) that they are only
+// dispatched to the modules that handle them. Setup hooks and other one-off events are sent to every module.
+enum class ModuleEvent : uint8_t {
+    PlayerJoin,
+    PlayerLeave,
+    MainPlayerUpdate,
+    OnlinePlayerUpdate,
+    LoadLevelSettingsPre,
+    LoadLevelSettingsPost,
+    CheckCollisions,
+    FullResetLevel,
+    ResetLevel,
+    UpdateCameraPre,
+    UpdateCameraPost,
+    DestroyPlayerPre,
+    DestroyPlayerPost,
+    PlayerDestroyed,
+    SelPeriodicalUpdate,
+    SelUpdate,
+    SelUpdateEstimators,
+    UpdatePlayer,
+    UnscheduleSelectors,
+    RescheduleSelectors,
+    Count,
+};
+
+using ModuleEventMask = uint32_t;
+static_assert(static_cast<size_t>(ModuleEvent::Count) <= sizeof(ModuleEventMask) * 8);
+
+constexpr ModuleEventMask moduleEventBit(ModuleEvent event) {
+    return ModuleEventMask(1) << static_cast<uint32_t>(event);
+}
+
 class BaseGameplayModule {
 public:
     enum class [[nodiscard]] EventOutcome {
@@ -97,6 +133,47 @@ public:
     // Return a list of buttons to create.
     virtual std::vector<UserCellButton> onUserActionsPopup(int accountId, bool self) { return {}; }
 
+    // The events a module of type `T` gets. Unless `T` declares them explicitly with
+    // `static constexpr ModuleEventMask HANDLED_EVENTS`, these are the events whose methods it overrides.
+    template <typename T> requires (std::is_base_of_v<BaseGameplayModule, T>)
+    static constexpr ModuleEventMask handledEvents() {
+        if constexpr (requires { { T::HANDLED_EVENTS } -> std::convertible_to<ModuleEventMask>; }) {
+            return T::HANDLED_EVENTS;
+        } else {
+            ModuleEventMask mask = 0;
+
+#define GLOBED_HANDLES(event, method) \
+            if constexpr (!std::is_same_v<decltype(&T::method), decltype(&BaseGameplayModule::method)>) { \
+                mask |= moduleEventBit(ModuleEvent::event); \
+            }
+
+            GLOBED_HANDLES(PlayerJoin, onPlayerJoin);
+            GLOBED_HANDLES(PlayerLeave, onPlayerLeave);
+            GLOBED_HANDLES(MainPlayerUpdate, mainPlayerUpdate);
+            GLOBED_HANDLES(OnlinePlayerUpdate, onlinePlayerUpdate);
+            GLOBED_HANDLES(LoadLevelSettingsPre, loadLevelSettingsPre);
+            GLOBED_HANDLES(LoadLevelSettingsPost, loadLevelSettingsPost);
+            GLOBED_HANDLES(CheckCollisions, checkCollisions);
+            GLOBED_HANDLES(FullResetLevel, fullResetLevel);
+            GLOBED_HANDLES(ResetLevel, resetLevel);
+            GLOBED_HANDLES(UpdateCameraPre, updateCameraPre);
+            GLOBED_HANDLES(UpdateCameraPost, updateCameraPost);
+            GLOBED_HANDLES(DestroyPlayerPre, destroyPlayerPre);
+            GLOBED_HANDLES(DestroyPlayerPost, destroyPlayerPost);
+            GLOBED_HANDLES(PlayerDestroyed, playerDestroyed);
+            GLOBED_HANDLES(SelPeriodicalUpdate, selPeriodicalUpdate);
+            GLOBED_HANDLES(SelUpdate, selUpdate);
+            GLOBED_HANDLES(SelUpdateEstimators, selUpdateEstimators);
+            GLOBED_HANDLES(UpdatePlayer, onUpdatePlayer);
+            GLOBED_HANDLES(UnscheduleSelectors, onUnscheduleSelectors);
+            GLOBED_HANDLES(RescheduleSelectors, onRescheduleSelectors);
+
+#undef GLOBED_HANDLES
+
+            return mask;
+        }
+    }
+
 protected:
     GlobedGJBGL* gameLayer;
 
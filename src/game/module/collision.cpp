@@ -36,71 +36,77 @@ static bool shouldCorrectCollision(const CCRect& p1, const CCRect& p2, CCPoint&
 void CollisionModule::checkCollisions(PlayerObject* player, float dt, bool p2) {
     bool isSecond = player == gameLayer->m_player2;
 
-    for (const auto& [_, rp] : gameLayer->m_fields->players) {
-        auto* p1 = static_cast<PlayerObject*>(rp->player1->getPlayerObject());
-        auto* p2 = static_cast<PlayerObject*>(rp->player2->getPlayerObject());
-
-        auto& p1Rect = p1->getObjectRect();
-        auto& p2Rect = p2->getObjectRect();
+    if (gridDirty) {
+        this->rebuildGrid();
+    }
 
-        auto& playerRect = player->getObjectRect();
+    auto& stuck = stuckTo[isSecond];
+    for (auto* vp : stuck) {
+        isSecond ? vp->setP2StickyState(false) : vp->setP1StickyState(false);
+    }
+    stuck.clear();
 
-        CCRect p1CollRect = p1Rect;
-        CCRect p2CollRect = p2Rect;
+    CCRect playerRect = player->getObjectRect();
 
-        constexpr float padding = 2.f;
+    grid.query(playerRect, [&](uint32_t id, const CCRect& rect) {
+        this->collideWith(player, gridPlayers[id], rect, dt, isSecond);
+    });
+}
 
-        // p1CollRect.origin += CCPoint{padding, padding};
-        // p1CollRect.size -= CCSize{padding * 2, padding * 2};
+void CollisionModule::selUpdate(float dt) {
+    gridDirty = true;
+}
 
-        // p2CollRect.origin += CCPoint{padding, padding};
-        // p2CollRect.size -= CCSize{padding * 2, padding * 2};
+void CollisionModule::onPlayerJoin(RemotePlayer* player) {
+    gridDirty = true;
+}
 
-        bool intersectsP1 = playerRect.intersectsRect(p1CollRect);
-        bool intersectsP2 = playerRect.intersectsRect(p2CollRect);
+void CollisionModule::onPlayerLeave(RemotePlayer* player) {
+    gridDirty = true;
 
-        if (isSecond) {
-            rp->player1->setP2StickyState(false);
-            rp->player2->setP2StickyState(false);
-        } else {
-            rp->player1->setP1StickyState(false);
-            rp->player2->setP1StickyState(false);
-        }
+    for (auto& stuck : stuckTo) {
+        std::erase_if(stuck, [&](BaseVisualPlayer* vp) {
+            return vp->getRemotePlayer() == player;
+        });
+    }
+}
 
-        if (intersectsP1) {
-            auto prev = player->getPosition();
-            player->collidedWithObject(dt, p1, p1CollRect, false);
-            auto displacement = player->getPosition() - prev;
+void CollisionModule::rebuildGrid() {
+    grid.clear();
+    gridPlayers.clear();
 
-            // log::debug("p1 intersect, displacement: {}", displacement);
+    for (const auto& [_, rp] : gameLayer->m_fields->players) {
+        for (auto* vp : {rp->player1, rp->player2}) {
+            auto* obj = vp->getPlayerObject();
 
-            bool shouldRevert = shouldCorrectCollision(playerRect, p1Rect, displacement);
+            grid.insert(obj->getObjectRect(), gridPlayers.size());
+            gridPlayers.push_back(vp);
+        }
+    }
 
-            if (shouldRevert) {
-                player->setPosition(player->getPosition() + displacement);
-            }
+    grid.build();
+    gridDirty = false;
+}
 
-            if (std::abs(displacement.y) > 0.001f) {
-                isSecond ? rp->player1->setP2StickyState(true) : rp->player1->setP1StickyState(true);
-            }
-        }
+void CollisionModule::collideWith(PlayerObject* player, BaseVisualPlayer* other, const CCRect& otherRect, float dt, bool isSecond) {
+    // the player may have been pushed by a previous collision in this step
+    if (!player->getObjectRect().intersectsRect(otherRect)) return;
 
-        if (intersectsP2) {
-            auto prev = player->getPosition();
-            player->collidedWithObject(dt, p2, p2CollRect, false);
-            auto displacement = player->getPosition() - prev;
+    auto* obj = other->getPlayerObject();
+    CCRect collRect = otherRect;
 
-            // log::debug("p2 intersect, displacement: {}", displacement);
+    auto prev = player->getPosition();
+    player->collidedWithObject(dt, obj, collRect, false);
+    auto displacement = player->getPosition() - prev;
 
-            bool shouldRevert = shouldCorrectCollision(playerRect, p2Rect, displacement);
+    bool shouldRevert = shouldCorrectCollision(player->getObjectRect(), otherRect, displacement);
 
-            if (shouldRevert) {
-                player->setPosition(player->getPosition() + displacement);
-            }
+    if (shouldRevert) {
+        player->setPosition(player->getPosition() + displacement);
+    }
 
-            if (std::abs(displacement.y) > 0.001f) {
-                isSecond ? rp->player2->setP2StickyState(true) : rp->player2->setP1StickyState(true);
-            }
-        }
+    if (std::abs(displacement.y) > 0.001f) {
+        isSecond ? other->setP2StickyState(true) : other->setP1StickyState(true);
+        stuckTo[isSecond].push_back(other);
     }
 }
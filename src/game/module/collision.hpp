@@ -1,6 +1,9 @@
 #pragma once
 
 #include "base.hpp"
+#include <game/collision_grid.hpp>
+
+class BaseVisualPlayer;
 
 class CollisionModule : public BaseGameplayModule {
 public:
@@ -9,8 +12,23 @@ public:
     void loadLevelSettingsPre() override;
     void loadLevelSettingsPost() override;
     void checkCollisions(PlayerObject* player, float dt, bool p2) override;
+    void selUpdate(float dt) override;
+    void onPlayerJoin(RemotePlayer* player) override;
+    void onPlayerLeave(RemotePlayer* player) override;
 
 private:
     bool lastPlat = false;
     int lastLength = 0;
-};
\ No newline at end of file
+
+    // remote players only move once per frame, so the grid is rebuilt on the first physics step after they do
+    CollisionGrid grid;
+    // grid ids are indices into this, with an entry for both icons of every remote player
+    std::vector<BaseVisualPlayer*> gridPlayers;
+    bool gridDirty = true;
+
+    // icons that the local player 1 and player 2 are currently standing on
+    std::vector<BaseVisualPlayer*> stuckTo[2];
+
+    void rebuildGrid();
+    void collideWith(PlayerObject* player, BaseVisualPlayer* other, const cocos2d::CCRect& otherRect, float dt, bool isSecond);
+};
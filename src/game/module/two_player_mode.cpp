@@ -37,7 +37,7 @@ void TwoPlayerModeModule::mainPlayerUpdate(PlayerObject* player, float dt) {
 }
 
 void TwoPlayerModeModule::updateFromLockedPlayer(PlayerObject* player, bool ignorePos) {
-    ComplexVisualPlayer* cvp = static_cast<ComplexVisualPlayer*>(player->getUserObject(LOCKED_TO_KEY));
+    BaseVisualPlayer* cvp = static_cast<BaseVisualPlayer*>(player->getUserObject(LOCKED_TO_KEY));
     if (!cvp) return;
 
     RemotePlayer* rp = cvp->getRemotePlayer();
@@ -0,0 +1,15 @@
+#include "player_data_receiver.hpp"
+
+void PlayerDataReceiver::ingest(const std::vector<AssociatedPlayerData>& players) {
+    auto& batch = batches.writeBuffer();
+    batch.assign(players.begin(), players.end());
+    batches.publish();
+}
+
+bool PlayerDataReceiver::apply(PlayerInterpolator& interpolator, std::vector<AssociatedPlayerData>& unknown) {
+    size_t count = batches.read([&](const std::vector<AssociatedPlayerData>& batch) {
+        interpolator.updatePlayers(batch, unknown);
+    });
+
+    return count > 0;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "interpolator.hpp"
+
+#include <util/collections.hpp>
+
+// Takes in `LevelDataPacket`s on the network thread and hands their frames over to the main thread, without either
+// thread ever waiting for the other. The main thread feeds them into the interpolator with `apply`.
+class PlayerDataReceiver {
+public:
+    // Network thread only.
+    void ingest(const std::vector<AssociatedPlayerData>& players);
+
+    // Main thread only. Feeds every frame that arrived since the last call into the interpolator, oldest first.
+    // Frames of players that aren't in the interpolator yet are appended to `unknown`, the same player may show up
+    // more than once if more of their frames arrived before they were added. Returns whether any player data arrived.
+    bool apply(PlayerInterpolator& interpolator, std::vector<AssociatedPlayerData>& unknown);
+
+private:
+    util::collections::BatchHandoff<std::vector<AssociatedPlayerData>> batches;
+};
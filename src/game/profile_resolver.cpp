@@ -0,0 +1,67 @@
+#include "profile_resolver.hpp"
+
+#include <data/packets/client/game.hpp>
+#include <net/manager.hpp>
+
+void ProfileResolver::request(int accountId) {
+    if (waiting.contains(accountId)) return;
+
+    // due on the next flush
+    waiting.emplace(accountId, timers.schedule(0, accountId));
+}
+
+void ProfileResolver::cancel(int accountId) {
+    this->resolve(accountId);
+}
+
+bool ProfileResolver::resolve(int accountId) {
+    auto it = waiting.find(accountId);
+    if (it == waiting.end()) return false;
+
+    timers.cancel(it->second);
+    waiting.erase(it);
+
+    return true;
+}
+
+void ProfileResolver::flush(float time) {
+    if (waiting.empty()) return;
+
+    uint64_t now = toTick(time);
+
+    due.clear();
+    timers.advance(now, [&](int accountId) {
+        due.push_back(accountId);
+    });
+
+    if (due.empty()) return;
+
+    auto& nm = NetworkManager::get();
+    uint64_t retryAt = toTick(time + RETRY_INTERVAL);
+
+    if (due.size() > MAX_SINGLE_REQUESTS) {
+        // one response covers everyone, including players that were requested recently
+        nm.send(RequestPlayerProfilesPacket::create(0));
+
+        for (auto& [accountId, timer] : waiting) {
+            if (!timers.reschedule(timer, retryAt)) {
+                timer = timers.schedule(retryAt, accountId);
+            }
+        }
+
+        return;
+    }
+
+    for (int accountId : due) {
+        nm.send(RequestPlayerProfilesPacket::create(accountId));
+        waiting.at(accountId) = timers.schedule(retryAt, accountId);
+    }
+}
+
+size_t ProfileResolver::waitingCount() const {
+    return waiting.size();
+}
+
+uint64_t ProfileResolver::toTick(float time) {
+    return static_cast<uint64_t>(time * 1000.f);
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <util/timer_wheel.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+// Keeps track of the players whose profile (name, icons) we don't know yet.
+// Requests for them are collected and sent in one go by `flush`, and each player is asked for only once
+// unless the server doesn't answer within `RETRY_INTERVAL`.
+class ProfileResolver {
+public:
+    // seconds until a request that got no answer is sent again
+    static constexpr float RETRY_INTERVAL = 5.f;
+    // when more players than this need to be requested, all players on the level are requested with a single packet instead
+    static constexpr size_t MAX_SINGLE_REQUESTS = 3;
+
+    // does nothing if the player is already waiting
+    void request(int accountId);
+    void cancel(int accountId);
+    // returns `true` if the player was waiting for their profile
+    bool resolve(int accountId);
+
+    // sends the requests that are due, `time` is in seconds
+    void flush(float time);
+
+    size_t waitingCount() const;
+
+private:
+    using Timers = util::time::TimerWheel<int>;
+
+    // every waiting player has a timer for when they are due to be requested, ticks are milliseconds
+    Timers timers;
+    std::unordered_map<int, Timers::Id> waiting;
+    std::vector<int> due;
+
+    static uint64_t toTick(float time);
+};
@@ -0,0 +1,189 @@
+#include "send_rate.hpp"
+
+#include <util/math.hpp>
+
+using Decision = SendRateController::Decision;
+
+// anything below this is just float noise
+constexpr static float STATIC_EPSILON = 0.01f;
+
+static bool iconChangedAbruptly(const SpecificIconData& now, const SpecificIconData& last) {
+    return now.didJustJump
+        || now.spiderTeleportData.has_value()
+        || now.iconType != last.iconType
+        || now.isVisible != last.isVisible
+        || now.isUpsideDown != last.isUpsideDown
+        || now.isMini != last.isMini
+        || now.isSideways != last.isSideways;
+}
+
+SendRateController::SendRateController(float baseDelta) : baseDelta(baseDelta) {}
+
+Decision SendRateController::update(const PlayerData& data, const NetworkConditions& conditions) {
+    stats.ticks++;
+    stats.congested = this->isCongested(conditions);
+
+    auto decision = this->decide(data);
+
+    previous = data;
+    previousSent = decision == Decision::Send || decision == Decision::SendBoth;
+
+    return decision;
+}
+
+Decision SendRateController::decide(const PlayerData& data) {
+    auto send = [&] {
+        this->markSent(data);
+        return Decision::Send;
+    };
+
+    // sends the frame before this one as well, if it was skipped
+    auto sendBoth = [&] {
+        if (previousSent) {
+            return send();
+        }
+
+        catchUp = previous;
+        this->markSent(previous);
+        this->markSent(data);
+        return Decision::SendBoth;
+    };
+
+    if (sentFrames == 0) {
+        return send();
+    }
+
+    if (this->isAbrupt(data) || this->predictionError(data).position > TELEPORT_DISTANCE) {
+        stats.abrupt++;
+        burstTicks = BURST_TICKS;
+        return sendBoth();
+    }
+
+    if (stats.congested && (congestionTick++ % 2) == 0) {
+        stats.skipped++;
+        return Decision::Skip;
+    }
+
+    if (burstTicks > 0) {
+        burstTicks--;
+        return send();
+    }
+
+    auto poll = [&] {
+        stats.polled++;
+        return Decision::Poll;
+    };
+
+    auto held = this->heldError(data);
+    if (held.position < STATIC_EPSILON && held.rotation < STATIC_EPSILON) {
+        return data.timestamp - lastSent.timestamp >= STATIC_INTERVAL ? send() : poll();
+    }
+
+    auto predicted = this->predictionError(data);
+    bool predictable = predicted.position <= POSITION_TOLERANCE && predicted.rotation <= ROTATION_TOLERANCE;
+    // if ticks are late (lag, speedhack), the receiving side would also have a longer gap to fill in
+    bool onTime = data.timestamp - lastSent.timestamp <= baseDelta * (MAX_PREDICTED_TICKS + 1.5f);
+
+    if (!predictable) {
+        return sendBoth();
+    }
+
+    if (onTime && predictedTicks < MAX_PREDICTED_TICKS) {
+        predictedTicks++;
+        return poll();
+    }
+
+    return send();
+}
+
+void SendRateController::reset() {
+    sentFrames = 0;
+    previousSent = false;
+    predictedTicks = 0;
+    burstTicks = 0;
+    congestionTick = 0;
+}
+
+const PlayerData& SendRateController::getCatchUpFrame() const {
+    return catchUp;
+}
+
+const SendRateController::Stats& SendRateController::getStats() const {
+    return stats;
+}
+
+bool SendRateController::isAbrupt(const PlayerData& data) const {
+    if (!util::math::equal(data.lastDeathTimestamp, lastSent.lastDeathTimestamp)
+        || data.isDead != lastSent.isDead
+        || data.isPaused != lastSent.isPaused
+        || data.isPracticing != lastSent.isPracticing
+        || data.isDualMode != lastSent.isDualMode
+        || data.isInEditor != lastSent.isInEditor
+        || data.isEditorBuilding != lastSent.isEditorBuilding
+    ) {
+        return true;
+    }
+
+    return iconChangedAbruptly(data.player1, lastSent.player1)
+        || (data.isDualMode && iconChangedAbruptly(data.player2, lastSent.player2));
+}
+
+SendRateController::Error SendRateController::predictionError(const PlayerData& data) const {
+    // with only one frame, the best guess is that nothing moved
+    if (sentFrames < 2) {
+        return this->heldError(data);
+    }
+
+    float span = lastSent.timestamp - prevSent.timestamp;
+    float ratio = span > 0.f ? (data.timestamp - lastSent.timestamp) / span : 0.f;
+
+    auto check = [&](const SpecificIconData& now, const SpecificIconData& last, const SpecificIconData& prev, Error& err) {
+        auto predictedPos = last.position + (last.position - prev.position) * ratio;
+        float predictedRot = last.rotation + (last.rotation - prev.rotation) * ratio;
+
+        err.position = std::max(err.position, now.position.getDistance(predictedPos));
+        err.rotation = std::max(err.rotation, std::abs(now.rotation - predictedRot));
+    };
+
+    Error err;
+    check(data.player1, lastSent.player1, prevSent.player1, err);
+    if (data.isDualMode) {
+        check(data.player2, lastSent.player2, prevSent.player2, err);
+    }
+
+    return err;
+}
+
+SendRateController::Error SendRateController::heldError(const PlayerData& data) const {
+    Error err;
+    err.position = data.player1.position.getDistance(lastSent.player1.position);
+    err.rotation = std::abs(data.player1.rotation - lastSent.player1.rotation);
+
+    if (data.isDualMode) {
+        err.position = std::max(err.position, data.player2.position.getDistance(lastSent.player2.position));
+        err.rotation = std::max(err.rotation, std::abs(data.player2.rotation - lastSent.player2.rotation));
+    }
+
+    return err;
+}
+
+bool SendRateController::isCongested(const NetworkConditions& conditions) {
+    if (!conditions.valid) return false;
+
+    float inflation = conditions.rtt - conditions.minRtt;
+
+    // leaving the congested state needs the connection to recover by half, so that it doesn't flip back and forth
+    float scale = stats.congested ? 0.5f : 1.f;
+
+    return inflation > CONGESTION_RTT_INFLATION * scale
+        || conditions.jitter > CONGESTION_JITTER * scale
+        || conditions.loss > CONGESTION_LOSS * scale;
+}
+
+void SendRateController::markSent(const PlayerData& data) {
+    prevSent = lastSent;
+    lastSent = data;
+    sentFrames++;
+    predictedTicks = 0;
+    stats.sent++;
+}
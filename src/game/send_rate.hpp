@@ -0,0 +1,87 @@
+#pragma once
+
+#include <data/types/game.hpp>
+#include <net/clock_sync.hpp>
+
+// Decides, every send tick, whether our player data is worth sending.
+// Frames that the other players can reconstruct on their own (nothing moved, or the movement continues in a straight line)
+// are replaced by a `RequestLevelDataPacket`, so that we still receive everyone else's data at the full rate.
+// Abrupt changes (deaths, jumps, teleports, gamemode changes) are always sent right away, and when the connection
+// looks congested, every other tick is skipped entirely.
+class SendRateController {
+public:
+    enum class Decision : uint8_t {
+        Send,       // send the full player data
+        SendBoth,   // send `getCatchUpFrame()` and then the current player data
+        Poll,       // only ask for the level data
+        Skip,       // send nothing
+    };
+
+    struct Stats {
+        size_t ticks = 0;
+        size_t sent = 0;
+        size_t polled = 0;
+        size_t skipped = 0;
+        size_t abrupt = 0;      // sends caused by a sudden change in state
+        bool congested = false;
+    };
+
+    // `baseDelta` is the time between two calls to `update`
+    SendRateController(float baseDelta);
+
+    Decision update(const PlayerData& data, const NetworkConditions& conditions);
+
+    // forget the previously sent frames, the next update will always send
+    void reset();
+
+    // after `update` returns `SendBoth`, the skipped frame that has to be sent first
+    const PlayerData& getCatchUpFrame() const;
+
+    const Stats& getStats() const;
+
+private:
+    // how far (in units) the predicted position may be from the real one
+    static constexpr float POSITION_TOLERANCE = 1.5f;
+    static constexpr float ROTATION_TOLERANCE = 4.f;
+    // errors larger than this are treated as a teleport rather than a change in direction
+    static constexpr float TELEPORT_DISTANCE = 90.f;
+    // a player that stands still is still sent this often
+    static constexpr float STATIC_INTERVAL = 0.5f;
+    // predictable movement can skip at most this many ticks in a row, as remote players have to buffer that far behind
+    static constexpr int MAX_PREDICTED_TICKS = 1;
+    // ticks sent after an abrupt change, so that the next prediction is based on frames after it
+    static constexpr int BURST_TICKS = 1;
+    // the connection counts as congested when the rtt rises this much above the lowest recent one, the jitter gets this high,
+    // or this many datagrams get lost
+    static constexpr float CONGESTION_RTT_INFLATION = 0.1f;
+    static constexpr float CONGESTION_JITTER = 0.04f;
+    static constexpr float CONGESTION_LOSS = 0.05f;
+
+    float baseDelta;
+
+    PlayerData lastSent{}, prevSent{};
+    // when the player starts moving again or something abrupt happens, remote players would otherwise lerp
+    // between the last sent frame (possibly a while ago) and the new one, so the frame right before gets sent too
+    PlayerData previous{}, catchUp{};
+    bool previousSent = false;
+    size_t sentFrames = 0;
+    int predictedTicks = 0;
+    int burstTicks = 0;
+    size_t congestionTick = 0;
+
+    Stats stats;
+
+    struct Error {
+        float position = 0.f;
+        float rotation = 0.f;
+    };
+
+    Decision decide(const PlayerData& data);
+    bool isAbrupt(const PlayerData& data) const;
+    // largest difference between the real state and the one extrapolated from the last two sent frames
+    Error predictionError(const PlayerData& data) const;
+    // largest difference between the real state and the last sent one
+    Error heldError(const PlayerData& data) const;
+    bool isCongested(const NetworkConditions& conditions);
+    void markSent(const PlayerData& data);
+};
@@ -0,0 +1,236 @@
+#include "send_rate_suite.hpp"
+
+#include "interpolation_suite.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace geode::prelude;
+
+namespace {
+    constexpr float DURATION = 20.f;
+    constexpr float RENDER_DELTA = 1.f / 240.f;
+    constexpr float LATENCY = 0.05f;
+    constexpr float SPEED = 311.58f;
+    constexpr float GROUND = 105.f;
+
+    struct Network {
+        const char* name;
+        NetworkConditions conditions;
+    };
+
+    const Network NETWORKS[] = {
+        {"stable", NetworkConditions { .valid = true, .rtt = 0.05f, .minRtt = 0.05f, .jitter = 0.002f }},
+        {"congested", NetworkConditions { .valid = true, .rtt = 0.25f, .minRtt = 0.05f, .jitter = 0.05f }},
+        {"lossy", NetworkConditions { .valid = true, .rtt = 0.05f, .minRtt = 0.05f, .jitter = 0.002f, .loss = 0.08f }},
+    };
+
+    template <typename F>
+    SendRateSuite::Trace generate(const char* name, F&& frameAt) {
+        SendRateSuite::Trace trace{name, {}};
+        for (float t = 0.f; t < DURATION; t += SendRateSuite::SEND_DELTA) {
+            trace.frames.push_back(frameAt(t));
+        }
+
+        return trace;
+    }
+
+    // position of the player at `t`, lerped between the two closest frames of the trace
+    CCPoint traceAt(const std::vector<PlayerData>& trace, float t) {
+        auto it = std::lower_bound(trace.begin(), trace.end(), t, [](const PlayerData& frame, float t) {
+            return frame.timestamp < t;
+        });
+
+        if (it == trace.begin()) return trace.front().player1.position;
+        if (it == trace.end()) return trace.back().player1.position;
+
+        auto& to = *it;
+        auto& from = *(it - 1);
+        float ratio = (t - from.timestamp) / std::max(to.timestamp - from.timestamp, 0.0001f);
+
+        return from.player1.position + (to.player1.position - from.player1.position) * ratio;
+    }
+
+    // sends what `pickFrames` picks to an interpolator, and measures how far the displayed player is from the trace.
+    // `pickFrames(frame, send, poll)` is called for every frame of the trace
+    template <typename F>
+    SendRateSuite::Replay replay(const std::vector<PlayerData>& trace, F&& pickFrames) {
+        std::vector<std::pair<float, PlayerData>> packets;
+        size_t datagrams = 0, bytes = 0;
+
+        for (const auto& frame : trace) {
+            auto send = [&](const PlayerData& sent) {
+                packets.emplace_back(frame.timestamp + LATENCY, sent);
+                datagrams++;
+                bytes += SendRateSuite::playerDataSize(sent);
+            };
+
+            auto poll = [&] {
+                datagrams++;
+                bytes += SendRateSuite::POLL_SIZE;
+            };
+
+            pickFrames(frame, send, poll);
+        }
+
+        PlayerInterpolator interpolator(InterpolatorSettings {
+            .realtime = false,
+            .isPlatformer = false,
+            .expectedDelta = SendRateSuite::SEND_DELTA,
+        });
+        interpolator.addPlayer(1);
+
+        size_t ticks = 0;
+        double errorSquared = 0.0;
+        float maxError = 0.f;
+
+        float start = trace.front().timestamp;
+        float end = trace.back().timestamp + LATENCY;
+        size_t nextPacket = 0;
+
+        for (float now = start; now < end; now += RENDER_DELTA) {
+            while (nextPacket < packets.size() && packets[nextPacket].first <= now) {
+                interpolator.updatePlayer(1, packets[nextPacket].second);
+                nextPacket++;
+            }
+
+            interpolator.tick(RENDER_DELTA);
+
+            if (nextPacket == 0) continue;
+
+            auto pos = interpolator.getPlayerState(1).player1.position;
+            float error = pos.getDistance(traceAt(trace, interpolator.getPlayerStats(1).playoutTime));
+
+            errorSquared += static_cast<double>(error) * error;
+            maxError = std::max(maxError, error);
+            ticks++;
+        }
+
+        double seconds = static_cast<double>(trace.size()) * SendRateSuite::SEND_DELTA;
+
+        return SendRateSuite::Replay {
+            .datagrams = datagrams,
+            .bytes = bytes,
+            .datagramsPerSecond = static_cast<double>(datagrams) / seconds,
+            .bytesPerSecond = static_cast<double>(bytes) / seconds,
+            .rmsError = static_cast<float>(std::sqrt(errorSquared / std::max<size_t>(ticks, 1))),
+            .maxError = maxError,
+        };
+    }
+}
+
+size_t SendRateSuite::playerDataSize(const PlayerData& data) {
+    // position, rotation, icon type, flags and whether there is a spider teleport, then the teleport itself
+    auto iconSize = [](const SpecificIconData& icon) -> size_t {
+        return 8 + 4 + 1 + 2 + 1 + (icon.spiderTeleportData ? 16 : 0);
+    };
+
+    // timestamp, both icons, death timestamp, percentage, flags, and the metadata flag of the packet
+    return DATAGRAM_OVERHEAD + 4 + iconSize(data.player1) + iconSize(data.player2) + 4 + 4 + 1 + 1;
+}
+
+std::vector<SendRateSuite::Trace> SendRateSuite::syntheticTraces() {
+    std::vector<Trace> traces;
+
+    // jumps every 1.2 seconds, spinning half a turn in the air
+    traces.push_back(generate("cube with jumps", [](float t) {
+        float jumps = std::floor(t / 1.2f);
+        float phase = std::fmod(t, 1.2f) / 0.4f;
+
+        float y = GROUND;
+        float rotation = 180.f * (jumps + 1.f);
+        if (phase < 1.f) {
+            y += 240.f * phase * (1.f - phase);
+            rotation = 180.f * (jumps + phase);
+        }
+
+        auto data = InterpolationSuite::traceFrame(t, {SPEED * t, y}, rotation);
+        data.player1.didJustJump = phase < 1.f && phase * 0.4f < SEND_DELTA;
+        data.player1.isGrounded = phase >= 1.f;
+        return data;
+    }));
+
+    traces.push_back(generate("ship", [](float t) {
+        float dy = 160.f * std::cos(2.f * t);
+        float rotation = -std::atan2(dy, SPEED) * 180.f / 3.14159265f;
+        return InterpolationSuite::traceFrame(t, {SPEED * t, 200.f + 80.f * std::sin(2.f * t)}, rotation, PlayerIconType::Ship);
+    }));
+
+    // changes direction every 0.35 seconds
+    traces.push_back(generate("wave", [](float t) {
+        float segment = std::floor(t / 0.35f);
+        float phase = std::fmod(t, 0.35f);
+        bool up = static_cast<int>(segment) % 2 == 0;
+
+        float y = 200.f + (up ? phase : 0.35f - phase) * SPEED - 0.175f * SPEED;
+        return InterpolationSuite::traceFrame(t, {SPEED * t, y}, up ? -45.f : 45.f, PlayerIconType::Wave);
+    }));
+
+    // walks for 2 seconds, then stands around for 3
+    traces.push_back(generate("platformer, walking and idling", [](float t) {
+        float cycles = std::floor(t / 5.f);
+        float phase = std::fmod(t, 5.f);
+
+        float x = cycles * 400.f + std::min(phase, 2.f) * 200.f;
+        auto data = InterpolationSuite::traceFrame(t, {x, GROUND}, 0.f);
+        data.player1.isStationary = phase >= 2.f;
+        data.player1.isGrounded = true;
+        return data;
+    }));
+
+    traces.push_back(generate("paused", [](float t) {
+        auto data = InterpolationSuite::traceFrame(t, {SPEED * std::min(t, 1.f), GROUND}, 0.f);
+        data.isPaused = t >= 1.f;
+        return data;
+    }));
+
+    // dies every 4 seconds, stays dead for half a second and then respawns at the start
+    traces.push_back(generate("cube with deaths", [](float t) {
+        float attempt = std::floor(t / 4.f);
+        float phase = std::fmod(t, 4.f);
+
+        auto data = InterpolationSuite::traceFrame(t, {SPEED * std::min(phase, 3.5f), GROUND}, 0.f);
+        data.isDead = phase >= 3.5f;
+
+        float lastAttempt = data.isDead ? attempt : attempt - 1.f;
+        data.lastDeathTimestamp = lastAttempt >= 0.f ? lastAttempt * 4.f + 3.5f : 0.f;
+        return data;
+    }));
+
+    return traces;
+}
+
+std::vector<SendRateSuite::Result> SendRateSuite::measure(const std::vector<Trace>& traces) {
+    std::vector<Result> results;
+
+    for (const auto& trace : traces) {
+        if (trace.frames.size() < 2) continue;
+
+        auto always = replay(trace.frames, [](const PlayerData& frame, auto&& send, auto&&) { send(frame); });
+
+        for (const auto& network : NETWORKS) {
+            SendRateController controller(SEND_DELTA);
+
+            // the same as `GlobedGJBGL::selSendPlayerData`
+            auto adaptive = replay(trace.frames, [&](const PlayerData& frame, auto&& send, auto&& poll) {
+                switch (controller.update(frame, network.conditions)) {
+                    case SendRateController::Decision::SendBoth: send(controller.getCatchUpFrame()); [[fallthrough]];
+                    case SendRateController::Decision::Send: send(frame); break;
+                    case SendRateController::Decision::Poll: poll(); break;
+                    case SendRateController::Decision::Skip: break;
+                }
+            });
+
+            results.push_back(Result {
+                .trace = trace.name,
+                .network = network.name,
+                .frames = trace.frames.size(),
+                .stats = controller.getStats(),
+                .adaptive = adaptive,
+                .always = always,
+            });
+        }
+    }
+
+    return results;
+}
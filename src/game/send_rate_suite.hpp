@@ -0,0 +1,52 @@
+#pragma once
+
+#include "send_rate.hpp"
+
+#include <string>
+#include <vector>
+
+// Replays player data traces through `SendRateController` over a few network conditions, delivers whatever it picks
+// to a `PlayerInterpolator` and compares the displayed player with the trace, against sending every frame.
+// Like `InterpolationSuite`, it only depends on the interpolator and the controller, so it runs both from the in-mod
+// benchmarks (which add the recorded traces) and from the standalone test project.
+class SendRateSuite {
+public:
+    struct Trace {
+        std::string name;
+        std::vector<PlayerData> frames; // sampled at `SEND_DELTA`
+    };
+
+    struct Replay {
+        size_t datagrams;           // everything that goes out, polls included
+        size_t bytes;               // on the wire, with the ip and udp headers
+        double datagramsPerSecond;
+        double bytesPerSecond;
+        float rmsError;             // distance between the displayed and the real position at the playout time, in units
+        float maxError;
+    };
+
+    struct Result {
+        std::string trace;
+        const char* network;
+        size_t frames;
+        SendRateController::Stats stats;
+        Replay adaptive;
+        Replay always;              // sending every frame, like without the controller
+    };
+
+    static constexpr float SEND_DELTA = 1.f / 30.f;
+
+    // udp datagram sizes, see `GameSocket::encodePacket` and the encoders in data/types/game.cpp.
+    // every datagram has the sequence number, packet id and encrypted flag, and 28 bytes of ipv4 and udp headers
+    static constexpr size_t DATAGRAM_OVERHEAD = 28 + 4 + 2 + 1;
+    static constexpr size_t POLL_SIZE = DATAGRAM_OVERHEAD;
+
+    // size of a `PlayerDataPacket` without metadata
+    static size_t playerDataSize(const PlayerData& data);
+
+    // cube with jumps, ship, wave, a platformer that idles, pausing, and dying
+    static std::vector<Trace> syntheticTraces();
+
+    // every trace over every network
+    static std::vector<Result> measure(const std::vector<Trace>& traces);
+};
@@ -0,0 +1,127 @@
+#include "visibility.hpp"
+
+using namespace geode::prelude;
+
+void VisibilityIndex::addPlayer(int playerId) {
+    entries.push_back(Entry {
+        .playerId = playerId,
+        .tier = VisibilityTier::Far,
+    });
+}
+
+void VisibilityIndex::removePlayer(int playerId) {
+    std::erase_if(entries, [&](const Entry& entry) {
+        return entry.playerId == playerId;
+    });
+}
+
+void VisibilityIndex::setBounds(size_t index, CCPoint first, std::optional<CCPoint> second) {
+    auto& entry = entries[index];
+    entry.minX = entry.maxX = first.x;
+    entry.minY = entry.maxY = first.y;
+
+    if (second) {
+        entry.minX = std::min(entry.minX, second->x);
+        entry.maxX = std::max(entry.maxX, second->x);
+        entry.minY = std::min(entry.minY, second->y);
+        entry.maxY = std::max(entry.maxY, second->y);
+    }
+
+    maxWidth = std::max(maxWidth, entry.maxX - entry.minX);
+}
+
+void VisibilityIndex::classify(const GameCameraState& camState, bool everythingVisible) {
+    frame++;
+
+    // insertion sort, the order from the last frame is almost always still correct
+    for (size_t i = 1; i < entries.size(); i++) {
+        if (entries[i - 1].minX <= entries[i].minX) continue;
+
+        auto entry = entries[i];
+        size_t j = i;
+        while (j > 0 && entries[j - 1].minX > entry.minX) {
+            entries[j] = entries[j - 1];
+            j--;
+        }
+
+        entries[j] = entry;
+    }
+
+    stats = {};
+
+    float width = maxWidth;
+    maxWidth = 0.f;
+
+    if (everythingVisible) {
+        for (auto& entry : entries) {
+            entry.tier = VisibilityTier::Visible;
+        }
+
+        stats.visible = stats.fullUpdates = entries.size();
+        return;
+    }
+
+    CCSize coverage = camState.cameraCoverage();
+    CCPoint origin = camState.cameraOrigin;
+
+    auto intersects = [](const Entry& entry, float left, float bottom, float right, float top) {
+        return entry.minX <= right && entry.maxX >= left && entry.minY <= top && entry.maxY >= bottom;
+    };
+
+    // one screen in every direction, 3x3 screens in total
+    float nearLeft = origin.x - coverage.width;
+    float nearRight = origin.x + coverage.width * 2.f;
+    float nearBottom = origin.y - coverage.height;
+    float nearTop = origin.y + coverage.height * 2.f;
+
+    auto first = std::lower_bound(entries.begin(), entries.end(), nearLeft - width, [](const Entry& entry, float x) {
+        return entry.minX < x;
+    });
+
+    auto last = std::upper_bound(first, entries.end(), nearRight, [](float x, const Entry& entry) {
+        return x < entry.minX;
+    });
+
+    auto markFar = [&](Entry& entry) {
+        entry.tier = VisibilityTier::Far;
+        stats.far++;
+
+        if (this->isFarUpdateDue(entry)) {
+            stats.farUpdates++;
+        }
+    };
+
+    for (auto it = entries.begin(); it != first; ++it) {
+        markFar(*it);
+    }
+
+    for (auto it = last; it != entries.end(); ++it) {
+        markFar(*it);
+    }
+
+    for (auto it = first; it != last; ++it) {
+        if (intersects(*it, origin.x - VISIBLE_MARGIN, origin.y - VISIBLE_MARGIN, origin.x + coverage.width + VISIBLE_MARGIN, origin.y + coverage.height + VISIBLE_MARGIN)) {
+            it->tier = VisibilityTier::Visible;
+            stats.visible++;
+        } else if (intersects(*it, nearLeft, nearBottom, nearRight, nearTop)) {
+            it->tier = VisibilityTier::Near;
+            stats.near++;
+        } else {
+            markFar(*it);
+        }
+    }
+
+    stats.fullUpdates = stats.visible + stats.near;
+}
+
+std::vector<VisibilityIndex::Entry>& VisibilityIndex::getEntries() {
+    return entries;
+}
+
+const VisibilityIndex::Stats& VisibilityIndex::getStats() const {
+    return stats;
+}
+
+bool VisibilityIndex::isFarUpdateDue(const Entry& entry) const {
+    return (frame + static_cast<uint32_t>(entry.playerId)) % FAR_UPDATE_INTERVAL == 0;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <defs/geode.hpp>
+#include "camera_state.hpp"
+
+#include <optional>
+#include <vector>
+
+enum class VisibilityTier : uint8_t {
+    Visible,    // on screen, gets a full update every frame
+    Near,       // within a screen of the camera, gets a full update but skips things like labels that only matter on screen
+    Far,        // only has its position kept up to date, every few frames
+};
+
+// Classifies remote players by their distance to the camera, once per frame.
+// Players are kept sorted by their left edge, so only the ones within the horizontal band around the camera are checked,
+// and since they barely move between frames, the insertion sort that keeps them in order is close to linear.
+class VisibilityIndex {
+public:
+    struct Entry {
+        int playerId;
+        float minX, minY, maxX, maxY;
+        VisibilityTier tier;
+    };
+
+    struct Stats {
+        size_t visible = 0;
+        size_t near = 0;
+        size_t far = 0;
+        size_t fullUpdates = 0;
+        size_t farUpdates = 0;
+    };
+
+    // far players are updated once every this many frames, staggered by their id
+    static constexpr uint32_t FAR_UPDATE_INTERVAL = 4;
+    // how far outside the screen a player still counts as visible, so that their name label doesn't pop in
+    static constexpr float VISIBLE_MARGIN = 60.f;
+
+    void addPlayer(int playerId);
+    void removePlayer(int playerId);
+
+    // must be called for every player before `classify`, `second` is only given for dual mode
+    void setBounds(size_t index, cocos2d::CCPoint first, std::optional<cocos2d::CCPoint> second);
+
+    // sorts the players and sets their tiers, everything is `Visible` if `everythingVisible` is set (in the editor)
+    void classify(const GameCameraState& camState, bool everythingVisible);
+
+    std::vector<Entry>& getEntries();
+
+    // counters from the last `classify`
+    const Stats& getStats() const;
+
+    // whether a far player should get its position updated this frame
+    bool isFarUpdateDue(const Entry& entry) const;
+
+private:
+    std::vector<Entry> entries;
+    // widest entry, as entries are sorted by their left edge, anything starting this far left of the band can still reach into it
+    float maxWidth = 0.f;
+    uint32_t frame = 0;
+    Stats stats;
+};
@@ -19,6 +19,7 @@
 #include <data/packets/all.hpp>
 #include <game/module/all.hpp>
 #include <game/camera_state.hpp>
+#include <game/lerp_logger.hpp>
 #include <hooks/game_manager.hpp>
 #include <util/math.hpp>
 #include <util/debug.hpp>
@@ -26,6 +27,10 @@
 #include <util/format.hpp>
 #include <util/lowlevel.hpp>
 
+#ifdef GLOBED_RECORD_SEND_TRACES
+# include <fstream>
+#endif
+
 using namespace geode::prelude;
 
 // how many units before the voice disappears
@@ -40,6 +45,12 @@ constexpr float VOICE_OVERLAY_PAD_Y = 20.f;
         module->code; \
     }
 
+// post an event to the modules that handle it
+#define GLOBED_EVENT_S(self, event, code) \
+    for (auto* module : self->m_fields->moduleSubscribers[static_cast<size_t>(ModuleEvent::event)]) { \
+        module->code; \
+    }
+
 
 bool GlobedGJBGL::init() {
     if (!GJBaseGameLayer::init()) return false;
@@ -101,6 +112,9 @@ void GlobedGJBGL::setupPreInit(GJGameLevel* level, bool editor) {
 
         auto& rs = m_fields->roomSettings.flags;
 
+        // collision and 2 player mode work with the `PlayerObject`s of remote players
+        bool needsPlayerObjects = false;
+
         // Collision
         if (rs.collision) {
             bool shouldEnableCollision = true;
@@ -120,12 +134,14 @@ void GlobedGJBGL::setupPreInit(GJGameLevel* level, bool editor) {
 
             if (shouldEnableCollision) {
                 this->addModule<CollisionModule>();
+                needsPlayerObjects = true;
             }
         }
 
         // 2 player mode
         if (rs.twoPlayerMode && !editor) {
             this->addModule<TwoPlayerModeModule>();
+            needsPlayerObjects = true;
         }
 
         // Deathlink
@@ -133,6 +149,8 @@ void GlobedGJBGL::setupPreInit(GJGameLevel* level, bool editor) {
             this->addModule<DeathlinkModule>();
         }
 
+        m_fields->playerPool.setLightweight(settings.players.lightweightPlayers && !needsPlayerObjects);
+
         GLOBED_EVENT(this, setupPreInit(level));
     }
 }
@@ -239,7 +257,14 @@ void GlobedGJBGL::setupAudio() {
         }
 
         // set the record buffer size
-        vm.setRecordBufferCapacity(settings.communication.lowerAudioLatency ? EncodedAudioFrame::LIMIT_LOW_LATENCY : EncodedAudioFrame::LIMIT_REGULAR);
+        if (settings.communication.lowLatencyVoice) {
+            // every opus frame is sent on its own as soon as it's encoded
+            vm.setRecordFrameSize(VOICE_STREAMING_FRAMESIZE);
+            vm.setRecordBufferCapacity(1);
+        } else {
+            vm.setRecordFrameSize(VOICE_TARGET_FRAMESIZE);
+            vm.setRecordBufferCapacity(settings.communication.lowerAudioLatency ? EncodedAudioFrame::LIMIT_LOW_LATENCY : EncodedAudioFrame::LIMIT_REGULAR);
+        }
 
         // start passive voice recording
         auto& vrm = VoiceRecordingManager::get();
@@ -270,26 +295,27 @@ void GlobedGJBGL::setupAudio() {
 void GlobedGJBGL::setupPacketListeners() {
     auto& nm = NetworkManager::get();
 
-    nm.addListener<PlayerProfilesPacket>(this, [](std::shared_ptr<PlayerProfilesPacket> packet) {
+    nm.addListener<PlayerProfilesPacket>(this, [this](std::shared_ptr<PlayerProfilesPacket> packet) {
         auto& pcm = ProfileCacheManager::get();
         for (auto& player : packet->players) {
-            pcm.insert(player);
-        }
-    });
+            bool changed = pcm.insert(player);
+            bool wasWaiting = m_fields->profiles.resolve(player.accountId);
 
-    nm.addListener<LevelDataPacket>(this, [this](std::shared_ptr<LevelDataPacket> packet){
-        this->m_fields->lastServerUpdate = this->m_fields->timeCounter;
+            if (!changed && !wasWaiting) continue;
 
-        for (const auto& player : packet->players) {
-            if (!this->m_fields->players.contains(player.accountId)) {
-                // new player joined
-                this->handlePlayerJoin(player.accountId);
+            auto it = m_fields->players.find(player.accountId);
+            if (it != m_fields->players.end()) {
+                it->second->updateAccountData(player);
             }
-
-            this->m_fields->interpolator->updatePlayer(player.accountId, player.data, this->m_fields->lastServerUpdate);
         }
     });
 
+    // player data is copied out on the network thread and fed into the interpolator in selUpdate
+    m_fields->receiver = std::make_shared<PlayerDataReceiver>();
+    nm.addThreadListener<LevelDataPacket>([receiver = m_fields->receiver](std::shared_ptr<LevelDataPacket> packet) {
+        receiver->ingest(packet->players);
+    });
+
     nm.addListener<LevelPlayerMetadataPacket>(this, [this](std::shared_ptr<LevelPlayerMetadataPacket> packet) {
         for (const auto& player : packet->players) {
             this->m_fields->playerStore->insertOrUpdate(player.accountId, player.data.attempts, player.data.localBest);
@@ -316,11 +342,30 @@ void GlobedGJBGL::setupPacketListeners() {
 
             vpm.setVolume(packet->sender, settings.communication.voiceVolume);
             this->updateProximityVolume(packet->sender);
-            auto result = vpm.playFrameStreamed(packet->sender, packet->frame);
 
-            if (result.isErr()) {
-                ErrorQueues::get().debugWarn(std::string("Failed to play a voice frame: ") + result.unwrapErr());
-            }
+            // decoding happens on a voice worker thread, the packet is kept alive until it's done
+            vpm.playFrameStreamed(packet->sender, std::shared_ptr<const EncodedAudioFrame>(packet, &packet->frame));
+        } catch(const std::exception& e) {
+            ErrorQueues::get().debugWarn(std::string("Failed to play a voice frame: ") + e.what());
+        }
+#endif // GLOBED_VOICE_SUPPORT
+    });
+
+    nm.addListener<VoiceStreamBroadcastPacket>(this, [this](std::shared_ptr<VoiceStreamBroadcastPacket> packet) {
+#ifdef GLOBED_VOICE_SUPPORT
+        auto& settings = GlobedSettings::get();
+
+        if (this->m_fields->deafened || !settings.communication.voiceEnabled) return;
+        if (!this->shouldLetMessageThrough(packet->sender)) return;
+
+        auto& vpm = VoicePlaybackManager::get();
+        try {
+            vpm.prepareStream(packet->sender);
+
+            vpm.setVolume(packet->sender, settings.communication.voiceVolume);
+            this->updateProximityVolume(packet->sender);
+
+            vpm.playSequencedFrame(packet->sender, packet->sequence, std::shared_ptr<const EncodedOpusData>(packet, &packet->frame));
         } catch(const std::exception& e) {
             ErrorQueues::get().debugWarn(std::string("Failed to play a voice frame: ") + e.what());
         }
@@ -417,13 +462,19 @@ void GlobedGJBGL::setupMisc() {
         m_fields->configuredTps = nm.getServerTps();
     }
 
-    // interpolator
+    // interpolator, the players from the last level don't need to be kept around anymore
+    LerpLogger::get().clearInactiveRings();
     m_fields->interpolator = std::make_unique<PlayerInterpolator>(InterpolatorSettings {
         .realtime = false,
         .isPlatformer = m_level->isPlatformer(),
-        .expectedDelta = (1.0f / m_fields->configuredTps)
+        .expectedDelta = (1.0f / m_fields->configuredTps),
+        .extrapolation = settings.players.extrapolation,
     });
 
+    if (settings.globed.adaptiveSendRate) {
+        m_fields->sendRate = std::make_unique<SendRateController>(1.0f / m_fields->configuredTps);
+    }
+
     // player store
     m_fields->playerStore = std::make_unique<PlayerStore>();
 
@@ -554,13 +605,32 @@ void GlobedGJBGL::selSendPlayerData(float) {
     // or if we are quitting the level
     if ((self->m_fields->players.empty() && self->m_fields->totalSentPackets % 30 != 15) || self->m_fields->quitting) return;
 
+    auto& nm = NetworkManager::get();
     auto data = self->gatherPlayerData();
+
+#ifdef GLOBED_RECORD_SEND_TRACES
+    self->m_fields->sendTrace.push_back(data);
+#endif
+
+    // with nobody else on the level, the controller would only delay the first update that the next player to join sees
+    auto& sendRate = self->m_fields->sendRate;
+    if (sendRate && !self->m_fields->players.empty() && !self->m_fields->shouldRequestMeta) {
+        switch (sendRate->update(data, nm.getNetworkConditions())) {
+            case SendRateController::Decision::Send: break;
+            case SendRateController::Decision::SendBoth: nm.send(PlayerDataPacket::create(sendRate->getCatchUpFrame(), std::nullopt)); break;
+            case SendRateController::Decision::Poll: nm.send(RequestLevelDataPacket::create()); return;
+            case SendRateController::Decision::Skip: return;
+        }
+    } else if (sendRate) {
+        sendRate->reset();
+    }
+
     std::optional<PlayerMetadata> meta;
     if (util::misc::swapFlag(m_fields->shouldRequestMeta)) {
         meta = self->gatherPlayerMetadata();
     }
 
-    NetworkManager::get().send(PlayerDataPacket::create(data, meta));
+    nm.send(PlayerDataPacket::create(data, meta));
 }
 
 // selSendPlayerMetadata - runs every 10 seconds
@@ -584,74 +654,52 @@ void GlobedGJBGL::selPeriodicalUpdate(float dt) {
     // update the overlay
     self->m_fields->overlay->updatePing(GameServerManager::get().getActivePing());
 
-    auto& pcm = ProfileCacheManager::get();
-
     util::collections::SmallVector<int, 32> toRemove;
 
-    // if more than a second passed and there was only 1 player, they probably left
-    if (self->m_fields->timeCounter - self->m_fields->lastServerUpdate > 1.0f && self->m_fields->players.size() < 2) {
-        for (const auto& [playerId, _] : self->m_fields->players) {
-            toRemove.push_back(playerId);
-        }
+    // on a jittery connection level data arrives less regularly, give it more time before deciding that a player left
+    float staleThreshold = 0.5f;
+    auto conditions = NetworkManager::get().getNetworkConditions();
+    if (conditions.valid) {
+        staleThreshold += std::min(conditions.jitter * 4.f, 1.5f);
+    }
 
-        for (int id : toRemove) {
-            self->handlePlayerLeave(id);
+    // kick players that have left the level, only the ones whose timer ran out are looked at.
+    // this includes players whose node was never created.
+    float now = self->m_fields->timeCounter;
+    self->m_fields->staleTimers.advance(static_cast<uint64_t>(now * 1000.f), [&](int playerId) {
+        // if the player doesnt exist in last LevelData packet, they have left the level
+        if (self->m_fields->interpolator->isPlayerStale(playerId, self->m_fields->lastServerUpdate, staleThreshold)) {
+            self->m_fields->staleTimerIds.erase(playerId);
+            toRemove.push_back(playerId);
+            return;
         }
-    } else {
-        util::collections::SmallVector<int, 256> ids;
-
-        // kick players that have left the level
-        for (const auto& [playerId, remotePlayer] : self->m_fields->players) {
-            // if the player doesnt exist in last LevelData packet, they have left the level
-            if (self->m_fields->interpolator->isPlayerStale(playerId, self->m_fields->lastServerUpdate)) {
-                toRemove.push_back(playerId);
-                continue;
-            }
 
-            auto data = pcm.getData(playerId);
-
-            if (!remotePlayer->isValidPlayer()) {
-                if (data.has_value()) {
-                    // if the profile data already exists in cache, use it
-                    remotePlayer->updateAccountData(data.value(), true);
-                    continue;
-                }
-
-                // request again if it has either been 5 seconds, or if the player just joined
-                if (remotePlayer->getDefaultTicks() == 20) {
-                    remotePlayer->setDefaultTicks(0);
-                }
-
-                if (remotePlayer->getDefaultTicks() == 0) {
-                    ids.push_back(playerId);
-                }
-
-                remotePlayer->incDefaultTicks();
-            } else if (data.has_value()) {
-                // still try to see if the cache has changed
-                remotePlayer->updateAccountData(data.value());
-            }
-        }
+        // they got updated since the timer was scheduled, check again once that update is old enough.
+        // the next periodic update is the earliest that can happen, if no level data is coming in at all
+        float updatedAt = self->m_fields->interpolator->getLastUpdate(playerId);
+        self->scheduleStaleCheck(playerId, std::max(updatedAt + staleThreshold, now + dt));
+    });
 
-        if (ids.size() > 3) {
-            NetworkManager::get().send(RequestPlayerProfilesPacket::create(0));
-        } else {
-            for (int id : ids) {
-                NetworkManager::get().send(RequestPlayerProfilesPacket::create(id));
-            }
+    // if more than a second passed and there was only 1 player, they probably left
+    if (now - self->m_fields->lastServerUpdate > staleThreshold + 0.5f && self->m_fields->players.size() < 2) {
+        for (const auto& [playerId, _] : self->m_fields->players) {
+            toRemove.push_back(playerId);
         }
+    }
 
-        for (int id : toRemove) {
-            self->handlePlayerLeave(id);
-        }
+    for (int id : toRemove) {
+        self->handlePlayerLeave(id);
     }
 
+    // profiles of players that joined since the last update are requested together
+    self->m_fields->profiles.flush(self->m_fields->timeCounter);
+
     // update the ping to the server if overlay is enabled
     if (GlobedSettings::get().overlay.enabled) {
         NetworkManager::get().updateServerPing();
     }
 
-    GLOBED_EVENT(this, selPeriodicalUpdate(dt));
+    GLOBED_EVENT_S(this, SelPeriodicalUpdate, selPeriodicalUpdate(dt));
 }
 
 // selUpdate - runs every frame, increments the non-decreasing time counter, interpolates and updates players
@@ -680,6 +728,42 @@ void GlobedGJBGL::selUpdate(float timescaledDt) {
 
     self->m_fields->timeCounter += dt;
 
+    auto& pendingJoins = self->m_fields->pendingJoins;
+    if (self->m_fields->receiver->apply(*self->m_fields->interpolator, pendingJoins)) {
+        self->m_fields->lastServerUpdate = self->m_fields->timeCounter;
+    }
+
+    for (const auto& player : pendingJoins) {
+        if (!self->m_fields->interpolator->hasPlayer(player.accountId)) {
+            // new player joined, their node gets created once there is time for it
+            self->m_fields->interpolator->addPlayer(player.accountId);
+            self->m_fields->joinQueue.push(player.accountId);
+            self->scheduleStaleCheck(player.accountId, self->m_fields->timeCounter);
+        }
+
+        self->m_fields->interpolator->updatePlayer(player.accountId, player.data);
+    }
+
+    pendingJoins.clear();
+
+    auto& joinQueue = self->m_fields->joinQueue;
+    if (!joinQueue.empty()) {
+        joinQueue.drain([&](int playerId) {
+            self->handlePlayerJoin(playerId);
+        });
+
+        auto& joinStats = joinQueue.getStats();
+        if (joinStats.lastFrameJoins > 1) {
+            log::debug(
+                "created {} players in {}us, {} still pending",
+                joinStats.lastFrameJoins, joinStats.lastFrameCost.count(), joinStats.pending
+            );
+        }
+    } else if (!self->m_fields->players.empty()) {
+        // there are people on this level, so more are likely to join later
+        self->m_fields->playerPool.prewarmOne(&self->m_fields->camState);
+    }
+
     self->m_fields->interpolator->tick(dt);
 
     if (auto pl = PlayLayer::get()) {
@@ -700,18 +784,49 @@ void GlobedGJBGL::selUpdate(float timescaledDt) {
 
     bool hasBeenKilled = false;
 
-    for (const auto [playerId, remotePlayer] : self->m_fields->players) {
+    auto& visibility = self->m_fields->visibility;
+    auto& visEntries = visibility.getEntries();
+
+    for (size_t i = 0; i < visEntries.size(); i++) {
+        const auto& vstate = self->m_fields->interpolator->getPlayerState(visEntries[i].playerId);
+        visibility.setBounds(
+            i,
+            vstate.player1.position,
+            vstate.isDualMode ? std::optional(vstate.player2.position) : std::nullopt
+        );
+    }
+
+    visibility.classify(self->m_fields->camState, self->isEditor());
+
+    for (const auto& entry : visEntries) {
+        int playerId = entry.playerId;
+        auto* remotePlayer = self->m_fields->players.at(playerId);
+
         const auto& vstate = self->m_fields->interpolator->getPlayerState(playerId);
 
         auto frameFlags = self->m_fields->interpolator->swapFrameFlags(playerId);
 
-        bool isSpeaking = vpm.isSpeaking(playerId);
-        remotePlayer->updateData(
-            vstate,
-            frameFlags,
-            isSpeaking,
-            isSpeaking ? vpm.getLoudness(playerId) : 0.f
-        );
+#ifdef GLOBED_DEBUG
+        auto updateStart = util::time::now();
+#endif
+
+        if (entry.tier != VisibilityTier::Far) {
+            bool isSpeaking = vpm.isSpeaking(playerId);
+            remotePlayer->updateData(
+                vstate,
+                frameFlags,
+                entry.tier,
+                isSpeaking,
+                isSpeaking ? vpm.getLoudness(playerId) : 0.f
+            );
+        } else if (visibility.isFarUpdateDue(entry)) {
+            remotePlayer->updatePosition(vstate, frameFlags);
+        }
+
+#ifdef GLOBED_DEBUG
+        self->m_fields->playerUpdateTime += util::time::now() - updateStart;
+        self->m_fields->playerUpdates++;
+#endif
 
         // update progress icons
         if (auto self = PlayLayer::get()) {
@@ -724,7 +839,7 @@ void GlobedGJBGL::selUpdate(float timescaledDt) {
         // update voice proximity
         self->updateProximityVolume(playerId);
 
-        GLOBED_EVENT(self, onUpdatePlayer(playerId, remotePlayer, frameFlags));
+        GLOBED_EVENT_S(self, UpdatePlayer, onUpdatePlayer(playerId, remotePlayer, frameFlags));
     }
 
     if (self->m_fields->selfStatusIcons) {
@@ -762,7 +877,7 @@ void GlobedGJBGL::selUpdate(float timescaledDt) {
         }
     }
 
-    GLOBED_EVENT(this, selUpdate(dt));
+    GLOBED_EVENT_S(this, SelUpdate, selUpdate(dt));
 }
 
 // selUpdateEstimators - runs 30 times a second, updates audio stuff
@@ -776,7 +891,7 @@ void GlobedGJBGL::selUpdateEstimators(float dt) {
         self->m_fields->voiceOverlay->updateOverlay();
     }
 
-    GLOBED_EVENT(this, selUpdateEstimators(dt));
+    GLOBED_EVENT_S(this, SelUpdateEstimators, selUpdateEstimators(dt));
 }
 
 /* Player related functions */
@@ -920,6 +1035,10 @@ bool GlobedGJBGL::shouldLetMessageThrough(int playerId) {
     return true;
 }
 
+const VisibilityIndex::Stats& GlobedGJBGL::getVisibilityStats() {
+    return m_fields->visibility.getStats();
+}
+
 void GlobedGJBGL::updateProximityVolume(int playerId) {
     if (m_fields->deafened || !m_fields->isVoiceProximity) return;
 
@@ -946,6 +1065,23 @@ void GlobedGJBGL::updateProximityVolume(int playerId) {
     }
 }
 
+#ifdef GLOBED_DEBUG
+// every node a remote player consists of, including the particle systems of `PlayerObject`s that aren't in the tree until used
+static size_t countPlayerNodes(CCNode* node) {
+    size_t count = 1;
+
+    if (auto* obj = typeinfo_cast<PlayerObject*>(node); obj && obj->m_particleSystems) {
+        count += obj->m_particleSystems->count();
+    }
+
+    for (auto* child : CCArrayExt<CCNode*>(node->getChildren())) {
+        count += countPlayerNodes(child);
+    }
+
+    return count;
+}
+#endif
+
 void GlobedGJBGL::handlePlayerJoin(int playerId) {
     auto& settings = GlobedSettings::get();
 
@@ -979,15 +1115,22 @@ void GlobedGJBGL::handlePlayerJoin(int playerId) {
         }
     }
 
-    auto* rp = Build<RemotePlayer>::create(&m_fields->camState, progressIcon, progressArrow)
-        .zOrder(10)
-        .id(util::cocos::spr(fmt::format("remote-player-{}", playerId)))
-        .collect();
-
     auto& pcm = ProfileCacheManager::get();
     auto pcmData = pcm.getData(playerId);
-    if (pcmData.has_value()) {
-        rp->updateAccountData(pcmData.value(), true);
+
+    Ref<RemotePlayer> rp = m_fields->playerPool.acquire(
+        &m_fields->camState,
+        progressIcon,
+        progressArrow,
+        pcmData ? *pcmData : PlayerAccountData::DEFAULT_DATA
+    );
+
+    rp->setZOrder(10);
+    rp->setID(util::cocos::spr(fmt::format("remote-player-{}", playerId)));
+
+    // profiles loaded from disk are shown right away, but still refreshed
+    if (!pcmData || !pcm.isVerified(playerId)) {
+        m_fields->profiles.request(playerId);
     }
 
     auto& bl = BlockListManager::get();
@@ -997,29 +1140,69 @@ void GlobedGJBGL::handlePlayerJoin(int playerId) {
 
     m_objectLayer->addChild(rp);
     m_fields->players.emplace(playerId, rp);
-    m_fields->interpolator->addPlayer(playerId);
 
-    GLOBED_EVENT(this, onPlayerJoin(rp));
+#ifdef GLOBED_DEBUG
+    if (m_fields->nodesPerPlayer == 0) {
+        m_fields->nodesPerPlayer = countPlayerNodes(rp);
+    }
+#endif
+    m_fields->visibility.addPlayer(playerId);
+
+    GLOBED_EVENT_S(this, PlayerJoin, onPlayerJoin(rp));
 }
 
 void GlobedGJBGL::handlePlayerLeave(int playerId) {
     VoicePlaybackManager::get().removeStream(playerId);
 
-    if (!m_fields->players.contains(playerId)) return;
+    auto timer = m_fields->staleTimerIds.find(playerId);
+    if (timer != m_fields->staleTimerIds.end()) {
+        m_fields->staleTimers.cancel(timer->second);
+        m_fields->staleTimerIds.erase(timer);
+    }
 
+    // left before their node was created
+    if (m_fields->joinQueue.remove(playerId)) {
+        m_fields->interpolator->removePlayer(playerId);
+        m_fields->playerStore->removePlayer(playerId);
+        return;
+    }
+
+    if (!m_fields->players.contains(playerId)) return;
 
     auto rp = m_fields->players.at(playerId);
 
-    GLOBED_EVENT(this, onPlayerLeave(rp));
+    GLOBED_EVENT_S(this, PlayerLeave, onPlayerLeave(rp));
 
+    // keep the node alive until it's in the pool
+    Ref<RemotePlayer> node = rp;
     rp->removeProgressIndicators();
     rp->removeFromParent();
+    m_fields->playerPool.release(rp);
 
     m_fields->players.erase(playerId);
     m_fields->interpolator->removePlayer(playerId);
+    m_fields->visibility.removePlayer(playerId);
+    m_fields->profiles.cancel(playerId);
     m_fields->playerStore->removePlayer(playerId);
 }
 
+void GlobedGJBGL::scheduleStaleCheck(int playerId, float time) {
+    uint64_t deadline = static_cast<uint64_t>(time * 1000.f);
+
+    auto& id = m_fields->staleTimerIds[playerId];
+    if (!m_fields->staleTimers.reschedule(id, deadline)) {
+        id = m_fields->staleTimers.schedule(deadline, playerId);
+    }
+}
+
+const PlayerJoinQueue::Stats& GlobedGJBGL::getJoinStats() {
+    return m_fields->joinQueue.getStats();
+}
+
+const RemotePlayerPool::Stats& GlobedGJBGL::getPlayerPoolStats() {
+    return m_fields->playerPool.getStats();
+}
+
 bool GlobedGJBGL::established() {
     // the 2nd check is in case we disconnect while being in a level somehow
     return m_fields->globedReady && NetworkManager::get().established();
@@ -1064,11 +1247,37 @@ void GlobedGJBGL::toggleSafeMode(bool enabled) {
     m_fields->shouldStopProgress = enabled;
 }
 
+void GlobedGJBGL::subscribeModule(BaseGameplayModule* module, ModuleEventMask events) {
+    for (size_t i = 0; i < m_fields->moduleSubscribers.size(); i++) {
+        if (events & moduleEventBit(static_cast<ModuleEvent>(i))) {
+            m_fields->moduleSubscribers[i].push_back(module);
+        }
+    }
+}
+
 void GlobedGJBGL::onQuitActions() {
     auto& nm = NetworkManager::get();
 
     m_fields->quitting = true;
 
+    nm.removeThreadListener<LevelDataPacket>();
+
+#ifdef GLOBED_RECORD_SEND_TRACES
+    if (!m_fields->sendTrace.empty()) {
+        auto dir = Mod::get()->getSaveDir() / "send-traces";
+        std::error_code ec;
+        std::filesystem::create_directories(dir, ec);
+
+        ByteBuffer bb;
+        bb.writeValue(m_fields->sendTrace);
+
+        auto path = dir / fmt::format("{}.bin", util::time::sinceEpoch().count());
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(bb.data().data()), bb.size());
+        log::debug("saved send trace with {} frames to {}", m_fields->sendTrace.size(), path);
+    }
+#endif
+
     if (m_fields->globedReady) {
         if (nm.established()) {
             // send LevelLeavePacket
@@ -1082,15 +1291,33 @@ void GlobedGJBGL::onQuitActions() {
 #endif // GLOBED_VOICE_SUPPORT
 
         GLOBED_EVENT(this, onQuit());
+
+#ifdef GLOBED_DEBUG
+        if (m_fields->playerUpdates > 0) {
+            auto& poolStats = m_fields->playerPool.getStats();
+
+            log::debug(
+                "remote players ({}): {} nodes per player, {} bytes per player ({} measured), {:.3f}μs per player per frame",
+                m_fields->playerPool.isLightweight() ? "lightweight" : "full",
+                m_fields->nodesPerPlayer,
+                poolStats.measured > 0 ? poolStats.measuredBytes / poolStats.measured : 0,
+                poolStats.measured,
+                static_cast<double>(util::time::as<util::time::nanos>(m_fields->playerUpdateTime).count()) / 1000.0 / m_fields->playerUpdates
+            );
+        }
+#endif
+
+        // so that the players from this level are known on the next startup
+        ProfileCacheManager::get().saveSnapshot();
     }
 }
 
 void GlobedGJBGL::pausedUpdate(float dt) {
     // unpause dash effects and death effects
     for (auto* child : CCArrayExt<CCNode*>(m_objectLayer->getChildren())) {
-        int tag1 = ComplexVisualPlayer::SPIDER_DASH_CIRCLE_WAVE_TAG;
-        int tag2 = ComplexVisualPlayer::SPIDER_DASH_SPRITE_TAG;
-        int tag3 = ComplexVisualPlayer::DEATH_EFFECT_TAG;
+        int tag1 = BaseVisualPlayer::SPIDER_DASH_CIRCLE_WAVE_TAG;
+        int tag2 = BaseVisualPlayer::SPIDER_DASH_SPRITE_TAG;
+        int tag3 = BaseVisualPlayer::DEATH_EFFECT_TAG;
 
         int ctag = child->getTag();
 
@@ -1137,7 +1364,7 @@ void GlobedGJBGL::unscheduleSelectors() {
     this->unscheduleSelector(schedule_selector(GlobedGJBGL::selPeriodicalUpdate));
     this->unscheduleSelector(schedule_selector(GlobedGJBGL::selUpdateEstimators));
 
-    GLOBED_EVENT(this, onUnscheduleSelectors());
+    GLOBED_EVENT_S(this, UnscheduleSelectors, onUnscheduleSelectors());
 }
 
 void GlobedGJBGL::unscheduleSelector(cocos2d::SEL_SCHEDULE selector) {
@@ -1159,7 +1386,7 @@ void GlobedGJBGL::rescheduleSelectors() {
     this->customSchedule(schedule_selector(GlobedGJBGL::selPeriodicalUpdate), updpInterval);
     this->customSchedule(schedule_selector(GlobedGJBGL::selUpdateEstimators), updeInterval);
 
-    GLOBED_EVENT(this, onRescheduleSelectors(timescale));
+    GLOBED_EVENT_S(this, RescheduleSelectors, onRescheduleSelectors(timescale));
 }
 
 void GlobedGJBGL::customSchedule(cocos2d::SEL_SCHEDULE selector, float interval) {
@@ -1174,7 +1401,7 @@ int GlobedGJBGL::checkCollisions(PlayerObject* player, float dt, bool p2) {
     if ((void*)this != GJBaseGameLayer::get()) return retval;
     if (!this->established()) return retval;
 
-    GLOBED_EVENT(this, checkCollisions(player, dt, p2));
+    GLOBED_EVENT_S(this, CheckCollisions, checkCollisions(player, dt, p2));
 
     return retval;
 }
@@ -1185,11 +1412,11 @@ void GlobedGJBGL::loadLevelSettings() {
         return;
     }
 
-    GLOBED_EVENT(this, loadLevelSettingsPre());
+    GLOBED_EVENT_S(this, LoadLevelSettingsPre, loadLevelSettingsPre());
 
     GJBaseGameLayer::loadLevelSettings();
 
-    GLOBED_EVENT(this, loadLevelSettingsPost());
+    GLOBED_EVENT_S(this, LoadLevelSettingsPost, loadLevelSettingsPost());
 }
 
 class $modify(PlayerObject) {
@@ -1204,9 +1431,9 @@ class $modify(PlayerObject) {
         if ((void*)m_gameLayer != pl || !pl) return;
 
         if (pl->m_player1 == this || pl->m_player2 == this) {
-            GLOBED_EVENT(pl, mainPlayerUpdate(this, dt));
+            GLOBED_EVENT_S(pl, MainPlayerUpdate, mainPlayerUpdate(this, dt));
         } else {
-            GLOBED_EVENT(pl, onlinePlayerUpdate(this, dt));
+            GLOBED_EVENT_S(pl, OnlinePlayerUpdate, onlinePlayerUpdate(this, dt));
         }
     }
 
@@ -1215,13 +1442,13 @@ class $modify(PlayerObject) {
 
         auto* gjbgl = GlobedGJBGL::get();
         if (gjbgl && (this == gjbgl->m_player1 || this == gjbgl->m_player2)) {
-            GLOBED_EVENT(gjbgl, playerDestroyed(this, p0));
+            GLOBED_EVENT_S(gjbgl, PlayerDestroyed, playerDestroyed(this, p0));
         }
     }
 };
 
 void GlobedGJBGL::updateCamera(float dt) {
-    GLOBED_EVENT(this, updateCameraPre(dt));
+    GLOBED_EVENT_S(this, UpdateCameraPre, updateCameraPre(dt));
     GJBaseGameLayer::updateCamera(dt);
-    GLOBED_EVENT(this, updateCameraPost(dt));
+    GLOBED_EVENT_S(this, UpdateCameraPost, updateCameraPost(dt));
 }
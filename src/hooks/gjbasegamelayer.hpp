@@ -5,15 +5,22 @@
 
 #include <data/types/room.hpp>
 #include <game/interpolator.hpp>
+#include <game/join_queue.hpp>
 #include <game/player_store.hpp>
+#include <game/profile_resolver.hpp>
+#include <game/send_rate.hpp>
+#include <game/player_data_receiver.hpp>
+#include <game/visibility.hpp>
 #include <game/module/base.hpp>
 #include <net/manager.hpp>
 #include <ui/game/player/remote_player.hpp>
+#include <ui/game/player/remote_player_pool.hpp>
 #include <ui/game/overlay/overlay.hpp>
 #include <ui/game/progress/progress_icon.hpp>
 #include <ui/game/progress/progress_arrow.hpp>
 #include <ui/game/voice_overlay/overlay.hpp>
 #include <util/time.hpp>
+#include <util/timer_wheel.hpp>
 
 float adjustLerpTimeDelta(float dt);
 
@@ -31,10 +38,25 @@ class $modify(GlobedGJBGL, GJBaseGameLayer) {
         float timeCounter = 0.f;
         float lastServerUpdate = 0.f;
         std::unique_ptr<PlayerInterpolator> interpolator;
+        std::unique_ptr<SendRateController> sendRate; // null if adaptive send rate is disabled
+#ifdef GLOBED_RECORD_SEND_TRACES
+        std::vector<PlayerData> sendTrace;
+#endif
+#ifdef GLOBED_DEBUG
+        // cost of the remote player nodes, logged when leaving the level
+        size_t nodesPerPlayer = 0;
+        size_t playerUpdates = 0;
+        util::time::clock::duration playerUpdateTime{};
+#endif
+        std::shared_ptr<PlayerDataReceiver> receiver;
+        // frames of players that aren't in the interpolator yet, reused every frame
+        std::vector<AssociatedPlayerData> pendingJoins;
         std::unique_ptr<PlayerStore> playerStore;
         RoomSettings roomSettings;
 
         std::vector<std::unique_ptr<BaseGameplayModule>> modules;
+        // for every `ModuleEvent`, the modules that handle it
+        std::array<std::vector<BaseGameplayModule*>, static_cast<size_t>(ModuleEvent::Count)> moduleSubscribers;
 
         bool isManuallyResettingLevel = false;
 
@@ -45,6 +67,7 @@ class $modify(GlobedGJBGL, GJBaseGameLayer) {
         bool shouldRequestMeta = false;
         bool isFakingDeath = false;
         GameCameraState camState;
+        VisibilityIndex visibility;
 
         std::optional<SpiderTeleportData> spiderTp1, spiderTp2;
         bool didJustJumpp1 = false, didJustJumpp2 = false;
@@ -55,6 +78,12 @@ class $modify(GlobedGJBGL, GJBaseGameLayer) {
         // ui elements
         GlobedOverlay* overlay = nullptr;
         std::unordered_map<int, RemotePlayer*> players;
+        PlayerJoinQueue joinQueue;
+        ProfileResolver profiles;
+        // every player gets checked for having left once their last update is old enough, ticks are milliseconds of `timeCounter`
+        util::time::TimerWheel<int> staleTimers;
+        std::unordered_map<int, util::time::TimerWheel<int>::Id> staleTimerIds;
+        RemotePlayerPool playerPool;
         Ref<PlayerProgressIcon> selfProgressIcon = nullptr;
         Ref<CCNode> progressBarWrapper = nullptr;
         Ref<PlayerStatusIcons> selfStatusIcons = nullptr;
@@ -134,11 +163,20 @@ class $modify(GlobedGJBGL, GJBaseGameLayer) {
     static cocos2d::CCPoint getCameraDirectionVector();
     static float getCameraDirectionAngle();
 
+    // how many players were in each visibility tier and how many got updated, in the last frame
+    const VisibilityIndex::Stats& getVisibilityStats();
+
     bool shouldLetMessageThrough(int playerId);
     void updateProximityVolume(int playerId);
 
+    // creates the node for a player, they must already be added to the interpolator
     void handlePlayerJoin(int playerId);
     void handlePlayerLeave(int playerId);
+    // (re)schedules the check for whether the player has left, `time` is in the same units as `timeCounter`
+    void scheduleStaleCheck(int playerId, float time);
+
+    const PlayerJoinQueue::Stats& getJoinStats();
+    const RemotePlayerPool::Stats& getPlayerPoolStats();
 
     /* misc */
 
@@ -157,9 +195,12 @@ class $modify(GlobedGJBGL, GJBaseGameLayer) {
 
     template <typename T> requires (std::is_base_of_v<BaseGameplayModule, T>)
     void addModule() {
-        m_fields->modules.push_back(std::make_unique<T>(this));
+        auto& module = m_fields->modules.emplace_back(std::make_unique<T>(this));
+        this->subscribeModule(module.get(), BaseGameplayModule::handledEvents<T>());
     }
 
+    void subscribeModule(BaseGameplayModule* module, ModuleEventMask events);
+
     // With speedhack enabled, all scheduled selectors will run more often than they are supposed to.
     // This means, if you turn up speedhack to let's say 100x, you will send 3000 packets per second. That is a big no-no.
     // For naive speedhack implementations, we simply check CCScheduler::getTimeScale and properly reschedule our data sender.
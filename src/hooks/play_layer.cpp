@@ -9,15 +9,15 @@
 
 using namespace geode::prelude;
 
-// post an event to all modules
-#define GLOBED_EVENT(self, code) \
-    for (auto& module : self->m_fields->modules) { \
+// post an event to the modules that handle it
+#define GLOBED_EVENT_S(self, event, code) \
+    for (auto* module : self->m_fields->moduleSubscribers[static_cast<size_t>(ModuleEvent::event)]) { \
         module->code; \
     }
 
-// post an event to all modules
-#define GLOBED_EVENT_O(self, code) \
-    for (auto& module : self->m_fields->modules) { \
+// post an event to the modules that handle it, stopping if any of them halts
+#define GLOBED_EVENT_SO(self, event, code) \
+    for (auto* module : self->m_fields->moduleSubscribers[static_cast<size_t>(ModuleEvent::event)]) { \
         auto _mo = module->code; \
         if (_mo == BaseGameplayModule::EventOutcome::Halt) return; \
     }
@@ -69,7 +69,7 @@ void GlobedPlayLayer::fullReset() {
 
     auto gjbgl = GlobedGJBGL::get();
 
-    GLOBED_EVENT_O(gjbgl, fullResetLevel());
+    GLOBED_EVENT_SO(gjbgl, FullResetLevel, fullResetLevel());
 
     // turn off safe mode
     GlobedGJBGL::get()->toggleSafeMode(false);
@@ -78,7 +78,7 @@ void GlobedPlayLayer::fullReset() {
 void GlobedPlayLayer::resetLevel() {
     auto gjbgl = GlobedGJBGL::get();
 
-    GLOBED_EVENT_O(gjbgl, resetLevel());
+    GLOBED_EVENT_SO(gjbgl, ResetLevel, resetLevel());
 
     if (m_fields->insideDestroyPlayer) {
         m_fields->insideDestroyPlayer = false;
@@ -120,7 +120,7 @@ void GlobedPlayLayer::destroyPlayer(PlayerObject* player, GameObject* object) {
 
     auto* pl = GlobedGJBGL::get();
 
-    GLOBED_EVENT_O(pl, destroyPlayerPre(player, object));
+    GLOBED_EVENT_SO(pl, DestroyPlayerPre, destroyPlayerPre(player, object));
 
     // safe mode stuff yeah
 
@@ -159,7 +159,7 @@ void GlobedPlayLayer::destroyPlayer(PlayerObject* player, GameObject* object) {
 #endif
 
 
-    GLOBED_EVENT(pl, destroyPlayerPost(player, object));
+    GLOBED_EVENT_S(pl, DestroyPlayerPost, destroyPlayerPost(player, object));
 
     m_isTestMode = lastTestMode;
 }
@@ -1,19 +1,137 @@
 #include "profile_cache.hpp"
 
-void ProfileCacheManager::insert(const PlayerAccountData& data) {
-    cache[data.accountId] = data;
+#include <data/bytebuffer.hpp>
+
+#include <fstream>
+
+using namespace geode::prelude;
+
+ProfileCacheManager::ProfileCacheManager() {
+    auto result = this->loadSnapshot();
+    if (result.isErr()) {
+        log::warn("Failed to load the profile cache: {}", result.unwrapErr());
+        this->clear();
+    }
 }
 
-std::optional<PlayerAccountData> ProfileCacheManager::getData(int32_t accountId) {
-    if (cache.contains(accountId)) {
-        return cache.at(accountId);
+bool ProfileCacheManager::insert(const PlayerAccountData& data) {
+    auto it = cache.find(data.accountId);
+
+    if (it != cache.end() && *it->second.data == data) {
+        it->second.verified = true;
+        lru.splice(lru.begin(), lru, it->second.lruPos);
+        return false;
     }
 
-    return std::nullopt;
+    this->insertEntry(data, true);
+    return true;
+}
+
+ProfileCacheManager::Handle ProfileCacheManager::getData(int32_t accountId) {
+    auto it = cache.find(accountId);
+    if (it == cache.end()) return nullptr;
+
+    lru.splice(lru.begin(), lru, it->second.lruPos);
+    return it->second.data;
+}
+
+bool ProfileCacheManager::isVerified(int32_t accountId) const {
+    auto it = cache.find(accountId);
+    return it != cache.end() && it->second.verified;
 }
 
 void ProfileCacheManager::clear() {
     cache.clear();
+    lru.clear();
+}
+
+void ProfileCacheManager::saveSnapshot() {
+    size_t count = std::min(lru.size(), SNAPSHOT_ENTRIES);
+
+    ByteBuffer bb;
+    bb.writeU32(SNAPSHOT_FORMAT);
+    bb.writeU32(count);
+
+    // least recently used first, so that loading it in order restores the same lru order
+    auto it = lru.begin();
+    std::advance(it, count);
+
+    while (it != lru.begin()) {
+        --it;
+        bb.writeValue(*cache.at(*it).data);
+    }
+
+    auto path = this->snapshotPath();
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(bb.data().data()), bb.size());
+
+    if (!file) {
+        log::warn("Failed to save the profile cache to {}", path);
+    }
+}
+
+void ProfileCacheManager::insertEntry(const PlayerAccountData& data, bool verified) {
+    auto it = cache.find(data.accountId);
+
+    if (it != cache.end()) {
+        lru.splice(lru.begin(), lru, it->second.lruPos);
+    } else {
+        lru.push_front(data.accountId);
+        it = cache.emplace(data.accountId, Entry { .lruPos = lru.begin() }).first;
+    }
+
+    // existing handles keep pointing to the old profile, they are never modified
+    it->second.data = std::make_shared<const PlayerAccountData>(data);
+    it->second.verified = verified;
+
+    while (cache.size() > MAX_ENTRIES) {
+        cache.erase(lru.back());
+        lru.pop_back();
+    }
+}
+
+std::filesystem::path ProfileCacheManager::snapshotPath() {
+    return Mod::get()->getSaveDir() / "profile-cache.bin";
+}
+
+Result<> ProfileCacheManager::loadSnapshot() {
+    auto path = this->snapshotPath();
+
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec)) return Ok();
+
+    std::ifstream file(path, std::ios::binary);
+    GLOBED_REQUIRE_SAFE(file, fmt::format("failed to open {}", path.string()));
+
+    util::data::bytevector data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    ByteBuffer bb(std::move(data));
+
+    auto formatR = bb.readU32();
+    if (formatR.isErr()) {
+        return Err(ByteBuffer::strerror(formatR.unwrapErr()));
+    }
+
+    // an older format is simply thrown away, it's only a cache
+    if (formatR.unwrap() != SNAPSHOT_FORMAT) return Ok();
+
+    auto countR = bb.readU32();
+    if (countR.isErr()) {
+        return Err(ByteBuffer::strerror(countR.unwrapErr()));
+    }
+
+    size_t count = std::min<size_t>(countR.unwrap(), SNAPSHOT_ENTRIES);
+    for (size_t i = 0; i < count; i++) {
+        auto entryR = bb.readValue<PlayerAccountData>();
+        if (entryR.isErr()) {
+            return Err(ByteBuffer::strerror(entryR.unwrapErr()));
+        }
+
+        this->insertEntry(entryR.unwrap(), false);
+    }
+
+    log::debug("Loaded {} profiles from the profile cache", cache.size());
+
+    return Ok();
 }
 
 void ProfileCacheManager::setOwnDataAuto() {
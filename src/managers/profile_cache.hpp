@@ -5,12 +5,33 @@
 #include <data/types/gd.hpp>
 #include <util/singleton.hpp>
 
+#include <list>
+
+// Profiles (name, icons) of other players, bounded to the most recently used `MAX_ENTRIES`.
+// The most recent ones are saved to disk when leaving a level and loaded back on startup, so that players we've seen before
+// show up with the right icons right away. Those count as unverified until the server sends them again in this session.
 class ProfileCacheManager : public SingletonBase<ProfileCacheManager> {
+protected:
+    friend class SingletonBase;
+    ProfileCacheManager();
+
 public:
-    void insert(const PlayerAccountData& data);
-    std::optional<PlayerAccountData> getData(int32_t accountId);
+    using Handle = std::shared_ptr<const PlayerAccountData>;
+
+    static constexpr size_t MAX_ENTRIES = 1024;
+    static constexpr size_t SNAPSHOT_ENTRIES = 256;
+
+    // returns `true` if the profile is new or differs from the cached one
+    bool insert(const PlayerAccountData& data);
+    // null if the player is not cached
+    Handle getData(int32_t accountId);
+    // whether the cached profile came from the server in this session, rather than from the snapshot
+    bool isVerified(int32_t accountId) const;
     void clear();
 
+    // save the most recently used profiles to disk
+    void saveSnapshot();
+
     // gather player's icons and call `setOwnData`;
     void setOwnDataAuto();
     void setOwnData(const PlayerIconData& data);
@@ -22,7 +43,22 @@ public:
     bool pendingChanges = false;
 
 private:
-    std::unordered_map<int32_t, PlayerAccountData> cache;
+    static constexpr uint32_t SNAPSHOT_FORMAT = 1;
+
+    struct Entry {
+        Handle data;
+        bool verified;
+        // position in `lru`
+        std::list<int32_t>::iterator lruPos;
+    };
+
+    std::unordered_map<int32_t, Entry> cache;
+    // most recently used first
+    std::list<int32_t> lru;
     PlayerAccountData ownData;
     SpecialUserData ownSpecialData;
-};
\ No newline at end of file
+
+    void insertEntry(const PlayerAccountData& data, bool verified);
+    std::filesystem::path snapshotPath();
+    Result<> loadSnapshot();
+};
@@ -151,6 +151,7 @@ public:
         Setting<int, 60000> fragmentationLimit;
         Setting<bool, false> compressedPlayerCount;
         Setting<bool, true> useDiscordRPC;
+        Setting<bool, true> adaptiveSendRate;
 
         // hidden settings! no settings ui for them
 
@@ -178,6 +179,10 @@ public:
         Setting<int, 0> audioDevice;
         Setting<bool, true> deafenNotification;
         Setting<bool, false> voiceLoopback; // TODO unimpl
+        Setting<bool, false> softwareMixer;
+        Setting<bool, false> lowLatencyVoice;
+        Setting<bool, true> voiceActivityDetection;
+        LimitedSetting<int, 24000, 6000, 64000> voiceBitrate;
     };
 
     struct LevelUI {
@@ -200,6 +205,8 @@ public:
         Setting<bool, false> ownName;
         Setting<bool, false> rotateNames;
         Setting<bool, false> hidePracticePlayers;
+        Setting<bool, false> extrapolation;
+        Setting<bool, false> lightweightPlayers;
     };
 
     struct Advanced {};
@@ -285,7 +292,7 @@ public:
 /* Enable reflection */
 
 GLOBED_SERIALIZABLE_STRUCT(GlobedSettings::Globed, (
-    autoconnect, tpsCap, preloadAssets, deferPreloadAssets, invitesFrom, editorSupport, increaseLevelList, fragmentationLimit, compressedPlayerCount, useDiscordRPC,
+    autoconnect, tpsCap, preloadAssets, deferPreloadAssets, invitesFrom, editorSupport, increaseLevelList, fragmentationLimit, compressedPlayerCount, useDiscordRPC, adaptiveSendRate,
     isInvisible, noInvites, hideInGame, hideRoles
 ));
 
@@ -294,7 +301,7 @@ GLOBED_SERIALIZABLE_STRUCT(GlobedSettings::Overlay, (
 ));
 
 GLOBED_SERIALIZABLE_STRUCT(GlobedSettings::Communication, (
-    voiceEnabled, voiceProximity, classicProximity, voiceVolume, onlyFriends, lowerAudioLatency, audioDevice, deafenNotification, voiceLoopback
+    voiceEnabled, voiceProximity, classicProximity, voiceVolume, onlyFriends, lowerAudioLatency, audioDevice, deafenNotification, voiceLoopback, softwareMixer, lowLatencyVoice, voiceActivityDetection, voiceBitrate
 ));
 
 GLOBED_SERIALIZABLE_STRUCT(GlobedSettings::LevelUI, (
@@ -302,7 +309,7 @@ GLOBED_SERIALIZABLE_STRUCT(GlobedSettings::LevelUI, (
 ));
 
 GLOBED_SERIALIZABLE_STRUCT(GlobedSettings::Players, (
-    playerOpacity, showNames, dualName, nameOpacity, statusIcons, deathEffects, defaultDeathEffect, hideNearby, forceVisibility, ownName, hidePracticePlayers, rotateNames
+    playerOpacity, showNames, dualName, nameOpacity, statusIcons, deathEffects, defaultDeathEffect, hideNearby, forceVisibility, ownName, hidePracticePlayers, rotateNames, extrapolation, lightweightPlayers
 ));
 
 GLOBED_SERIALIZABLE_STRUCT(GlobedSettings::Advanced, ());
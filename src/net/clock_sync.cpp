@@ -0,0 +1,57 @@
+#include "clock_sync.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+constexpr static float MICROS_TO_SECS = 1.f / 1'000'000.f;
+
+void ClockEstimator::addSample(uint64_t t0, uint64_t t1, uint64_t t2, uint64_t t3) {
+    int64_t c0 = t0, s1 = t1, s2 = t2, c3 = t3;
+
+    // time spent on the wire, excluding the time the server held onto the request
+    int64_t rtt = std::max<int64_t>((c3 - c0) - (s2 - s1), 0);
+    // assumes the path is symmetric, the error is at most rtt / 2
+    int64_t offset = ((s1 - c0) + (s2 - c3)) / 2;
+
+    window[windowHead] = Sample { .rtt = rtt, .offset = offset };
+    windowHead = (windowHead + 1) % WINDOW_SIZE;
+    windowCount = std::min(windowCount + 1, WINDOW_SIZE);
+
+    auto best = std::min_element(window.begin(), window.begin() + windowCount, [](const Sample& a, const Sample& b) {
+        return a.rtt < b.rtt;
+    });
+
+    conditions.clockOffset = best->offset;
+    conditions.minRtt = best->rtt * MICROS_TO_SECS;
+
+    float rttSecs = rtt * MICROS_TO_SECS;
+
+    if (!conditions.valid) {
+        conditions.rtt = rttSecs;
+        conditions.jitter = 0.f;
+    } else {
+        // same smoothing as tcp (RFC 6298) for the rtt, and as RTP (RFC 3550) for the jitter
+        conditions.rtt += (rttSecs - conditions.rtt) / 8.f;
+        float d = std::abs(rtt - lastRtt) * MICROS_TO_SECS;
+        conditions.jitter += (d - conditions.jitter) / 16.f;
+    }
+
+    lastRtt = rtt;
+    conditions.valid = true;
+    conditions.samples++;
+}
+
+void ClockEstimator::reset() {
+    windowCount = 0;
+    windowHead = 0;
+    lastRtt = -1;
+    conditions = {};
+}
+
+const NetworkConditions& ClockEstimator::getConditions() const {
+    return conditions;
+}
+
+int64_t ClockEstimator::toLocalTime(int64_t serverTime) const {
+    return serverTime - conditions.clockOffset;
+}
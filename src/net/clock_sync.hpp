@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <stddef.h>
+#include <stdint.h>
+
+// Measured conditions of the connection to the active server
+struct NetworkConditions {
+    bool valid = false;         // false until the server answered at least one clock sync request
+    float rtt = 0.f;            // smoothed round trip time, in seconds
+    float minRtt = 0.f;         // lowest round trip time out of the recent samples
+    float jitter = 0.f;         // smoothed variation of the round trip time between samples, in seconds
+    int64_t clockOffset = 0;    // server clock minus `util::time::sinceEpochPrecise()`, in microseconds
+    float loss = 0.f;           // fraction of recent UDP datagrams from the server that were lost
+    size_t samples = 0;
+};
+
+// NTP-style estimator of the server clock offset, round trip time and jitter.
+// Every sample is one request/response exchange with four timestamps, t0 and t3 by the local clock, t1 and t2 by the server clock.
+class ClockEstimator {
+public:
+    // all timestamps are in microseconds: t0 - request sent, t1 - request received by the server,
+    // t2 - response sent by the server, t3 - response received
+    void addSample(uint64_t t0, uint64_t t1, uint64_t t2, uint64_t t3);
+    void reset();
+
+    const NetworkConditions& getConditions() const;
+
+    // converts a server timestamp to the local clock, or returns it unchanged if there is no estimate yet
+    int64_t toLocalTime(int64_t serverTime) const;
+
+private:
+    // the offset is taken from the sample with the lowest rtt out of this many,
+    // as that one was least affected by queueing delays that make it asymmetric
+    static constexpr size_t WINDOW_SIZE = 8;
+
+    struct Sample {
+        int64_t rtt;
+        int64_t offset;
+    };
+
+    std::array<Sample, WINDOW_SIZE> window;
+    size_t windowCount = 0;
+    size_t windowHead = 0;
+    int64_t lastRtt = -1;
+
+    NetworkConditions conditions;
+};
@@ -45,6 +45,9 @@ Result<> GameSocket::connect(const NetworkAddress& address, bool isRecovering) {
     GLOBED_UNWRAP(tcpSocket.connect(address))
     GLOBED_UNWRAP(udpSocket.connect(address))
 
+    nextSendSeq = 1;
+    recvSeq.lock()->reset();
+
     // send a magic byte telling the server whether we are recovering or not
     uint8_t byte = isRecovering ? MARKER_CONN_RECOVERY : MARKER_CONN_INITIAL;
     GLOBED_UNWRAP(tcpSocket.send(reinterpret_cast<const char*>(&byte), 1));
@@ -88,7 +91,25 @@ Result<ReceivedPacket> GameSocket::recvPacketUDP() {
         return Err("udp recv failed");
     }
 
-    ByteBuffer buf(dataBuffer, (size_t)recvResult.result);
+    GLOBED_REQUIRE_SAFE((size_t)recvResult.result >= sizeof(uint32_t), "udp datagram is too short")
+
+    ByteBuffer seqBuf(dataBuffer, sizeof(uint32_t));
+    uint32_t seq = seqBuf.readU32().value_or(0);
+
+    // datagrams from other servers and sessionless ones (seq 0) don't count towards the link stats
+    if (out.fromConnected && seq != 0) {
+        auto outcome = recvSeq.lock()->record(seq);
+
+        // state packets are not dropped when reordered, level data is fragmented into packets with disjoint players,
+        // and the interpolator already ignores frames older than the newest one it has for a player
+        if (outcome == SequenceTracker::Outcome::Duplicate) {
+            return Ok(std::move(out));
+        }
+
+        out.reordered = outcome == SequenceTracker::Outcome::Reordered;
+    }
+
+    ByteBuffer buf(dataBuffer + sizeof(uint32_t), (size_t)recvResult.result - sizeof(uint32_t));
 
     GLOBED_UNWRAP_INTO(this->decodePacket(buf), out.packet);
 
@@ -124,7 +145,7 @@ Result<> GameSocket::sendPacket(std::shared_ptr<Packet> packet) {
     GLOBED_REQUIRE_SAFE(this->isConnected(), "attempting to send a packet while disconnected")
 
     ByteBuffer buf;
-    GLOBED_UNWRAP(this->encodePacket(*packet, buf))
+    GLOBED_UNWRAP(this->encodePacket(*packet, buf, packet->getUseTcp() ? 0 : nextSendSeq++))
 
     if (dumpPackets) {
         this->dumpPacket(packet->getPacketId(), buf, true);
@@ -179,6 +200,10 @@ void GameSocket::togglePacketLogging(bool state) {
     dumpPackets = state;
 }
 
+LinkStats GameSocket::getLinkStats() {
+    return recvSeq.lock()->getStats();
+}
+
 Result<PollResult> GameSocket::poll(int timeoutMs) {
     if (!tcpSocket.connected) {
         GLOBED_UNWRAP_INTO(udpSocket.poll(timeoutMs), auto res);
@@ -212,7 +237,7 @@ Result<PollResult> GameSocket::poll(int timeoutMs) {
     }
 }
 
-Result<> GameSocket::encodePacket(Packet& packet, ByteBuffer& buffer) {
+Result<> GameSocket::encodePacket(Packet& packet, ByteBuffer& buffer, uint32_t seq) {
     PacketHeader header = {
         .id = packet.getPacketId(),
         .encrypted = packet.getEncrypted(),
@@ -220,12 +245,10 @@ Result<> GameSocket::encodePacket(Packet& packet, ByteBuffer& buffer) {
 
     bool tcp = packet.getUseTcp();
 
-    // reserve space for packet length when using TCP
+    // reserve space for packet length when using TCP, UDP datagrams have the sequence number there instead
     size_t startPos = buffer.getPosition();
 
-    if (tcp) {
-        buffer.writeU32(0);
-    }
+    buffer.writeU32(tcp ? 0 : seq);
 
     buffer.writeValue<PacketHeader>(header);
     packet.encode(buffer);
@@ -235,10 +258,7 @@ Result<> GameSocket::encodePacket(Packet& packet, ByteBuffer& buffer) {
 
         // grow the vector by CryptoBox::PREFIX_LEN extra bytes to do in-place encryption
         buffer.grow(CryptoBox::PREFIX_LEN);
-        uint32_t headerSize = PacketHeader::SIZE;
-        if (tcp) {
-            headerSize += sizeof(uint32_t);
-        }
+        uint32_t headerSize = PacketHeader::SIZE + sizeof(uint32_t);
 
         auto rawSize = buffer.size() - headerSize - startPos - CryptoBox::PREFIX_LEN;
         cryptoBox->encryptInPlace(buffer.data().data() + startPos + headerSize, rawSize);
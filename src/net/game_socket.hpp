@@ -3,9 +3,11 @@
 #include "address.hpp"
 #include "udp_socket.hpp"
 #include "tcp_socket.hpp"
+#include "link_stats.hpp"
 
 #include <data/packets/packet.hpp>
 #include <crypto/box.hpp>
+#include <asp/sync.hpp>
 
 class GameSocket {
     static constexpr uint8_t MARKER_CONN_INITIAL = 0xe0;
@@ -20,8 +22,9 @@ public:
     bool isConnected();
 
     struct ReceivedPacket {
-        std::shared_ptr<Packet> packet;
+        std::shared_ptr<Packet> packet; // null if the datagram was a duplicate and got dropped
         bool fromConnected;
+        bool reordered = false;         // a datagram sent after this one already arrived
     };
 
     // Try to receive a packet on the TCP socket
@@ -49,6 +52,9 @@ public:
 
     void togglePacketLogging(bool enabled);
 
+    // Counters for the UDP datagrams received from the active server since connecting
+    LinkStats getLinkStats();
+
     enum class PollResult {
         None, Tcp, Udp, Both
     };
@@ -66,8 +72,12 @@ private:
 
     bool dumpPackets = false;
 
-    // Write a packet, packet header, and optionally length if the packet is TCP to the given buffer.
-    Result<> encodePacket(Packet& packet, ByteBuffer& buffer);
+    // every UDP datagram starts with a sequence number, 0 is reserved for datagrams that are not part of a session (pings)
+    std::atomic<uint32_t> nextSendSeq = 1;
+    asp::Mutex<SequenceTracker> recvSeq;
+
+    // Write a packet, packet header, and either the length if the packet is TCP, or `seq` if it's UDP, to the given buffer.
+    Result<> encodePacket(Packet& packet, ByteBuffer& buffer, uint32_t seq = 0);
 
     // Decode a packet from a buffer
     Result<std::shared_ptr<Packet>> decodePacket(ByteBuffer& buffer);
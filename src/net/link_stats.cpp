@@ -0,0 +1,78 @@
+#include "link_stats.hpp"
+
+using Outcome = SequenceTracker::Outcome;
+
+Outcome SequenceTracker::record(uint32_t seq) {
+    if (!started) {
+        started = true;
+        highest = seq;
+        window = 1;
+        expected = 1;
+        received = 1;
+        return Outcome::InOrder;
+    }
+
+    // serial number arithmetic, positive if `seq` comes after `highest`
+    int32_t diff = static_cast<int32_t>(seq - highest);
+
+    // a jump this far in either direction means the server started counting again, keep the totals but not the sequence
+    if (diff >= MAX_REORDER_DISTANCE || diff <= -MAX_REORDER_DISTANCE) {
+        highest = seq;
+        window = 1;
+        expected++;
+        received++;
+        return Outcome::InOrder;
+    }
+
+    if (diff > 0) {
+        window = diff >= WINDOW_BITS ? 1 : (window << diff) | 1;
+        highest = seq;
+        expected += diff;
+        received++;
+        this->updateLossRate();
+        return Outcome::InOrder;
+    }
+
+    int32_t back = -diff;
+
+    if (back < WINDOW_BITS) {
+        uint64_t bit = uint64_t(1) << back;
+        if (window & bit) {
+            duplicated++;
+            return Outcome::Duplicate;
+        }
+
+        window |= bit;
+    }
+
+    // older than the window, can't tell if it's a duplicate so assume it's not
+    received++;
+    reordered++;
+    return Outcome::Reordered;
+}
+
+void SequenceTracker::reset() {
+    *this = SequenceTracker{};
+}
+
+LinkStats SequenceTracker::getStats() const {
+    return LinkStats {
+        .received = received,
+        .lost = expected > received ? expected - received : 0,
+        .reordered = reordered,
+        .duplicated = duplicated,
+        .lossRate = lossRate,
+    };
+}
+
+void SequenceTracker::updateLossRate() {
+    uint64_t intervalExp = expected - intervalExpected;
+    if (intervalExp < LOSS_INTERVAL) return;
+
+    // same as the "fraction lost" of RTCP receiver reports (RFC 3550), late arrivals from the previous interval can make it negative
+    uint64_t intervalRecv = received - intervalReceived;
+    lossRate = intervalRecv >= intervalExp ? 0.f : static_cast<float>(intervalExp - intervalRecv) / intervalExp;
+
+    intervalExpected = expected;
+    intervalReceived = received;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Counters for the UDP datagrams received from the active server
+struct LinkStats {
+    uint64_t received = 0;
+    uint64_t lost = 0;          // datagrams that have not arrived, ones that arrive late are subtracted again
+    uint64_t reordered = 0;     // datagrams that arrived after one with a higher sequence number
+    uint64_t duplicated = 0;
+    float lossRate = 0.f;       // fraction of datagrams lost over the last `SequenceTracker::LOSS_INTERVAL` expected ones
+};
+
+// Tracks the sequence numbers every UDP datagram is prefixed with, to detect loss, reordering and duplicates.
+// Sequence numbers are compared with wraparound in mind, so the counter can overflow freely.
+class SequenceTracker {
+public:
+    enum class Outcome : uint8_t {
+        InOrder,
+        Reordered,
+        Duplicate,
+    };
+
+    static constexpr uint64_t LOSS_INTERVAL = 128;
+
+    Outcome record(uint32_t seq);
+    void reset();
+
+    LinkStats getStats() const;
+
+private:
+    // a gap larger than this is assumed to be the start of a new sequence rather than loss or reordering
+    static constexpr int32_t MAX_REORDER_DISTANCE = 1024;
+    // only this many recent sequence numbers are remembered for detecting duplicates
+    static constexpr int32_t WINDOW_BITS = 64;
+
+    bool started = false;
+    uint32_t highest = 0;
+    // bit N is set if `highest - N` was received
+    uint64_t window = 0;
+
+    uint64_t expected = 0;
+    uint64_t received = 0;
+    uint64_t reordered = 0;
+    uint64_t duplicated = 0;
+
+    uint64_t intervalExpected = 0;
+    uint64_t intervalReceived = 0;
+    float lossRate = 0.f;
+
+    void updateLossRate();
+};
@@ -3,6 +3,7 @@
 #include "address.hpp"
 #include "listener.hpp"
 #include "game_socket.hpp"
+#include "clock_sync.hpp"
 
 #include <Geode/ui/GeodeUI.hpp>
 #include <asp/sync.hpp>
@@ -29,9 +30,9 @@ using namespace asp;
 using namespace geode::prelude;
 using ConnectionState = NetworkManager::ConnectionState;
 
-static constexpr uint16_t MIN_PROTOCOL_VERSION = 11;
-static constexpr uint16_t MAX_PROTOCOL_VERSION = 11;
-static constexpr std::array SUPPORTED_PROTOCOLS = std::to_array<uint16_t>({11});
+static constexpr uint16_t MIN_PROTOCOL_VERSION = 12;
+static constexpr uint16_t MAX_PROTOCOL_VERSION = 12;
+static constexpr std::array SUPPORTED_PROTOCOLS = std::to_array<uint16_t>({12});
 
 static bool isProtocolSupported(uint16_t proto) {
 #ifdef GLOBED_DEBUG
@@ -231,6 +232,17 @@ protected:
     util::time::time_point lastReceivedPacket;
     util::time::time_point lastSentKeepalive;
     util::time::time_point lastTcpExchange;
+    util::time::time_point lastSentClockSync;
+
+    // clock sync requests are sent more often right after connecting, until there is a usable estimate
+    static constexpr size_t CLOCK_SYNC_WARMUP_SAMPLES = 4;
+    static constexpr auto CLOCK_SYNC_WARMUP_INTERVAL = util::time::millis(250);
+    static constexpr auto CLOCK_SYNC_INTERVAL = util::time::millis(2000);
+
+    asp::Mutex<ClockEstimator> clockEstimator;
+    AtomicU32 nextClockSyncId;
+    // responses with a lower id were requested on an earlier connection
+    AtomicU32 firstClockSyncId;
 
     AtomicBool suspended;
     AtomicBool standalone;
@@ -299,6 +311,9 @@ protected:
         lastReceivedPacket = {};
         lastSentKeepalive = {};
         lastTcpExchange = {};
+        lastSentClockSync = {};
+        firstClockSyncId = nextClockSyncId.load();
+        clockEstimator.lock()->reset();
     }
 
     /* connection and tasks */
@@ -447,10 +462,10 @@ protected:
     }
 
     // adds a global listener, which always runs NOT on the main thread and always before other listeners
-    void addInternalListener(packetid_t id, PacketCallback&& callback) {
+    void addInternalListener(packetid_t id, PacketCallback&& callback, bool isFinal = false) {
         GlobalListener listener {
             .packetId = id,
-            .isFinal = false,
+            .isFinal = isFinal,
             .callback = std::move(callback),
         };
 
@@ -460,6 +475,10 @@ protected:
 #endif
     }
 
+    void removeInternalListener(packetid_t id) {
+        listeners.lock()->erase(id);
+    }
+
     template <HasPacketID Pty>
     void addInternalListener(PacketCallbackSpecific<Pty>&& callback) {
         this->addInternalListener(Pty::PACKET_ID, [cb = std::move(callback)](std::shared_ptr<Packet> packet) {
@@ -492,6 +511,14 @@ protected:
 
         addInternalListener<KeepaliveTCPResponsePacket>([](auto) {});
 
+        addInternalListener<ClockSyncResponsePacket>([this](auto packet) {
+            auto now = util::time::sinceEpochPrecise().count();
+
+            if (packet->id < firstClockSyncId.load()) return;
+
+            clockEstimator.lock()->addSample(packet->clientTime, packet->serverRecvTime, packet->serverSendTime, now);
+        });
+
         addInternalListener<ServerDisconnectPacket>([this](auto packet) {
             this->disconnectWithMessage(packet->message);
         });
@@ -781,6 +808,18 @@ protected:
         return established() ? serverTps.load() : 0;
     }
 
+    NetworkConditions getNetworkConditions() {
+        if (!established()) return {};
+
+        auto conditions = clockEstimator.lock()->getConditions();
+        conditions.loss = socket.getLinkStats().lossRate;
+        return conditions;
+    }
+
+    LinkStats getLinkStats() {
+        return established() ? socket.getLinkStats() : LinkStats{};
+    }
+
     uint16_t getServerProtocol() {
         return established() ? serverProtocol.load() : 0;
     }
@@ -826,6 +865,11 @@ protected:
         auto packet = std::move(packet__.packet);
         bool fromServer = packet__.fromConnected;
 
+        // duplicate datagram
+        if (!packet) {
+            return;
+        }
+
         packetid_t id = packet->getPacketId();
 
         if (id == PingResponsePacket::PACKET_ID) {
@@ -991,6 +1035,7 @@ protected:
 
         if (this->established()) {
             this->maybeSendKeepalive();
+            this->maybeSendClockSync();
         }
 
         // poll for any incoming packets
@@ -1033,6 +1078,25 @@ protected:
         }
     }
 
+    void maybeSendClockSync() {
+        auto now = util::time::now();
+
+        bool warmup = clockEstimator.lock()->getConditions().samples < CLOCK_SYNC_WARMUP_SAMPLES;
+        auto interval = warmup ? CLOCK_SYNC_WARMUP_INTERVAL : CLOCK_SYNC_INTERVAL;
+
+        if (now - lastSentClockSync < interval) return;
+
+        lastSentClockSync = now;
+
+        uint32_t id = nextClockSyncId.load();
+        nextClockSyncId.store(id + 1);
+
+        // sent directly rather than through the task queue, so that the time spent in the queue doesn't skew the measurement
+        this->handleSendPacketTask(TaskSendPacket {
+            .packet = ClockSyncPacket::create(id, util::time::sinceEpochPrecise().count())
+        });
+    }
+
     void sendKeepalive() {
         // send a keepalive
         this->send(KeepalivePacket::create());
@@ -1167,6 +1231,14 @@ void NetworkManager::removeListener(CCNode* target, packetid_t id) {
     impl->removeListener(target, id);
 }
 
+void NetworkManager::addThreadListener(packetid_t id, PacketCallback&& callback, bool isFinal) {
+    impl->addInternalListener(id, std::move(callback), isFinal);
+}
+
+void NetworkManager::removeThreadListener(packetid_t id) {
+    impl->removeInternalListener(id);
+}
+
 void NetworkManager::removeAllListeners() {
     impl->removeAllListeners();
 }
@@ -1183,6 +1255,14 @@ uint32_t NetworkManager::getServerTps() {
     return impl->getServerTps();
 }
 
+NetworkConditions NetworkManager::getNetworkConditions() {
+    return impl->getNetworkConditions();
+}
+
+LinkStats NetworkManager::getLinkStats() {
+    return impl->getLinkStats();
+}
+
 uint16_t NetworkManager::getServerProtocol() {
     return impl->getServerProtocol();
 }
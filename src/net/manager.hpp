@@ -4,6 +4,9 @@
 
 #include <util/singleton.hpp>
 
+#include "clock_sync.hpp"
+#include "link_stats.hpp"
+
 using packetid_t = uint16_t;
 
 class PacketListener;
@@ -92,6 +95,25 @@ public:
         this->removeListener(target, T::PACKET_ID);
     }
 
+    // Adds a listener that is called directly on the network thread, before any of the main thread listeners.
+    // There can only be one per packet ID, it replaces any existing one. With `isFinal` the packet does not reach the main thread listeners.
+    void addThreadListener(packetid_t id, PacketCallback&& callback, bool isFinal = true);
+
+    template <HasPacketID Pty>
+    void addThreadListener(PacketCallbackSpecific<Pty>&& callback, bool isFinal = true) {
+        this->addThreadListener(Pty::PACKET_ID, [callback = std::move(callback)](std::shared_ptr<Packet> pkt) {
+            callback(std::static_pointer_cast<Pty>(pkt));
+        }, isFinal);
+    }
+
+    // Removes a listener added with `addThreadListener`.
+    void removeThreadListener(packetid_t id);
+
+    template <HasPacketID T>
+    void removeThreadListener() {
+        this->removeThreadListener(T::PACKET_ID);
+    }
+
     // Removes all listeners.
     void removeAllListeners();
 
@@ -104,6 +126,13 @@ public:
     // Get the TPS of the currently connected server, or 0
     uint32_t getServerTps();
 
+    // Get the round trip time, jitter and clock offset measured on the current connection.
+    // Not valid when disconnected or if the server does not support clock synchronization.
+    NetworkConditions getNetworkConditions();
+
+    // Get the loss and reordering counters for UDP traffic received on the current connection.
+    LinkStats getLinkStats();
+
     // Get the maximum protocol version of the currently connected server
     uint16_t getServerProtocol();
 
@@ -2,8 +2,10 @@
 
 #ifdef GLOBED_ARM
 
+#include <util/math.hpp>
 #include <util/misc.hpp>
 #include <arm_neon.h>
+#include <algorithm>
 
 float globed::simd::arm::pcmVolume(const float* pcm, std::size_t samples) {
 #ifdef GLOBED_ARM64
@@ -32,4 +34,214 @@ float globed::simd::arm::pcmVolume(const float* pcm, std::size_t samples) {
 #endif
 }
 
-#endif
\ No newline at end of file
+float globed::simd::arm::pcmSumSquares(const float* pcm, std::size_t samples) {
+#ifdef GLOBED_ARM64
+    size_t alignedSamples = samples / 4 * 4;
+
+    float32x4_t sumVec = vdupq_n_f32(0.0f);
+
+    for (size_t i = 0; i < alignedSamples; i += 4) {
+        float32x4_t pcmVec = vld1q_f32(pcm + i);
+        sumVec = vmlaq_f32(sumVec, pcmVec, pcmVec);
+    }
+
+    float sum = vaddvq_f32(sumVec);
+
+    for (size_t i = alignedSamples; i < samples; i++) {
+        sum += pcm[i] * pcm[i];
+    }
+
+    return sum;
+#else
+    return util::misc::pcmSumSquaresSlow(pcm, samples);
+#endif
+}
+
+void globed::simd::arm::pcmMix(float* dest, const float* src, std::size_t samples, float gain) {
+#ifdef GLOBED_ARM64
+    size_t alignedSamples = samples / 4 * 4;
+
+    float32x4_t gainVec = vdupq_n_f32(gain);
+
+    for (size_t i = 0; i < alignedSamples; i += 4) {
+        float32x4_t destVec = vld1q_f32(dest + i);
+        destVec = vmlaq_f32(destVec, vld1q_f32(src + i), gainVec);
+        vst1q_f32(dest + i, destVec);
+    }
+
+    for (size_t i = alignedSamples; i < samples; i++) {
+        dest[i] += src[i] * gain;
+    }
+#else
+    util::misc::pcmMixSlow(dest, src, samples, gain);
+#endif
+}
+
+std::size_t globed::simd::arm::pcmZeroCrossings(const float* pcm, std::size_t samples) {
+#ifdef GLOBED_ARM64
+    if (samples < 2) return 0;
+
+    // compares sample i with sample i + 1, so the last vector may not read past the end
+    size_t pairs = samples - 1;
+    size_t alignedPairs = pairs / 4 * 4;
+
+    uint32x4_t countVec = vdupq_n_u32(0);
+
+    for (size_t i = 0; i < alignedPairs; i += 4) {
+        uint32x4_t cur = vreinterpretq_u32_f32(vld1q_f32(pcm + i));
+        uint32x4_t next = vreinterpretq_u32_f32(vld1q_f32(pcm + i + 1));
+        countVec = vaddq_u32(countVec, vshrq_n_u32(veorq_u32(cur, next), 31));
+    }
+
+    size_t count = vaddvq_u32(countVec);
+
+    for (size_t i = alignedPairs; i < pairs; i++) {
+        count += std::signbit(pcm[i]) != std::signbit(pcm[i + 1]);
+    }
+
+    return count;
+#else
+    return util::misc::pcmZeroCrossingsSlow(pcm, samples);
+#endif
+}
+
+void globed::simd::arm::pcmGain(float* pcm, std::size_t samples, float gain) {
+#ifdef GLOBED_ARM64
+    size_t alignedSamples = samples / 4 * 4;
+
+    for (size_t i = 0; i < alignedSamples; i += 4) {
+        vst1q_f32(pcm + i, vmulq_n_f32(vld1q_f32(pcm + i), gain));
+    }
+
+    for (size_t i = alignedSamples; i < samples; i++) {
+        pcm[i] *= gain;
+    }
+#else
+    util::misc::pcmGainSlow(pcm, samples, gain);
+#endif
+}
+
+void globed::simd::arm::pcmClamp(float* pcm, std::size_t samples, float limit) {
+#ifdef GLOBED_ARM64
+    size_t alignedSamples = samples / 4 * 4;
+
+    float32x4_t hi = vdupq_n_f32(limit);
+    float32x4_t lo = vdupq_n_f32(-limit);
+
+    for (size_t i = 0; i < alignedSamples; i += 4) {
+        vst1q_f32(pcm + i, vmaxq_f32(vminq_f32(vld1q_f32(pcm + i), hi), lo));
+    }
+
+    for (size_t i = alignedSamples; i < samples; i++) {
+        pcm[i] = std::clamp(pcm[i], -limit, limit);
+    }
+#else
+    util::misc::pcmClampSlow(pcm, samples, limit);
+#endif
+}
+
+void globed::simd::arm::pcmSoftClip(float* pcm, std::size_t samples) {
+#ifdef GLOBED_ARM64
+    size_t alignedSamples = samples / 4 * 4;
+
+    // same curve as `util::misc::pcmSoftClipSlow`
+    float32x4_t maxInput = vdupq_n_f32(64.f);
+    float32x4_t knee = vdupq_n_f32(0.8f);
+    float32x4_t range = vdupq_n_f32(0.2f);
+    float32x4_t zero = vdupq_n_f32(0.f);
+
+    for (size_t i = 0; i < alignedSamples; i += 4) {
+        float32x4_t x = vld1q_f32(pcm + i);
+        float32x4_t a = vminq_f32(vabsq_f32(x), maxInput);
+        float32x4_t over = vmaxq_f32(vsubq_f32(a, knee), zero);
+        float32x4_t squashed = vdivq_f32(vmulq_f32(over, range), vaddq_f32(range, over));
+        float32x4_t y = vaddq_f32(vminq_f32(a, knee), squashed);
+        // take the sign bit from x, everything else from y
+        vst1q_f32(pcm + i, vbslq_f32(vdupq_n_u32(0x80000000), x, y));
+    }
+
+    util::misc::pcmSoftClipSlow(pcm + alignedSamples, samples - alignedSamples);
+#else
+    util::misc::pcmSoftClipSlow(pcm, samples);
+#endif
+}
+
+float globed::simd::arm::pcmPeak(const float* pcm, std::size_t samples) {
+#ifdef GLOBED_ARM64
+    size_t alignedSamples = samples / 4 * 4;
+
+    float32x4_t maxVec = vdupq_n_f32(0.0f);
+
+    for (size_t i = 0; i < alignedSamples; i += 4) {
+        maxVec = vmaxq_f32(maxVec, vabsq_f32(vld1q_f32(pcm + i)));
+    }
+
+    float peak = vmaxvq_f32(maxVec);
+
+    for (size_t i = alignedSamples; i < samples; i++) {
+        peak = std::max(peak, std::abs(pcm[i]));
+    }
+
+    return peak;
+#else
+    return util::misc::pcmPeakSlow(pcm, samples);
+#endif
+}
+
+void globed::simd::arm::pcmToInt16(const float* pcm, int16_t* out, std::size_t samples) {
+#ifdef GLOBED_ARM64
+    size_t alignedSamples = samples / 8 * 8;
+
+    float32x4_t hi = vdupq_n_f32(1.f);
+    float32x4_t lo = vdupq_n_f32(-1.f);
+
+    for (size_t i = 0; i < alignedSamples; i += 8) {
+        float32x4_t a = vmulq_n_f32(vmaxq_f32(vminq_f32(vld1q_f32(pcm + i), hi), lo), 32767.f);
+        float32x4_t b = vmulq_n_f32(vmaxq_f32(vminq_f32(vld1q_f32(pcm + i + 4), hi), lo), 32767.f);
+        int16x8_t packed = vcombine_s16(vqmovn_s32(vcvtnq_s32_f32(a)), vqmovn_s32(vcvtnq_s32_f32(b)));
+        vst1q_s16(out + i, packed);
+    }
+
+    util::misc::pcmToInt16Slow(pcm + alignedSamples, out + alignedSamples, samples - alignedSamples);
+#else
+    util::misc::pcmToInt16Slow(pcm, out, samples);
+#endif
+}
+
+void globed::simd::arm::pcmFromInt16(const int16_t* in, float* pcm, std::size_t samples) {
+#ifdef GLOBED_ARM64
+    size_t alignedSamples = samples / 8 * 8;
+
+    constexpr float scale = 1.f / 32768.f;
+
+    for (size_t i = 0; i < alignedSamples; i += 8) {
+        int16x8_t v = vld1q_s16(in + i);
+        float32x4_t a = vcvtq_f32_s32(vmovl_s16(vget_low_s16(v)));
+        float32x4_t b = vcvtq_f32_s32(vmovl_s16(vget_high_s16(v)));
+        vst1q_f32(pcm + i, vmulq_n_f32(a, scale));
+        vst1q_f32(pcm + i + 4, vmulq_n_f32(b, scale));
+    }
+
+    util::misc::pcmFromInt16Slow(in + alignedSamples, pcm + alignedSamples, samples - alignedSamples);
+#else
+    util::misc::pcmFromInt16Slow(in, pcm, samples);
+#endif
+}
+
+void globed::simd::arm::lerpArrays(const float* from, const float* to, const float* ratio, float* out, std::size_t count) {
+#ifdef GLOBED_ARM64
+    size_t alignedCount = count / 4 * 4;
+
+    for (size_t i = 0; i < alignedCount; i += 4) {
+        float32x4_t a = vld1q_f32(from + i);
+        float32x4_t diff = vsubq_f32(vld1q_f32(to + i), a);
+        vst1q_f32(out + i, vaddq_f32(a, vmulq_f32(diff, vld1q_f32(ratio + i))));
+    }
+
+    util::math::lerpArraysSlow(from + alignedCount, to + alignedCount, ratio + alignedCount, out + alignedCount, count - alignedCount);
+#else
+    util::math::lerpArraysSlow(from, to, ratio, out, count);
+#endif
+}
+
+#endif
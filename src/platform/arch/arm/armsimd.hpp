@@ -5,9 +5,20 @@
 #ifdef GLOBED_ARM
 
 #include <cstddef>
+#include <cstdint>
 
 namespace globed::simd::arm {
     float pcmVolume(const float* pcm, std::size_t samples);
+    float pcmSumSquares(const float* pcm, std::size_t samples);
+    void pcmMix(float* dest, const float* src, std::size_t samples, float gain);
+    std::size_t pcmZeroCrossings(const float* pcm, std::size_t samples);
+    void pcmGain(float* pcm, std::size_t samples, float gain);
+    void pcmClamp(float* pcm, std::size_t samples, float limit);
+    void pcmSoftClip(float* pcm, std::size_t samples);
+    float pcmPeak(const float* pcm, std::size_t samples);
+    void pcmToInt16(const float* pcm, int16_t* out, std::size_t samples);
+    void pcmFromInt16(const int16_t* in, float* pcm, std::size_t samples);
+    void lerpArrays(const float* from, const float* to, const float* ratio, float* out, std::size_t count);
 }
 
 #endif
\ No newline at end of file
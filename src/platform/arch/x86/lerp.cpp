@@ -0,0 +1,51 @@
+#include "x86simd.hpp"
+
+#ifdef GLOBED_X86
+
+namespace globed::simd::x86 {
+    // out = from + (to - from) * ratio
+
+    void lerpArraysSSE(const float* from, const float* to, const float* ratio, float* out, size_t count) {
+        size_t alignedCount = count / 4 * 4;
+
+        for (size_t i = 0; i < alignedCount; i += 4) {
+            __m128 a = _mm_loadu_ps(from + i);
+            __m128 diff = _mm_sub_ps(_mm_loadu_ps(to + i), a);
+            _mm_storeu_ps(out + i, _mm_add_ps(a, _mm_mul_ps(diff, _mm_loadu_ps(ratio + i))));
+        }
+
+        for (size_t i = alignedCount; i < count; i++) {
+            out[i] = from[i] + (to[i] - from[i]) * ratio[i];
+        }
+    }
+
+    void GLOBED_FEATURE_AVX2 lerpArraysAVX2(const float* from, const float* to, const float* ratio, float* out, size_t count) {
+        size_t alignedCount = count / 8 * 8;
+
+        for (size_t i = 0; i < alignedCount; i += 8) {
+            __m256 a = _mm256_loadu_ps(from + i);
+            __m256 diff = _mm256_sub_ps(_mm256_loadu_ps(to + i), a);
+            _mm256_storeu_ps(out + i, _mm256_add_ps(a, _mm256_mul_ps(diff, _mm256_loadu_ps(ratio + i))));
+        }
+
+        for (size_t i = alignedCount; i < count; i++) {
+            out[i] = from[i] + (to[i] - from[i]) * ratio[i];
+        }
+    }
+
+    void GLOBED_FEATURE_AVX512 lerpArraysAVX512(const float* from, const float* to, const float* ratio, float* out, size_t count) {
+        size_t alignedCount = count / 16 * 16;
+
+        for (size_t i = 0; i < alignedCount; i += 16) {
+            __m512 a = _mm512_loadu_ps(from + i);
+            __m512 diff = _mm512_sub_ps(_mm512_loadu_ps(to + i), a);
+            _mm512_storeu_ps(out + i, _mm512_add_ps(a, _mm512_mul_ps(diff, _mm512_loadu_ps(ratio + i))));
+        }
+
+        for (size_t i = alignedCount; i < count; i++) {
+            out[i] = from[i] + (to[i] - from[i]) * ratio[i];
+        }
+    }
+}
+
+#endif
@@ -2,9 +2,31 @@
 
 #ifdef GLOBED_X86
 
+#include <algorithm>
+#include <bit>
 #include <cmath>
 
 namespace globed::simd::x86 {
+    namespace {
+        // scalar tails, must match the vector paths below
+        // soft clip curve, see `util::misc::pcmSoftClipSlow`
+        constexpr float SOFT_CLIP_KNEE = 0.8f;
+        constexpr float SOFT_CLIP_RANGE = 1.f - SOFT_CLIP_KNEE;
+        constexpr float SOFT_CLIP_MAX_INPUT = 64.f;
+
+        inline float softClipOne(float x) {
+            float a = std::min(std::abs(x), SOFT_CLIP_MAX_INPUT);
+            float over = std::max(a - SOFT_CLIP_KNEE, 0.f);
+            return std::copysign(std::min(a, SOFT_CLIP_KNEE) + over * SOFT_CLIP_RANGE / (SOFT_CLIP_RANGE + over), x);
+        }
+
+        inline int16_t toInt16One(float x) {
+            return static_cast<int16_t>(std::lrintf(std::clamp(x, -1.f, 1.f) * 32767.f));
+        }
+
+        constexpr float INT16_TO_FLOAT = 1.f / 32768.f;
+    }
+
     float pcmVolumeSSE(const float* pcm, size_t samples) {
         size_t alignedSamples = samples / 4 * 4;
 
@@ -66,6 +88,478 @@ namespace globed::simd::x86 {
 
         return sum / samples;
     }
+
+    float pcmSumSquaresSSE(const float* pcm, size_t samples) {
+        size_t alignedSamples = samples / 4 * 4;
+
+        __m128 sumVec = _mm_setzero_ps();
+
+        for (size_t i = 0; i < alignedSamples; i += 4) {
+            __m128 pcmVec = _mm_loadu_ps(pcm + i);
+            sumVec = _mm_add_ps(sumVec, _mm_mul_ps(pcmVec, pcmVec));
+        }
+
+        float sum = asp::simd::vec128sum(sumVec);
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            sum += pcm[i] * pcm[i];
+        }
+
+        return sum;
+    }
+
+    float GLOBED_FEATURE_AVX2 pcmSumSquaresAVX2(const float* pcm, size_t samples) {
+        size_t alignedSamples = samples / 8 * 8;
+
+        __m256 sumVec = _mm256_setzero_ps();
+
+        for (size_t i = 0; i < alignedSamples; i += 8) {
+            __m256 pcmVec = _mm256_loadu_ps(pcm + i);
+            sumVec = _mm256_add_ps(sumVec, _mm256_mul_ps(pcmVec, pcmVec));
+        }
+
+        float sum = vec256sum(sumVec);
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            sum += pcm[i] * pcm[i];
+        }
+
+        return sum;
+    }
+
+    float GLOBED_FEATURE_AVX512 pcmSumSquaresAVX512(const float* pcm, size_t samples) {
+        size_t alignedSamples = samples / 16 * 16;
+
+        __m512 sumVec = _mm512_setzero_ps();
+
+        for (size_t i = 0; i < alignedSamples; i += 16) {
+            __m512 pcmVec = _mm512_loadu_ps(pcm + i);
+            sumVec = _mm512_add_ps(sumVec, _mm512_mul_ps(pcmVec, pcmVec));
+        }
+
+        float sum = vec512sum(sumVec);
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            sum += pcm[i] * pcm[i];
+        }
+
+        return sum;
+    }
+
+    void pcmMixSSE(float* dest, const float* src, size_t samples, float gain) {
+        size_t alignedSamples = samples / 4 * 4;
+
+        __m128 gainVec = _mm_set1_ps(gain);
+
+        for (size_t i = 0; i < alignedSamples; i += 4) {
+            __m128 srcVec = _mm_mul_ps(_mm_loadu_ps(src + i), gainVec);
+            _mm_storeu_ps(dest + i, _mm_add_ps(_mm_loadu_ps(dest + i), srcVec));
+        }
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            dest[i] += src[i] * gain;
+        }
+    }
+
+    void GLOBED_FEATURE_AVX2 pcmMixAVX2(float* dest, const float* src, size_t samples, float gain) {
+        size_t alignedSamples = samples / 8 * 8;
+
+        __m256 gainVec = _mm256_set1_ps(gain);
+
+        for (size_t i = 0; i < alignedSamples; i += 8) {
+            __m256 srcVec = _mm256_mul_ps(_mm256_loadu_ps(src + i), gainVec);
+            _mm256_storeu_ps(dest + i, _mm256_add_ps(_mm256_loadu_ps(dest + i), srcVec));
+        }
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            dest[i] += src[i] * gain;
+        }
+    }
+
+    void GLOBED_FEATURE_AVX512 pcmMixAVX512(float* dest, const float* src, size_t samples, float gain) {
+        size_t alignedSamples = samples / 16 * 16;
+
+        __m512 gainVec = _mm512_set1_ps(gain);
+
+        for (size_t i = 0; i < alignedSamples; i += 16) {
+            __m512 srcVec = _mm512_mul_ps(_mm512_loadu_ps(src + i), gainVec);
+            _mm512_storeu_ps(dest + i, _mm512_add_ps(_mm512_loadu_ps(dest + i), srcVec));
+        }
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            dest[i] += src[i] * gain;
+        }
+    }
+
+    size_t pcmZeroCrossingsSSE(const float* pcm, size_t samples) {
+        if (samples < 2) return 0;
+
+        // compares sample i with sample i + 1, so the last vector may not read past the end
+        size_t pairs = samples - 1;
+        size_t alignedPairs = pairs / 4 * 4;
+
+        size_t count = 0;
+
+        for (size_t i = 0; i < alignedPairs; i += 4) {
+            __m128 cur = _mm_loadu_ps(pcm + i);
+            __m128 next = _mm_loadu_ps(pcm + i + 1);
+            count += std::popcount(static_cast<unsigned int>(_mm_movemask_ps(_mm_xor_ps(cur, next))));
+        }
+
+        for (size_t i = alignedPairs; i < pairs; i++) {
+            count += std::signbit(pcm[i]) != std::signbit(pcm[i + 1]);
+        }
+
+        return count;
+    }
+
+    size_t GLOBED_FEATURE_AVX2 pcmZeroCrossingsAVX2(const float* pcm, size_t samples) {
+        if (samples < 2) return 0;
+
+        size_t pairs = samples - 1;
+        size_t alignedPairs = pairs / 8 * 8;
+
+        size_t count = 0;
+
+        for (size_t i = 0; i < alignedPairs; i += 8) {
+            __m256 cur = _mm256_loadu_ps(pcm + i);
+            __m256 next = _mm256_loadu_ps(pcm + i + 1);
+            count += std::popcount(static_cast<unsigned int>(_mm256_movemask_ps(_mm256_xor_ps(cur, next))));
+        }
+
+        for (size_t i = alignedPairs; i < pairs; i++) {
+            count += std::signbit(pcm[i]) != std::signbit(pcm[i + 1]);
+        }
+
+        return count;
+    }
+
+    void pcmGainSSE(float* pcm, size_t samples, float gain) {
+        size_t alignedSamples = samples / 4 * 4;
+
+        __m128 gainVec = _mm_set1_ps(gain);
+
+        for (size_t i = 0; i < alignedSamples; i += 4) {
+            _mm_storeu_ps(pcm + i, _mm_mul_ps(_mm_loadu_ps(pcm + i), gainVec));
+        }
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            pcm[i] *= gain;
+        }
+    }
+
+    void GLOBED_FEATURE_AVX2 pcmGainAVX2(float* pcm, size_t samples, float gain) {
+        size_t alignedSamples = samples / 8 * 8;
+
+        __m256 gainVec = _mm256_set1_ps(gain);
+
+        for (size_t i = 0; i < alignedSamples; i += 8) {
+            _mm256_storeu_ps(pcm + i, _mm256_mul_ps(_mm256_loadu_ps(pcm + i), gainVec));
+        }
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            pcm[i] *= gain;
+        }
+    }
+
+    void GLOBED_FEATURE_AVX512 pcmGainAVX512(float* pcm, size_t samples, float gain) {
+        size_t alignedSamples = samples / 16 * 16;
+
+        __m512 gainVec = _mm512_set1_ps(gain);
+
+        for (size_t i = 0; i < alignedSamples; i += 16) {
+            _mm512_storeu_ps(pcm + i, _mm512_mul_ps(_mm512_loadu_ps(pcm + i), gainVec));
+        }
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            pcm[i] *= gain;
+        }
+    }
+
+    void pcmClampSSE(float* pcm, size_t samples, float limit) {
+        size_t alignedSamples = samples / 4 * 4;
+
+        __m128 hi = _mm_set1_ps(limit);
+        __m128 lo = _mm_set1_ps(-limit);
+
+        for (size_t i = 0; i < alignedSamples; i += 4) {
+            _mm_storeu_ps(pcm + i, _mm_max_ps(_mm_min_ps(_mm_loadu_ps(pcm + i), hi), lo));
+        }
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            pcm[i] = std::clamp(pcm[i], -limit, limit);
+        }
+    }
+
+    void GLOBED_FEATURE_AVX2 pcmClampAVX2(float* pcm, size_t samples, float limit) {
+        size_t alignedSamples = samples / 8 * 8;
+
+        __m256 hi = _mm256_set1_ps(limit);
+        __m256 lo = _mm256_set1_ps(-limit);
+
+        for (size_t i = 0; i < alignedSamples; i += 8) {
+            _mm256_storeu_ps(pcm + i, _mm256_max_ps(_mm256_min_ps(_mm256_loadu_ps(pcm + i), hi), lo));
+        }
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            pcm[i] = std::clamp(pcm[i], -limit, limit);
+        }
+    }
+
+    void GLOBED_FEATURE_AVX512 pcmClampAVX512(float* pcm, size_t samples, float limit) {
+        size_t alignedSamples = samples / 16 * 16;
+
+        __m512 hi = _mm512_set1_ps(limit);
+        __m512 lo = _mm512_set1_ps(-limit);
+
+        for (size_t i = 0; i < alignedSamples; i += 16) {
+            _mm512_storeu_ps(pcm + i, _mm512_max_ps(_mm512_min_ps(_mm512_loadu_ps(pcm + i), hi), lo));
+        }
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            pcm[i] = std::clamp(pcm[i], -limit, limit);
+        }
+    }
+
+    // y = x * (27 + x^2) / (27 + 9x^2), a pade approximation of tanh that hits exactly 1.0 at x = 3
+    void pcmSoftClipSSE(float* pcm, size_t samples) {
+        size_t alignedSamples = samples / 4 * 4;
+
+        __m128 signMask = _mm_set1_ps(-0.f);
+        __m128 maxInput = _mm_set1_ps(SOFT_CLIP_MAX_INPUT);
+        __m128 knee = _mm_set1_ps(SOFT_CLIP_KNEE);
+        __m128 range = _mm_set1_ps(SOFT_CLIP_RANGE);
+        __m128 zero = _mm_setzero_ps();
+
+        for (size_t i = 0; i < alignedSamples; i += 4) {
+            __m128 x = _mm_loadu_ps(pcm + i);
+            __m128 sign = _mm_and_ps(x, signMask);
+            __m128 a = _mm_min_ps(_mm_andnot_ps(signMask, x), maxInput);
+            __m128 over = _mm_max_ps(_mm_sub_ps(a, knee), zero);
+            __m128 squashed = _mm_div_ps(_mm_mul_ps(over, range), _mm_add_ps(range, over));
+            _mm_storeu_ps(pcm + i, _mm_or_ps(_mm_add_ps(_mm_min_ps(a, knee), squashed), sign));
+        }
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            pcm[i] = softClipOne(pcm[i]);
+        }
+    }
+
+    void GLOBED_FEATURE_AVX2 pcmSoftClipAVX2(float* pcm, size_t samples) {
+        size_t alignedSamples = samples / 8 * 8;
+
+        __m256 signMask = _mm256_set1_ps(-0.f);
+        __m256 maxInput = _mm256_set1_ps(SOFT_CLIP_MAX_INPUT);
+        __m256 knee = _mm256_set1_ps(SOFT_CLIP_KNEE);
+        __m256 range = _mm256_set1_ps(SOFT_CLIP_RANGE);
+        __m256 zero = _mm256_setzero_ps();
+
+        for (size_t i = 0; i < alignedSamples; i += 8) {
+            __m256 x = _mm256_loadu_ps(pcm + i);
+            __m256 sign = _mm256_and_ps(x, signMask);
+            __m256 a = _mm256_min_ps(_mm256_andnot_ps(signMask, x), maxInput);
+            __m256 over = _mm256_max_ps(_mm256_sub_ps(a, knee), zero);
+            __m256 squashed = _mm256_div_ps(_mm256_mul_ps(over, range), _mm256_add_ps(range, over));
+            _mm256_storeu_ps(pcm + i, _mm256_or_ps(_mm256_add_ps(_mm256_min_ps(a, knee), squashed), sign));
+        }
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            pcm[i] = softClipOne(pcm[i]);
+        }
+    }
+
+    void GLOBED_FEATURE_AVX512 pcmSoftClipAVX512(float* pcm, size_t samples) {
+        size_t alignedSamples = samples / 16 * 16;
+
+        // float and/or are avx512dq, so the sign is moved around as integers
+        __m512i signMask = _mm512_set1_epi32(static_cast<int>(0x80000000));
+        __m512 maxInput = _mm512_set1_ps(SOFT_CLIP_MAX_INPUT);
+        __m512 knee = _mm512_set1_ps(SOFT_CLIP_KNEE);
+        __m512 range = _mm512_set1_ps(SOFT_CLIP_RANGE);
+        __m512 zero = _mm512_setzero_ps();
+
+        for (size_t i = 0; i < alignedSamples; i += 16) {
+            __m512 x = _mm512_loadu_ps(pcm + i);
+            __m512i sign = _mm512_and_epi32(_mm512_castps_si512(x), signMask);
+            __m512 a = _mm512_min_ps(_mm512_abs_ps(x), maxInput);
+            __m512 over = _mm512_max_ps(_mm512_sub_ps(a, knee), zero);
+            __m512 squashed = _mm512_div_ps(_mm512_mul_ps(over, range), _mm512_add_ps(range, over));
+            __m512 y = _mm512_add_ps(_mm512_min_ps(a, knee), squashed);
+            _mm512_storeu_ps(pcm + i, _mm512_castsi512_ps(_mm512_or_epi32(_mm512_castps_si512(y), sign)));
+        }
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            pcm[i] = softClipOne(pcm[i]);
+        }
+    }
+
+    float pcmPeakSSE(const float* pcm, size_t samples) {
+        size_t alignedSamples = samples / 4 * 4;
+
+        __m128 maxVec = _mm_setzero_ps();
+        __m128 maskVec = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+
+        for (size_t i = 0; i < alignedSamples; i += 4) {
+            maxVec = _mm_max_ps(maxVec, _mm_and_ps(_mm_loadu_ps(pcm + i), maskVec));
+        }
+
+        maxVec = _mm_max_ps(maxVec, _mm_movehl_ps(maxVec, maxVec));
+        maxVec = _mm_max_ss(maxVec, _mm_shuffle_ps(maxVec, maxVec, 1));
+        float peak = _mm_cvtss_f32(maxVec);
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            peak = std::max(peak, std::abs(pcm[i]));
+        }
+
+        return peak;
+    }
+
+    float GLOBED_FEATURE_AVX2 pcmPeakAVX2(const float* pcm, size_t samples) {
+        size_t alignedSamples = samples / 8 * 8;
+
+        __m256 maxVec = _mm256_setzero_ps();
+        __m256 maskVec = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+
+        for (size_t i = 0; i < alignedSamples; i += 8) {
+            maxVec = _mm256_max_ps(maxVec, _mm256_and_ps(_mm256_loadu_ps(pcm + i), maskVec));
+        }
+
+        __m128 half = _mm_max_ps(_mm256_castps256_ps128(maxVec), _mm256_extractf128_ps(maxVec, 1));
+        half = _mm_max_ps(half, _mm_movehl_ps(half, half));
+        half = _mm_max_ss(half, _mm_shuffle_ps(half, half, 1));
+        float peak = _mm_cvtss_f32(half);
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            peak = std::max(peak, std::abs(pcm[i]));
+        }
+
+        return peak;
+    }
+
+    float GLOBED_FEATURE_AVX512 pcmPeakAVX512(const float* pcm, size_t samples) {
+        size_t alignedSamples = samples / 16 * 16;
+
+        __m512 maxVec = _mm512_setzero_ps();
+
+        for (size_t i = 0; i < alignedSamples; i += 16) {
+            maxVec = _mm512_max_ps(maxVec, _mm512_abs_ps(_mm512_loadu_ps(pcm + i)));
+        }
+
+        float peak = _mm512_reduce_max_ps(maxVec);
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            peak = std::max(peak, std::abs(pcm[i]));
+        }
+
+        return peak;
+    }
+
+    void pcmToInt16SSE(const float* pcm, int16_t* out, size_t samples) {
+        size_t alignedSamples = samples / 8 * 8;
+
+        __m128 hi = _mm_set1_ps(1.f);
+        __m128 lo = _mm_set1_ps(-1.f);
+        __m128 scale = _mm_set1_ps(32767.f);
+
+        for (size_t i = 0; i < alignedSamples; i += 8) {
+            __m128 a = _mm_mul_ps(_mm_max_ps(_mm_min_ps(_mm_loadu_ps(pcm + i), hi), lo), scale);
+            __m128 b = _mm_mul_ps(_mm_max_ps(_mm_min_ps(_mm_loadu_ps(pcm + i + 4), hi), lo), scale);
+            __m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+        }
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            out[i] = toInt16One(pcm[i]);
+        }
+    }
+
+    void GLOBED_FEATURE_AVX2 pcmToInt16AVX2(const float* pcm, int16_t* out, size_t samples) {
+        size_t alignedSamples = samples / 16 * 16;
+
+        __m256 hi = _mm256_set1_ps(1.f);
+        __m256 lo = _mm256_set1_ps(-1.f);
+        __m256 scale = _mm256_set1_ps(32767.f);
+
+        for (size_t i = 0; i < alignedSamples; i += 16) {
+            __m256 a = _mm256_mul_ps(_mm256_max_ps(_mm256_min_ps(_mm256_loadu_ps(pcm + i), hi), lo), scale);
+            __m256 b = _mm256_mul_ps(_mm256_max_ps(_mm256_min_ps(_mm256_loadu_ps(pcm + i + 8), hi), lo), scale);
+            // packs works per 128-bit lane, so the qwords end up as a0 b0 a1 b1 and need to be reordered
+            __m256i packed = _mm256_packs_epi32(_mm256_cvtps_epi32(a), _mm256_cvtps_epi32(b));
+            packed = _mm256_permute4x64_epi64(packed, 0xD8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), packed);
+        }
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            out[i] = toInt16One(pcm[i]);
+        }
+    }
+
+    void GLOBED_FEATURE_AVX512 pcmToInt16AVX512(const float* pcm, int16_t* out, size_t samples) {
+        size_t alignedSamples = samples / 16 * 16;
+
+        __m512 hi = _mm512_set1_ps(1.f);
+        __m512 lo = _mm512_set1_ps(-1.f);
+        __m512 scale = _mm512_set1_ps(32767.f);
+
+        for (size_t i = 0; i < alignedSamples; i += 16) {
+            __m512 a = _mm512_mul_ps(_mm512_max_ps(_mm512_min_ps(_mm512_loadu_ps(pcm + i), hi), lo), scale);
+            __m256i packed = _mm512_cvtsepi32_epi16(_mm512_cvtps_epi32(a));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), packed);
+        }
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            out[i] = toInt16One(pcm[i]);
+        }
+    }
+
+    void pcmFromInt16SSE(const int16_t* in, float* pcm, size_t samples) {
+        size_t alignedSamples = samples / 8 * 8;
+
+        __m128 scale = _mm_set1_ps(INT16_TO_FLOAT);
+
+        for (size_t i = 0; i < alignedSamples; i += 8) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            // sse2 has no sign extension instruction, unpack into the high half and shift back down
+            __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+            __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+            _mm_storeu_ps(pcm + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+            _mm_storeu_ps(pcm + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+        }
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            pcm[i] = static_cast<float>(in[i]) * INT16_TO_FLOAT;
+        }
+    }
+
+    void GLOBED_FEATURE_AVX2 pcmFromInt16AVX2(const int16_t* in, float* pcm, size_t samples) {
+        size_t alignedSamples = samples / 8 * 8;
+
+        __m256 scale = _mm256_set1_ps(INT16_TO_FLOAT);
+
+        for (size_t i = 0; i < alignedSamples; i += 8) {
+            __m256i v = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+            _mm256_storeu_ps(pcm + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+        }
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            pcm[i] = static_cast<float>(in[i]) * INT16_TO_FLOAT;
+        }
+    }
+
+    void GLOBED_FEATURE_AVX512 pcmFromInt16AVX512(const int16_t* in, float* pcm, size_t samples) {
+        size_t alignedSamples = samples / 16 * 16;
+
+        __m512 scale = _mm512_set1_ps(INT16_TO_FLOAT);
+
+        for (size_t i = 0; i < alignedSamples; i += 16) {
+            __m512i v = _mm512_cvtepi16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)));
+            _mm512_storeu_ps(pcm + i, _mm512_mul_ps(_mm512_cvtepi32_ps(v), scale));
+        }
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            pcm[i] = static_cast<float>(in[i]) * INT16_TO_FLOAT;
+        }
+    }
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -2,11 +2,6 @@
 
 #ifdef GLOBED_X86
 
-#include <defs/platform.hpp>
-#include <defs/minimal_geode.hpp>
-#include <util/misc.hpp>
-#include <util/crypto.hpp>
-
 namespace globed::simd::x86 {
     float GLOBED_FEATURE_AVX2 vec256sum(__m256 vec) {
         // https://copyprogramming.com/howto/how-to-sum-m256-horizontally
@@ -38,6 +33,124 @@ namespace globed::simd::x86 {
             return pcmVolumeSSE(pcm, samples);
         }
     }
+
+    float pcmSumSquares(const float* pcm, size_t samples) {
+        const auto& features = asp::simd::getFeatures();
+
+        if (features.avx512dq) {
+            return pcmSumSquaresAVX512(pcm, samples);
+        } else if (features.avx2) {
+            return pcmSumSquaresAVX2(pcm, samples);
+        } else {
+            return pcmSumSquaresSSE(pcm, samples);
+        }
+    }
+
+    void pcmMix(float* dest, const float* src, size_t samples, float gain) {
+        const auto& features = asp::simd::getFeatures();
+
+        if (features.avx512dq) {
+            pcmMixAVX512(dest, src, samples, gain);
+        } else if (features.avx2) {
+            pcmMixAVX2(dest, src, samples, gain);
+        } else {
+            pcmMixSSE(dest, src, samples, gain);
+        }
+    }
+
+    size_t pcmZeroCrossings(const float* pcm, size_t samples) {
+        const auto& features = asp::simd::getFeatures();
+
+        if (features.avx2) {
+            return pcmZeroCrossingsAVX2(pcm, samples);
+        } else {
+            return pcmZeroCrossingsSSE(pcm, samples);
+        }
+    }
+
+    void pcmGain(float* pcm, size_t samples, float gain) {
+        const auto& features = asp::simd::getFeatures();
+
+        if (features.avx512dq) {
+            pcmGainAVX512(pcm, samples, gain);
+        } else if (features.avx2) {
+            pcmGainAVX2(pcm, samples, gain);
+        } else {
+            pcmGainSSE(pcm, samples, gain);
+        }
+    }
+
+    void pcmClamp(float* pcm, size_t samples, float limit) {
+        const auto& features = asp::simd::getFeatures();
+
+        if (features.avx512dq) {
+            pcmClampAVX512(pcm, samples, limit);
+        } else if (features.avx2) {
+            pcmClampAVX2(pcm, samples, limit);
+        } else {
+            pcmClampSSE(pcm, samples, limit);
+        }
+    }
+
+    void pcmSoftClip(float* pcm, size_t samples) {
+        const auto& features = asp::simd::getFeatures();
+
+        if (features.avx512dq) {
+            pcmSoftClipAVX512(pcm, samples);
+        } else if (features.avx2) {
+            pcmSoftClipAVX2(pcm, samples);
+        } else {
+            pcmSoftClipSSE(pcm, samples);
+        }
+    }
+
+    float pcmPeak(const float* pcm, size_t samples) {
+        const auto& features = asp::simd::getFeatures();
+
+        if (features.avx512dq) {
+            return pcmPeakAVX512(pcm, samples);
+        } else if (features.avx2) {
+            return pcmPeakAVX2(pcm, samples);
+        } else {
+            return pcmPeakSSE(pcm, samples);
+        }
+    }
+
+    void pcmToInt16(const float* pcm, int16_t* out, size_t samples) {
+        const auto& features = asp::simd::getFeatures();
+
+        if (features.avx512dq) {
+            pcmToInt16AVX512(pcm, out, samples);
+        } else if (features.avx2) {
+            pcmToInt16AVX2(pcm, out, samples);
+        } else {
+            pcmToInt16SSE(pcm, out, samples);
+        }
+    }
+
+    void pcmFromInt16(const int16_t* in, float* pcm, size_t samples) {
+        const auto& features = asp::simd::getFeatures();
+
+        if (features.avx512dq) {
+            pcmFromInt16AVX512(in, pcm, samples);
+        } else if (features.avx2) {
+            pcmFromInt16AVX2(in, pcm, samples);
+        } else {
+            pcmFromInt16SSE(in, pcm, samples);
+        }
+    }
+
+    void lerpArrays(const float* from, const float* to, const float* ratio, float* out, size_t count) {
+        const auto& features = asp::simd::getFeatures();
+
+        if (features.avx512dq) {
+            lerpArraysAVX512(from, to, ratio, out, count);
+        } else if (features.avx2) {
+            lerpArraysAVX2(from, to, ratio, out, count);
+        } else {
+            lerpArraysSSE(from, to, ratio, out, count);
+        }
+    }
 }
 
 #endif
\ No newline at end of file
@@ -7,6 +7,7 @@
 
 #include <immintrin.h>
 #include <cstddef>
+#include <cstdint>
 
 // everything here was done just for fun and educational purposes don't judge me too harshly :D
 
@@ -38,6 +39,36 @@ namespace globed::simd::x86 {
     // Calculate the volume of pcm samples, picking the fastest possible implementation.
     float pcmVolume(const float* pcm, size_t samples);
 
+    // Calculate the sum of squares of pcm samples, picking the fastest possible implementation.
+    float pcmSumSquares(const float* pcm, size_t samples);
+
+    // Add `samples` samples from `src` multiplied by `gain` into `dest`, picking the fastest possible implementation.
+    void pcmMix(float* dest, const float* src, size_t samples, float gain);
+
+    // Count the sign changes between adjacent pcm samples, picking the fastest possible implementation.
+    size_t pcmZeroCrossings(const float* pcm, size_t samples);
+
+    // Multiply pcm samples by `gain` in place, picking the fastest possible implementation.
+    void pcmGain(float* pcm, size_t samples, float gain);
+
+    // Clamp pcm samples to [-limit, limit] in place, picking the fastest possible implementation.
+    void pcmClamp(float* pcm, size_t samples, float limit);
+
+    // Soft clip pcm samples in place (tanh-like curve, saturating at 3.0 -> 1.0), picking the fastest possible implementation.
+    void pcmSoftClip(float* pcm, size_t samples);
+
+    // Calculate the highest absolute value of pcm samples, picking the fastest possible implementation.
+    float pcmPeak(const float* pcm, size_t samples);
+
+    // Convert pcm samples to 16-bit integers (clamped, rounded to nearest), picking the fastest possible implementation.
+    void pcmToInt16(const float* pcm, int16_t* out, size_t samples);
+
+    // Convert 16-bit integer samples to floating point pcm, picking the fastest possible implementation.
+    void pcmFromInt16(const int16_t* in, float* pcm, size_t samples);
+
+    // Linearly interpolate between two arrays, with a separate ratio for every element, picking the fastest possible implementation.
+    void lerpArrays(const float* from, const float* to, const float* ratio, float* out, size_t count);
+
 
     /* Functions written with a specific algorithm */
 
@@ -45,6 +76,45 @@ namespace globed::simd::x86 {
     float pcmVolumeSSE(const float* pcm, size_t samples);
     float GLOBED_FEATURE_AVX2 pcmVolumeAVX2(const float* pcm, size_t samples);
     float GLOBED_FEATURE_AVX512DQ pcmVolumeAVX512(const float* pcm, size_t samples);
+
+    float pcmSumSquaresSSE(const float* pcm, size_t samples);
+    float GLOBED_FEATURE_AVX2 pcmSumSquaresAVX2(const float* pcm, size_t samples);
+    float GLOBED_FEATURE_AVX512 pcmSumSquaresAVX512(const float* pcm, size_t samples);
+
+    void pcmMixSSE(float* dest, const float* src, size_t samples, float gain);
+    void GLOBED_FEATURE_AVX2 pcmMixAVX2(float* dest, const float* src, size_t samples, float gain);
+    void GLOBED_FEATURE_AVX512 pcmMixAVX512(float* dest, const float* src, size_t samples, float gain);
+
+    size_t pcmZeroCrossingsSSE(const float* pcm, size_t samples);
+    size_t GLOBED_FEATURE_AVX2 pcmZeroCrossingsAVX2(const float* pcm, size_t samples);
+
+    void pcmGainSSE(float* pcm, size_t samples, float gain);
+    void GLOBED_FEATURE_AVX2 pcmGainAVX2(float* pcm, size_t samples, float gain);
+    void GLOBED_FEATURE_AVX512 pcmGainAVX512(float* pcm, size_t samples, float gain);
+
+    void pcmClampSSE(float* pcm, size_t samples, float limit);
+    void GLOBED_FEATURE_AVX2 pcmClampAVX2(float* pcm, size_t samples, float limit);
+    void GLOBED_FEATURE_AVX512 pcmClampAVX512(float* pcm, size_t samples, float limit);
+
+    void pcmSoftClipSSE(float* pcm, size_t samples);
+    void GLOBED_FEATURE_AVX2 pcmSoftClipAVX2(float* pcm, size_t samples);
+    void GLOBED_FEATURE_AVX512 pcmSoftClipAVX512(float* pcm, size_t samples);
+
+    float pcmPeakSSE(const float* pcm, size_t samples);
+    float GLOBED_FEATURE_AVX2 pcmPeakAVX2(const float* pcm, size_t samples);
+    float GLOBED_FEATURE_AVX512 pcmPeakAVX512(const float* pcm, size_t samples);
+
+    void pcmToInt16SSE(const float* pcm, int16_t* out, size_t samples);
+    void GLOBED_FEATURE_AVX2 pcmToInt16AVX2(const float* pcm, int16_t* out, size_t samples);
+    void GLOBED_FEATURE_AVX512 pcmToInt16AVX512(const float* pcm, int16_t* out, size_t samples);
+
+    void pcmFromInt16SSE(const int16_t* in, float* pcm, size_t samples);
+    void GLOBED_FEATURE_AVX2 pcmFromInt16AVX2(const int16_t* in, float* pcm, size_t samples);
+    void GLOBED_FEATURE_AVX512 pcmFromInt16AVX512(const int16_t* in, float* pcm, size_t samples);
+
+    void lerpArraysSSE(const float* from, const float* to, const float* ratio, float* out, size_t count);
+    void GLOBED_FEATURE_AVX2 lerpArraysAVX2(const float* from, const float* to, const float* ratio, float* out, size_t count);
+    void GLOBED_FEATURE_AVX512 lerpArraysAVX512(const float* from, const float* to, const float* ratio, float* out, size_t count);
 }
 
 #endif
\ No newline at end of file
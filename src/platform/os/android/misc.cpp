@@ -3,6 +3,7 @@
 #include <util/crypto.hpp>
 
 #include <android/configuration.h>
+#include <malloc.h>
 
 using util::misc::UniqueIdent;
 
@@ -32,3 +33,7 @@ Result<UniqueIdent> util::misc::fingerprintImpl() {
 
     return Ok(UniqueIdent(arr));
 }
+
+size_t util::misc::heapUsage() {
+    return mallinfo().uordblks;
+}
@@ -1,8 +1,16 @@
 #include <defs/minimal_geode.hpp>
 #include <util/misc.hpp>
 
+#include <malloc/malloc.h>
+
 using util::misc::UniqueIdent;
 
 Result<UniqueIdent> util::misc::fingerprintImpl() {
     return Err("Unimplemented");
 }
+
+size_t util::misc::heapUsage() {
+    malloc_statistics_t stats;
+    malloc_zone_statistics(nullptr, &stats);
+    return stats.size_in_use;
+}
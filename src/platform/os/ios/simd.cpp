@@ -5,3 +5,43 @@
 float util::simd::calcPcmVolume(const float* pcm, size_t samples) {
     return globed::simd::arm::pcmVolume(pcm, samples);
 }
+
+float util::simd::calcPcmSumSquares(const float* pcm, size_t samples) {
+    return globed::simd::arm::pcmSumSquares(pcm, samples);
+}
+
+void util::simd::mixPcm(float* dest, const float* src, size_t samples, float gain) {
+    globed::simd::arm::pcmMix(dest, src, samples, gain);
+}
+
+size_t util::simd::countPcmZeroCrossings(const float* pcm, size_t samples) {
+    return globed::simd::arm::pcmZeroCrossings(pcm, samples);
+}
+
+void util::simd::applyPcmGain(float* pcm, size_t samples, float gain) {
+    globed::simd::arm::pcmGain(pcm, samples, gain);
+}
+
+void util::simd::clampPcm(float* pcm, size_t samples, float limit) {
+    globed::simd::arm::pcmClamp(pcm, samples, limit);
+}
+
+void util::simd::softClipPcm(float* pcm, size_t samples) {
+    globed::simd::arm::pcmSoftClip(pcm, samples);
+}
+
+float util::simd::calcPcmPeak(const float* pcm, size_t samples) {
+    return globed::simd::arm::pcmPeak(pcm, samples);
+}
+
+void util::simd::pcmToInt16(const float* pcm, int16_t* out, size_t samples) {
+    globed::simd::arm::pcmToInt16(pcm, out, samples);
+}
+
+void util::simd::pcmFromInt16(const int16_t* in, float* pcm, size_t samples) {
+    globed::simd::arm::pcmFromInt16(in, pcm, samples);
+}
+
+void util::simd::lerpArrays(const float* from, const float* to, const float* ratio, float* out, size_t count) {
+    globed::simd::arm::lerpArrays(from, to, ratio, out, count);
+}
@@ -5,6 +5,7 @@
 
 #include <CoreFoundation/CoreFoundation.h>
 #include <IOKit/IOKitLib.h>
+#include <malloc/malloc.h>
 
 using util::misc::UniqueIdent;
 
@@ -40,3 +41,9 @@ Result<UniqueIdent> util::misc::fingerprintImpl() {
 
     return Ok(UniqueIdent(arr));
 }
+
+size_t util::misc::heapUsage() {
+    malloc_statistics_t stats;
+    malloc_zone_statistics(nullptr, &stats);
+    return stats.size_in_use;
+}
@@ -16,3 +16,83 @@ float util::simd::calcPcmVolume(const float *pcm, size_t samples) {
     return globed::simd::x86::pcmVolume(pcm, samples);
 #endif
 }
+
+float util::simd::calcPcmSumSquares(const float* pcm, size_t samples) {
+#ifdef GEODE_IS_ARM_MAC
+    return globed::simd::arm::pcmSumSquares(pcm, samples);
+#else
+    return globed::simd::x86::pcmSumSquares(pcm, samples);
+#endif
+}
+
+void util::simd::mixPcm(float* dest, const float* src, size_t samples, float gain) {
+#ifdef GEODE_IS_ARM_MAC
+    globed::simd::arm::pcmMix(dest, src, samples, gain);
+#else
+    globed::simd::x86::pcmMix(dest, src, samples, gain);
+#endif
+}
+
+size_t util::simd::countPcmZeroCrossings(const float* pcm, size_t samples) {
+#ifdef GEODE_IS_ARM_MAC
+    return globed::simd::arm::pcmZeroCrossings(pcm, samples);
+#else
+    return globed::simd::x86::pcmZeroCrossings(pcm, samples);
+#endif
+}
+
+void util::simd::applyPcmGain(float* pcm, size_t samples, float gain) {
+#ifdef GEODE_IS_ARM_MAC
+    globed::simd::arm::pcmGain(pcm, samples, gain);
+#else
+    globed::simd::x86::pcmGain(pcm, samples, gain);
+#endif
+}
+
+void util::simd::clampPcm(float* pcm, size_t samples, float limit) {
+#ifdef GEODE_IS_ARM_MAC
+    globed::simd::arm::pcmClamp(pcm, samples, limit);
+#else
+    globed::simd::x86::pcmClamp(pcm, samples, limit);
+#endif
+}
+
+void util::simd::softClipPcm(float* pcm, size_t samples) {
+#ifdef GEODE_IS_ARM_MAC
+    globed::simd::arm::pcmSoftClip(pcm, samples);
+#else
+    globed::simd::x86::pcmSoftClip(pcm, samples);
+#endif
+}
+
+float util::simd::calcPcmPeak(const float* pcm, size_t samples) {
+#ifdef GEODE_IS_ARM_MAC
+    return globed::simd::arm::pcmPeak(pcm, samples);
+#else
+    return globed::simd::x86::pcmPeak(pcm, samples);
+#endif
+}
+
+void util::simd::pcmToInt16(const float* pcm, int16_t* out, size_t samples) {
+#ifdef GEODE_IS_ARM_MAC
+    globed::simd::arm::pcmToInt16(pcm, out, samples);
+#else
+    globed::simd::x86::pcmToInt16(pcm, out, samples);
+#endif
+}
+
+void util::simd::pcmFromInt16(const int16_t* in, float* pcm, size_t samples) {
+#ifdef GEODE_IS_ARM_MAC
+    globed::simd::arm::pcmFromInt16(in, pcm, samples);
+#else
+    globed::simd::x86::pcmFromInt16(in, pcm, samples);
+#endif
+}
+
+void util::simd::lerpArrays(const float* from, const float* to, const float* ratio, float* out, size_t count) {
+#ifdef GEODE_IS_ARM_MAC
+    globed::simd::arm::lerpArrays(from, to, ratio, out, count);
+#else
+    globed::simd::x86::lerpArrays(from, to, ratio, out, count);
+#endif
+}
@@ -227,3 +227,21 @@ Result<UniqueIdent> util::misc::fingerprintImpl() {
 
     return Ok(UniqueIdent(arr));
 }
+
+size_t util::misc::heapUsage() {
+    // the CRT allocates from the process heap, walking it visits every block so this takes a while
+    HANDLE heap = GetProcessHeap();
+    if (!HeapLock(heap)) return 0;
+
+    size_t total = 0;
+    PROCESS_HEAP_ENTRY entry{};
+    while (HeapWalk(heap, &entry)) {
+        if (entry.wFlags & PROCESS_HEAP_ENTRY_BUSY) {
+            total += entry.cbData;
+        }
+    }
+
+    HeapUnlock(heap);
+
+    return total;
+}
@@ -6,3 +6,43 @@
 float util::simd::calcPcmVolume(const float *pcm, size_t samples) {
     return globed::simd::x86::pcmVolume(pcm, samples);
 }
+
+float util::simd::calcPcmSumSquares(const float* pcm, size_t samples) {
+    return globed::simd::x86::pcmSumSquares(pcm, samples);
+}
+
+void util::simd::mixPcm(float* dest, const float* src, size_t samples, float gain) {
+    globed::simd::x86::pcmMix(dest, src, samples, gain);
+}
+
+size_t util::simd::countPcmZeroCrossings(const float* pcm, size_t samples) {
+    return globed::simd::x86::pcmZeroCrossings(pcm, samples);
+}
+
+void util::simd::applyPcmGain(float* pcm, size_t samples, float gain) {
+    globed::simd::x86::pcmGain(pcm, samples, gain);
+}
+
+void util::simd::clampPcm(float* pcm, size_t samples, float limit) {
+    globed::simd::x86::pcmClamp(pcm, samples, limit);
+}
+
+void util::simd::softClipPcm(float* pcm, size_t samples) {
+    globed::simd::x86::pcmSoftClip(pcm, samples);
+}
+
+float util::simd::calcPcmPeak(const float* pcm, size_t samples) {
+    return globed::simd::x86::pcmPeak(pcm, samples);
+}
+
+void util::simd::pcmToInt16(const float* pcm, int16_t* out, size_t samples) {
+    globed::simd::x86::pcmToInt16(pcm, out, samples);
+}
+
+void util::simd::pcmFromInt16(const int16_t* in, float* pcm, size_t samples) {
+    globed::simd::x86::pcmFromInt16(in, pcm, samples);
+}
+
+void util::simd::lerpArrays(const float* from, const float* to, const float* ratio, float* out, size_t count) {
+    globed::simd::x86::lerpArrays(from, to, ratio, out, count);
+}
@@ -0,0 +1,21 @@
+#include "base_visual_player.hpp"
+
+RemotePlayer* BaseVisualPlayer::getRemotePlayer() {
+    return parent;
+}
+
+void BaseVisualPlayer::setP1StickyState(bool state) {
+    p1sticky = state;
+}
+
+void BaseVisualPlayer::setP2StickyState(bool state) {
+    p2sticky = state;
+}
+
+bool BaseVisualPlayer::getP1StickyState() {
+    return p1sticky;
+}
+
+bool BaseVisualPlayer::getP2StickyState() {
+    return p2sticky;
+}
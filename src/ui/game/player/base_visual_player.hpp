@@ -0,0 +1,53 @@
+#pragma once
+
+#include <defs/geode.hpp>
+#include <game/visual_state.hpp>
+#include <game/visibility.hpp>
+#include <data/types/gd.hpp>
+#include <data/types/game.hpp>
+
+class RemotePlayer;
+
+// One icon of a remote player. `ComplexVisualPlayer` is backed by a full `PlayerObject`, which collision and
+// 2 player mode need, while `LightVisualPlayer` only uses sprites.
+class BaseVisualPlayer : public cocos2d::CCNode {
+public:
+    static constexpr int SPIDER_DASH_CIRCLE_WAVE_TAG = 234562345;
+    static constexpr int SPIDER_DASH_SPRITE_TAG = 234562347;
+    static constexpr int DEATH_EFFECT_TAG = 234562349;
+
+    virtual void updateIcons(const PlayerIconData& icons) = 0;
+    virtual void updateData(
+        const SpecificIconData& data,
+        const VisualPlayerState& playerData,
+        VisibilityTier tier,
+        bool isSpeaking,
+        float loudness
+    ) = 0;
+    // only moves the icon, for players that are far away from the camera
+    virtual void updatePosition(const SpecificIconData& data) = 0;
+    // stops running animations and forgets the animation state, when the node gets reused for another player
+    virtual void resetState() = 0;
+    virtual void playDeathEffect() = 0;
+    virtual void playSpiderTeleport(const SpiderTeleportData& data) = 0;
+    virtual void playJump() = 0;
+    virtual void setForciblyHidden(bool state) = 0;
+    virtual const cocos2d::CCPoint& getPlayerPosition() = 0;
+    // null for lightweight players
+    virtual PlayerObject* getPlayerObject() = 0;
+
+    RemotePlayer* getRemotePlayer();
+
+    void setP1StickyState(bool state);
+    void setP2StickyState(bool state);
+
+    bool getP1StickyState();
+    bool getP2StickyState();
+
+protected:
+    RemotePlayer* parent = nullptr;
+    bool isSecond = false;
+
+    // used for player collision stickiness
+    bool p1sticky = false, p2sticky = false;
+};
@@ -19,7 +19,6 @@ bool ComplexVisualPlayer::init(RemotePlayer* parent, bool isSecond) {
 
     this->gameLayer = GJBaseGameLayer::get();
     this->isPlatformer = gameLayer->m_level->isPlatformer();
-    this->isEditor = typeinfo_cast<LevelEditorLayer*>(this->gameLayer) != nullptr;
 
     auto& data = parent->getAccountData();
 
@@ -124,7 +123,7 @@ void ComplexVisualPlayer::updateIcons(const PlayerIconData& icons) {
 void ComplexVisualPlayer::updateData(
         const SpecificIconData& data,
         const VisualPlayerState& playerData,
-        const GameCameraState& camState,
+        VisibilityTier tier,
         bool isSpeaking,
         float loudness
 ) {
@@ -132,7 +131,7 @@ void ComplexVisualPlayer::updateData(
 
     wasRotating = data.isRotating;
 
-    bool isNearby = this->isPlayerNearby(camState);
+    bool isNearby = tier != VisibilityTier::Far;
     bool cameNearby = isNearby && !wasNearby;
     wasNearby = isNearby;
 
@@ -173,27 +172,25 @@ void ComplexVisualPlayer::updateData(
         this->cancelPlatformerJumpAnim();
     }
 
-    auto dirVec = GlobedGJBGL::getCameraDirectionVector();
-    auto dir = GlobedGJBGL::getCameraDirectionAngle();
+    // set the pos for status icons and name (ask rob not me), off screen they get updated once the player comes into view
+    if (tier == VisibilityTier::Visible) {
+        auto dirVec = GlobedGJBGL::getCameraDirectionVector();
+        auto dir = GlobedGJBGL::getCameraDirectionAngle();
 
-    // set the pos for status icons and name (ask rob not me)
-    nameLabel->setPosition(data.position + dirVec * CCPoint{25.f, 25.f});
-    nameLabel->setRotation(dir);
+        nameLabel->setPosition(data.position + dirVec * CCPoint{25.f, 25.f});
+        nameLabel->setRotation(dir);
 
-    if (statusIcons) {
-        statusIcons->setPosition(data.position + dirVec * CCPoint{nameLabel->isVisible() ? 40.f : 25.f, nameLabel->isVisible() ? 40.f : 25.f});
-        statusIcons->setRotation(dir);
+        if (statusIcons) {
+            statusIcons->setPosition(data.position + dirVec * CCPoint{nameLabel->isVisible() ? 40.f : 25.f, nameLabel->isVisible() ? 40.f : 25.f});
+            statusIcons->setRotation(dir);
+        }
     }
 
     if (!playerData.isDead && playerIcon->getOpacity() == 0) {
         this->updateOpacity();
     }
 
-    // set position members for collision
-    playerIcon->m_startPosition = data.position;
-    playerIcon->m_lastPosition = data.position;
-    playerIcon->m_positionX = data.position.x;
-    playerIcon->m_positionY = data.position.y;
+    this->setCollisionPosition(data.position);
 
     PlayerIconType iconType = data.iconType;
 
@@ -332,6 +329,44 @@ void ComplexVisualPlayer::updateData(
     }
 }
 
+void ComplexVisualPlayer::updatePosition(const SpecificIconData& data) {
+    wasNearby = false;
+    wasRotating = data.isRotating;
+
+    playerIcon->setPosition(data.position);
+    playerIcon->setRotation(data.rotation);
+
+    this->setCollisionPosition(data.position);
+}
+
+void ComplexVisualPlayer::resetState() {
+    this->stopAllActions();
+    playerIcon->stopAllActions();
+    this->cancelPlatformerJumpAnim();
+
+    wasGrounded = false;
+    wasStationary = true;
+    wasFalling = false;
+    tpColorDelta = 0.f;
+    wasUpsideDown = false;
+    wasRotating = false;
+    wasDashing = false;
+    wasNearby = false;
+    p1sticky = p2sticky = false;
+
+    playerIcon->setPosition({0.f, 0.f});
+    playerIcon->setRotation(0.f);
+    this->setCollisionPosition({0.f, 0.f});
+}
+
+void ComplexVisualPlayer::setCollisionPosition(const CCPoint& position) {
+    // set position members for collision
+    playerIcon->m_startPosition = position;
+    playerIcon->m_lastPosition = position;
+    playerIcon->m_positionX = position.x;
+    playerIcon->m_positionY = position.y;
+}
+
 void ComplexVisualPlayer::updateIconType(PlayerIconType newType) {
     PlayerIconType oldType = playerIconType;
     playerIconType = newType;
@@ -669,30 +704,10 @@ const CCPoint& ComplexVisualPlayer::getPlayerPosition() {
     return playerIcon->getPosition();
 }
 
-CCNode* ComplexVisualPlayer::getPlayerObject() {
+PlayerObject* ComplexVisualPlayer::getPlayerObject() {
     return playerIcon;
 }
 
-RemotePlayer* ComplexVisualPlayer::getRemotePlayer() {
-    return parent;
-}
-
-void ComplexVisualPlayer::setP1StickyState(bool state) {
-    p1sticky = state;
-}
-
-void ComplexVisualPlayer::setP2StickyState(bool state) {
-    p2sticky = state;
-}
-
-bool ComplexVisualPlayer::getP1StickyState() {
-    return p1sticky;
-}
-
-bool ComplexVisualPlayer::getP2StickyState() {
-    return p2sticky;
-}
-
 void ComplexVisualPlayer::tryLoadIconsAsync() {
     if (iconsLoaded != 0) return;
     auto* gm = GameManager::get();
@@ -783,34 +798,6 @@ void ComplexVisualPlayer::disableTrail() {
     // playerIcon->fadeOutStreak2(0.2f);
 }
 
-bool ComplexVisualPlayer::isPlayerNearby(const GameCameraState& camState) {
-    // always render them in editor (cause im lazy)
-    if (isEditor) return true;
-
-    // check if they are inside 3 screens
-    constexpr float fullScaleMult = 3.f;
-    constexpr float originMoveMult = (fullScaleMult - 1.f) / 2.f; // magic
-    CCSize origCoverage = camState.cameraCoverage();
-    CCSize cameraCoverage = origCoverage * fullScaleMult;
-    CCPoint cameraOrigin = camState.cameraOrigin - origCoverage * originMoveMult;
-
-    float cameraLeft = cameraOrigin.x;
-    float cameraRight = cameraOrigin.x + cameraCoverage.width;
-    float cameraBottom = cameraOrigin.y;
-    float cameraTop = cameraOrigin.y + cameraCoverage.height;
-
-    const auto& playerPosition = this->getPlayerPosition();
-
-    bool inCameraCoverage = (
-        playerPosition.x >= cameraLeft &&
-        playerPosition.x <= cameraRight &&
-        playerPosition.y >= cameraBottom &&
-        playerPosition.y <= cameraTop
-    );
-
-    return inCameraCoverage;
-}
-
 ComplexVisualPlayer* ComplexVisualPlayer::create(RemotePlayer* parent, bool isSecond) {
     auto ret = new ComplexVisualPlayer;
     if (ret->init(parent, isSecond)) {
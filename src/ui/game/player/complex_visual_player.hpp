@@ -1,44 +1,31 @@
 #pragma once
 
+#include "base_visual_player.hpp"
 #include "status_icons.hpp"
 #include <hooks/player_object.hpp>
-#include <game/visual_state.hpp>
 #include <game/camera_state.hpp>
-#include <data/types/gd.hpp>
-#include <data/types/game.hpp>
 #include <ui/general/name_label.hpp>
 
-class RemotePlayer;
-
-class ComplexVisualPlayer : public cocos2d::CCNode {
+class ComplexVisualPlayer : public BaseVisualPlayer {
 public:
-    static constexpr int SPIDER_DASH_CIRCLE_WAVE_TAG = 234562345;
-    static constexpr int SPIDER_DASH_SPRITE_TAG = 234562347;
-    static constexpr int DEATH_EFFECT_TAG = 234562349;
-
     bool init(RemotePlayer* parent, bool isSecond);
-    void updateIcons(const PlayerIconData& icons);
+    void updateIcons(const PlayerIconData& icons) override;
     void updateData(
         const SpecificIconData& data,
         const VisualPlayerState& playerData,
-        const GameCameraState& camState,
+        VisibilityTier tier,
         bool isSpeaking,
         float loudness
-    );
+    ) override;
+    void updatePosition(const SpecificIconData& data) override;
+    void resetState() override;
     void updateIconType(PlayerIconType newType);
-    void playDeathEffect();
-    void playSpiderTeleport(const SpiderTeleportData& data);
-    void playJump();
-    void setForciblyHidden(bool state);
-    const cocos2d::CCPoint& getPlayerPosition();
-    cocos2d::CCNode* getPlayerObject();
-    RemotePlayer* getRemotePlayer();
-
-    void setP1StickyState(bool state);
-    void setP2StickyState(bool state);
-
-    bool getP1StickyState();
-    bool getP2StickyState();
+    void playDeathEffect() override;
+    void playSpiderTeleport(const SpiderTeleportData& data) override;
+    void playJump() override;
+    void setForciblyHidden(bool state) override;
+    const cocos2d::CCPoint& getPlayerPosition() override;
+    PlayerObject* getPlayerObject() override;
 
     void updatePlayerObjectIcons(bool skipFrames = false);
     void toggleAllOff();
@@ -50,9 +37,6 @@ public:
 protected:
     friend class ComplexPlayerObject;
     friend class RemotePlayer;
-    RemotePlayer* parent;
-
-    bool isSecond;
 
     GJBaseGameLayer* gameLayer;
     ComplexPlayerObject* playerIcon;
@@ -60,7 +44,6 @@ protected:
     PlayerIconType playerIconType = PlayerIconType::Unknown;
     Ref<PlayerStatusIcons> statusIcons;
     bool isPlatformer;
-    bool isEditor;
 
     // these 3 used in robot and spider anims
     bool wasGrounded = false;
@@ -90,9 +73,6 @@ protected:
     // uhh yeah forcibly hiding players
     bool isForciblyHidden = false;
 
-    // used for player collision stickiness
-    bool p1sticky = false, p2sticky = false;
-
     PlayerIconData storedIcons;
 
     // used for async icon loading
@@ -130,5 +110,5 @@ protected:
     void enableTrail();
     void disableTrail();
 
-    bool isPlayerNearby(const GameCameraState& camState);
+    void setCollisionPosition(const cocos2d::CCPoint& position);
 };
\ No newline at end of file
@@ -0,0 +1,291 @@
+#include "light_visual_player.hpp"
+
+#include "remote_player.hpp"
+#include <hooks/gjbasegamelayer.hpp>
+#include <managers/settings.hpp>
+#include <util/gd.hpp>
+#include <util/into.hpp>
+
+using namespace geode::prelude;
+
+bool LightVisualPlayer::init(RemotePlayer* parent, bool isSecond) {
+    if (!CCNode::init()) return false;
+    this->parent = parent;
+    this->isSecond = isSecond;
+
+    this->gameLayer = GJBaseGameLayer::get();
+
+    auto& data = parent->getAccountData();
+    auto& settings = GlobedSettings::get();
+
+    auto playerOpacity = static_cast<unsigned char>(settings.players.playerOpacity * 255.f);
+
+    Build<CCNode>::create()
+        .parent(this)
+        .store(iconWrapper);
+
+    Build<SimplePlayer>::create(1)
+        .parent(iconWrapper)
+        .store(icon);
+
+    Build<SimplePlayer>::create(1)
+        .scale(0.55f)
+        .pos(0.f, 5.f)
+        .visible(false)
+        .parent(iconWrapper)
+        .store(passenger);
+
+    Build<GlobedNameLabel>::create(data.name)
+        .visible(settings.players.showNames && (!isSecond || settings.players.dualName))
+        .pos(0.f, 25.f)
+        .parent(this)
+        .store(nameLabel);
+
+    if (!isSecond && settings.players.statusIcons) {
+        statusIcons = Build<PlayerStatusIcons>::create(playerOpacity)
+            .scale(0.8f)
+            .anchorPoint(0.5f, 0.f)
+            .pos(0.f, settings.players.showNames ? 40.f : 25.f)
+            .parent(this)
+            .id("status-icons"_spr)
+            .collect();
+    }
+
+    this->updateIcons(data.icons);
+
+    return true;
+}
+
+void LightVisualPlayer::updateIcons(const PlayerIconData& icons) {
+    auto* gm = GameManager::get();
+    auto& settings = GlobedSettings::get();
+
+    const auto& accountData = parent->getAccountData();
+    nameLabel->updateData(accountData.name, accountData.specialUserData);
+    nameLabel->updateOpacity(settings.players.nameOpacity);
+
+    storedIcons = icons;
+
+    for (auto* sp : {icon, passenger}) {
+        sp->setColor(gm->colorForIdx(icons.color1));
+        sp->setSecondColor(gm->colorForIdx(icons.color2));
+
+        if (icons.glowColor != NO_GLOW) {
+            sp->setGlowOutline(gm->colorForIdx(icons.glowColor));
+        } else {
+            sp->disableGlowOutline();
+        }
+    }
+
+    passenger->updatePlayerFrame(icons.cube, IconType::Cube);
+
+    // force the frame to be reloaded
+    auto type = iconType == PlayerIconType::Unknown ? PlayerIconType::Cube : iconType;
+    iconType = PlayerIconType::Unknown;
+    this->updateIconType(type);
+
+    this->updateOpacity();
+}
+
+void LightVisualPlayer::updateData(
+        const SpecificIconData& data,
+        const VisualPlayerState& playerData,
+        VisibilityTier tier,
+        bool isSpeaking,
+        float loudness
+) {
+    auto& settings = GlobedSettings::get();
+
+    bool isNearby = tier != VisibilityTier::Far;
+    bool cameNearby = isNearby && !wasNearby;
+    wasNearby = isNearby;
+
+    iconWrapper->setPosition(data.position);
+    iconWrapper->setRotation(data.rotation);
+
+    float innerRot = data.isSideways ? (data.isUpsideDown ? 90.f : -90.f) : 0.f;
+    icon->setRotation(innerRot);
+
+    if (tier == VisibilityTier::Visible) {
+        auto dirVec = GlobedGJBGL::getCameraDirectionVector();
+        auto dir = GlobedGJBGL::getCameraDirectionAngle();
+
+        nameLabel->setPosition(data.position + dirVec * CCPoint{25.f, 25.f});
+        nameLabel->setRotation(dir);
+
+        if (statusIcons) {
+            statusIcons->setPosition(data.position + dirVec * CCPoint{nameLabel->isVisible() ? 40.f : 25.f, nameLabel->isVisible() ? 40.f : 25.f});
+            statusIcons->setRotation(dir);
+        }
+    }
+
+    PlayerIconType newType = data.iconType == PlayerIconType::Unknown ? PlayerIconType::Cube : data.iconType;
+
+    float mult = data.isMini ? 0.6f : 1.0f;
+    iconWrapper->setScaleX((data.isLookingLeft ? -1.0f : 1.0f) * mult);
+
+    // swing is not flipped
+    if (newType == PlayerIconType::Swing) {
+        iconWrapper->setScaleY(mult);
+    } else {
+        iconWrapper->setScaleY((data.isUpsideDown ? -1.0f : 1.0f) * mult);
+    }
+
+    bool switchedMode = newType != iconType;
+    if (switchedMode) {
+        this->updateIconType(newType);
+    }
+
+    if (switchedMode || (settings.players.hideNearby && isNearby)) {
+        this->updateOpacity();
+    }
+
+    if (statusIcons && isNearby) {
+        statusIcons->updateStatus(playerData.isPaused, playerData.isPracticing, isSpeaking, playerData.isInEditor, loudness);
+    }
+
+    if (iconType == PlayerIconType::Robot || iconType == PlayerIconType::Spider) {
+        if (wasGrounded != data.isGrounded || wasStationary != data.isStationary || wasFalling != data.isFalling || switchedMode || cameNearby) {
+            wasGrounded = data.isGrounded;
+            wasStationary = data.isStationary;
+            wasFalling = data.isFalling;
+
+            if (isNearby) {
+                this->updateRobotAnimation(iconType == PlayerIconType::Robot ? icon->m_robotSprite : icon->m_spiderSprite);
+            }
+        }
+    }
+
+    bool shouldBeVisible;
+    if (isSecond && !playerData.isDualMode) {
+        shouldBeVisible = false;
+    } else if (settings.players.hidePracticePlayers && playerData.isPracticing) {
+        shouldBeVisible = false;
+    } else {
+        shouldBeVisible = (data.isVisible || settings.players.forceVisibility) && !isForciblyHidden;
+    }
+
+    this->setVisible(shouldBeVisible);
+}
+
+void LightVisualPlayer::updatePosition(const SpecificIconData& data) {
+    wasNearby = false;
+
+    iconWrapper->setPosition(data.position);
+    iconWrapper->setRotation(data.rotation);
+}
+
+void LightVisualPlayer::resetState() {
+    this->stopAllActions();
+
+    wasGrounded = false;
+    wasStationary = true;
+    wasFalling = false;
+    wasNearby = false;
+    p1sticky = p2sticky = false;
+
+    iconWrapper->setPosition({0.f, 0.f});
+    iconWrapper->setRotation(0.f);
+}
+
+void LightVisualPlayer::updateIconType(PlayerIconType newType) {
+    if (newType == PlayerIconType::Unknown) newType = PlayerIconType::Cube;
+    if (newType == iconType) return;
+
+    iconType = newType;
+    icon->updatePlayerFrame(util::gd::getIconWithType(storedIcons, newType), globed::into<IconType>(newType));
+
+    bool hasPassenger = newType == PlayerIconType::Ship || newType == PlayerIconType::Ufo || newType == PlayerIconType::Jetpack;
+    passenger->setVisible(hasPassenger);
+
+    // the cube sits inside the ship and ufo, but in front of the jetpack
+    if (hasPassenger) {
+        passenger->setZOrder(newType == PlayerIconType::Jetpack ? 1 : -1);
+    }
+
+    // animations of the previous robot or spider no longer apply
+    wasGrounded = false;
+    wasStationary = true;
+    wasFalling = false;
+}
+
+void LightVisualPlayer::updateRobotAnimation(GJRobotSprite* sprite) {
+    if (!sprite) return;
+
+    if (wasGrounded) {
+        sprite->tweenToAnimation(wasStationary ? "idle01" : "run", 0.1f);
+    } else {
+        sprite->tweenToAnimation(wasFalling ? "fall_loop" : "jump_loop", 0.1f);
+    }
+}
+
+void LightVisualPlayer::updateOpacity() {
+    auto& settings = GlobedSettings::get();
+
+    float mult = 1.f;
+    if (settings.players.hideNearby) {
+        auto p1pos = this->gameLayer->m_player1->getPosition();
+        auto p2pos = this->gameLayer->m_player2->getPosition();
+        auto ourPos = this->getPlayerPosition();
+
+        float distance = std::min(cocos2d::ccpDistance(ourPos, p1pos), cocos2d::ccpDistance(ourPos, p2pos));
+
+        // range of 150 units (5 blocks)
+        distance = std::clamp(distance, 0.f, 150.f);
+        mult = distance / 150.f;
+    }
+
+    unsigned char opacity = static_cast<unsigned char>(settings.players.playerOpacity * mult * 255.f);
+
+    icon->setOpacity(opacity);
+    passenger->setOpacity(opacity);
+    if (icon->m_robotSprite) icon->m_robotSprite->GJRobotSprite::setOpacity(opacity);
+    if (icon->m_spiderSprite) icon->m_spiderSprite->GJRobotSprite::setOpacity(opacity);
+
+    if (settings.players.hideNearby) {
+        nameLabel->updateOpacity(settings.players.nameOpacity * mult);
+    }
+}
+
+void LightVisualPlayer::playDeathEffect() {
+    // only play the death effect in playlayer, and when nearby
+    if (!PlayLayer::get() || !wasNearby) return;
+
+    auto* wave = CCCircleWave::create(10.f, 60.f, 0.3f, false, true);
+    wave->m_color = GameManager::get()->colorForIdx(storedIcons.color1);
+    wave->setPosition(this->getPlayerPosition());
+    wave->setTag(DEATH_EFFECT_TAG);
+
+    gameLayer->m_objectLayer->addChild(wave);
+}
+
+void LightVisualPlayer::playSpiderTeleport(const SpiderTeleportData& data) {
+    // not animated, the icon just moves to the new position
+}
+
+void LightVisualPlayer::playJump() {
+    // the platformer jump squish needs a `PlayerObject`
+}
+
+void LightVisualPlayer::setForciblyHidden(bool state) {
+    isForciblyHidden = state;
+}
+
+const CCPoint& LightVisualPlayer::getPlayerPosition() {
+    return iconWrapper->getPosition();
+}
+
+PlayerObject* LightVisualPlayer::getPlayerObject() {
+    return nullptr;
+}
+
+LightVisualPlayer* LightVisualPlayer::create(RemotePlayer* parent, bool isSecond) {
+    auto ret = new LightVisualPlayer;
+    if (ret->init(parent, isSecond)) {
+        ret->autorelease();
+        return ret;
+    }
+
+    delete ret;
+    return nullptr;
+}
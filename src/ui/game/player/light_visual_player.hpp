@@ -0,0 +1,57 @@
+#pragma once
+
+#include "base_visual_player.hpp"
+#include "status_icons.hpp"
+#include <ui/general/name_label.hpp>
+
+// Remote player icon drawn with `SimplePlayer` sprites instead of a `PlayerObject`.
+// Has no collision and only simplified effects: deaths are a circle wave, and spider teleports and platformer jump squishes
+// aren't animated. How it compares to `ComplexVisualPlayer` in nodes, memory and update time is logged in debug builds
+// when leaving a level, it hasn't been measured in the game yet.
+class LightVisualPlayer : public BaseVisualPlayer {
+public:
+    bool init(RemotePlayer* parent, bool isSecond);
+    void updateIcons(const PlayerIconData& icons) override;
+    void updateData(
+        const SpecificIconData& data,
+        const VisualPlayerState& playerData,
+        VisibilityTier tier,
+        bool isSpeaking,
+        float loudness
+    ) override;
+    void updatePosition(const SpecificIconData& data) override;
+    void resetState() override;
+    void playDeathEffect() override;
+    void playSpiderTeleport(const SpiderTeleportData& data) override;
+    void playJump() override;
+    void setForciblyHidden(bool state) override;
+    const cocos2d::CCPoint& getPlayerPosition() override;
+    PlayerObject* getPlayerObject() override;
+
+    static LightVisualPlayer* create(RemotePlayer* parent, bool isSecond);
+
+protected:
+    GJBaseGameLayer* gameLayer;
+    // holds the icon and the passenger, moved and rotated as one
+    cocos2d::CCNode* iconWrapper;
+    SimplePlayer* icon;
+    // the cube riding the ship, ufo or jetpack
+    SimplePlayer* passenger;
+    Ref<GlobedNameLabel> nameLabel;
+    Ref<PlayerStatusIcons> statusIcons;
+
+    PlayerIconData storedIcons;
+    PlayerIconType iconType = PlayerIconType::Unknown;
+
+    bool wasNearby = false;
+    bool isForciblyHidden = false;
+
+    // used in robot and spider anims
+    bool wasGrounded = false;
+    bool wasStationary = true;
+    bool wasFalling = false;
+
+    void updateIconType(PlayerIconType newType);
+    void updateRobotAnimation(GJRobotSprite* sprite);
+    void updateOpacity();
+};
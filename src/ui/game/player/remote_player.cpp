@@ -4,29 +4,43 @@
 
 using namespace geode::prelude;
 
-bool RemotePlayer::init(GameCameraState* gameCameraState, PlayerProgressIcon* progressIcon, PlayerProgressArrow* progressArrow, const PlayerAccountData& data) {
+bool RemotePlayer::init(GameCameraState* gameCameraState, PlayerProgressIcon* progressIcon, PlayerProgressArrow* progressArrow, const PlayerAccountData& data, bool lightweight) {
     if (!CCNode::init()) return false;
     this->accountData = data;
     this->progressIcon = progressIcon;
     this->progressArrow = progressArrow;
     this->gameCameraState = gameCameraState;
+    this->lightweight = lightweight;
+
+    if (lightweight) {
+        this->player1 = LightVisualPlayer::create(this, false);
+        this->player2 = LightVisualPlayer::create(this, true);
+    } else {
+        this->player1 = ComplexVisualPlayer::create(this, false);
+        this->player2 = ComplexVisualPlayer::create(this, true);
+    }
 
-    this->player1 = Build<ComplexVisualPlayer>::create(this, false)
+    Build(player1)
         .parent(this)
-        .id("visual-player1"_spr)
-        .collect();
+        .id("visual-player1"_spr);
 
-    this->player2 = Build<ComplexVisualPlayer>::create(this, true)
+    Build(player2)
         .parent(this)
-        .id("visual-player2"_spr)
-        .collect();
+        .id("visual-player2"_spr);
+
+    if (progressIcon) {
+        progressIcon->updateIcons(data.icons);
+    }
+
+    if (progressArrow) {
+        progressArrow->updateIcons(data.icons);
+    }
 
     return true;
 }
 
 void RemotePlayer::updateAccountData(const PlayerAccountData& data, bool force) {
     if (!force && this->accountData == data) {
-        defaultTicks = 0;
         return;
     }
 
@@ -41,8 +55,6 @@ void RemotePlayer::updateAccountData(const PlayerAccountData& data, bool force)
     if (progressArrow) {
         progressArrow->updateIcons(data.icons);
     }
-
-    defaultTicks = 0;
 }
 
 const PlayerAccountData& RemotePlayer::getAccountData() const {
@@ -52,11 +64,12 @@ const PlayerAccountData& RemotePlayer::getAccountData() const {
 void RemotePlayer::updateData(
         const VisualPlayerState& data,
         FrameFlags frameFlags,
+        VisibilityTier tier,
         bool speaking,
         float loudness
 ) {
-    player1->updateData(data.player1, data, *gameCameraState, speaking, loudness);
-    player2->updateData(data.player2, data, *gameCameraState, speaking, loudness);
+    player1->updateData(data.player1, data, tier, speaking, loudness);
+    player2->updateData(data.player2, data, tier, speaking, loudness);
 
     isEditorBuilding = data.isEditorBuilding;
 
@@ -90,6 +103,17 @@ void RemotePlayer::updateData(
     }
 }
 
+void RemotePlayer::updatePosition(const VisualPlayerState& data, FrameFlags frameFlags) {
+    player1->updatePosition(data.player1);
+    player2->updatePosition(data.player2);
+
+    isEditorBuilding = data.isEditorBuilding;
+    lastPercentage = data.currentPercentage;
+    lastFrameFlags = frameFlags;
+    lastVisualState = data;
+    wasPracticing = data.isPracticing;
+}
+
 void RemotePlayer::updateProgressIcon() {
     if (progressIcon) {
         progressIcon->updatePosition(lastPercentage, wasPracticing);
@@ -110,22 +134,14 @@ void RemotePlayer::onExit() {
     // do nothing.
 }
 
-unsigned int RemotePlayer::getDefaultTicks() {
-    return defaultTicks;
-}
-
-void RemotePlayer::setDefaultTicks(unsigned int ticks) {
-    defaultTicks = ticks;
-}
-
-void RemotePlayer::incDefaultTicks() {
-    defaultTicks++;
-}
-
 bool RemotePlayer::isValidPlayer() {
     return accountData.accountId != 0;
 }
 
+bool RemotePlayer::isLightweight() {
+    return lightweight;
+}
+
 void RemotePlayer::setForciblyHidden(bool state) {
     isForciblyHidden = state;
     player1->setForciblyHidden(state);
@@ -156,9 +172,28 @@ void RemotePlayer::removeProgressIndicators() {
     }
 }
 
-RemotePlayer* RemotePlayer::create(GameCameraState* gameCameraState, PlayerProgressIcon* progressIcon, PlayerProgressArrow* progressArrow, const PlayerAccountData& data) {
+void RemotePlayer::setProgressIndicators(PlayerProgressIcon* progressIcon, PlayerProgressArrow* progressArrow) {
+    this->progressIcon = progressIcon;
+    this->progressArrow = progressArrow;
+}
+
+void RemotePlayer::resetState() {
+    this->removeProgressIndicators();
+    this->setForciblyHidden(false);
+
+    player1->resetState();
+    player2->resetState();
+
+    lastPercentage = 0.f;
+    wasPracticing = false;
+    isEditorBuilding = false;
+    lastFrameFlags = {};
+    lastVisualState = {};
+}
+
+RemotePlayer* RemotePlayer::create(GameCameraState* gameCameraState, PlayerProgressIcon* progressIcon, PlayerProgressArrow* progressArrow, const PlayerAccountData& data, bool lightweight) {
     auto ret = new RemotePlayer;
-    if (ret->init(gameCameraState, progressIcon, progressArrow, data)) {
+    if (ret->init(gameCameraState, progressIcon, progressArrow, data, lightweight)) {
         ret->autorelease();
         return ret;
     }
@@ -167,6 +202,6 @@ RemotePlayer* RemotePlayer::create(GameCameraState* gameCameraState, PlayerProgr
     return nullptr;
 }
 
-RemotePlayer* RemotePlayer::create(GameCameraState* gameCameraState, PlayerProgressIcon* progressIcon, PlayerProgressArrow* progressArrow) {
-    return create(gameCameraState, progressIcon, progressArrow, PlayerAccountData::DEFAULT_DATA);
+RemotePlayer* RemotePlayer::create(GameCameraState* gameCameraState, PlayerProgressIcon* progressIcon, PlayerProgressArrow* progressArrow, bool lightweight) {
+    return create(gameCameraState, progressIcon, progressArrow, PlayerAccountData::DEFAULT_DATA, lightweight);
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include <defs/all.hpp>
 
 #include "complex_visual_player.hpp"
+#include "light_visual_player.hpp"
 #include <ui/game/progress/progress_icon.hpp>
 #include <ui/game/progress/progress_arrow.hpp>
 #include <data/types/gd.hpp>
@@ -10,16 +11,20 @@
 
 class RemotePlayer : public cocos2d::CCNode {
 public:
-    bool init(GameCameraState* gameCameraState, PlayerProgressIcon* progressIcon, PlayerProgressArrow* progressArrow, const PlayerAccountData& data);
+    // `lightweight` draws the player with `LightVisualPlayer` instead of `ComplexVisualPlayer`
+    bool init(GameCameraState* gameCameraState, PlayerProgressIcon* progressIcon, PlayerProgressArrow* progressArrow, const PlayerAccountData& data, bool lightweight);
     void updateAccountData(const PlayerAccountData& data, bool force = false);
     const PlayerAccountData& getAccountData() const;
 
     void updateData(
         const VisualPlayerState& data,
         FrameFlags frameFlags,
+        VisibilityTier tier,
         bool speaking,
         float loudness
     );
+    // cheap version of `updateData` for players that are far away from the camera, only keeps their position up to date
+    void updatePosition(const VisualPlayerState& data, FrameFlags frameFlags);
     void updateProgressIcon();
     void updateProgressArrow(
         cocos2d::CCPoint cameraOrigin,
@@ -31,34 +36,35 @@ public:
 
     void onExit() override;
 
-    unsigned int getDefaultTicks();
-    void setDefaultTicks(unsigned int ticks);
-    void incDefaultTicks();
     void removeProgressIndicators();
+    void setProgressIndicators(PlayerProgressIcon* progressIcon, PlayerProgressArrow* progressArrow);
+
+    // clears everything left over from the previous player, so that the node can be reused
+    void resetState();
 
     void setForciblyHidden(bool state);
     bool getForciblyHidden();
 
     bool isValidPlayer();
+    bool isLightweight();
 
-    static RemotePlayer* create(GameCameraState* gameCameraState, PlayerProgressIcon* progressIcon, PlayerProgressArrow* progressArrow, const PlayerAccountData& data);
-    static RemotePlayer* create(GameCameraState* gameCameraState, PlayerProgressIcon* progressIcon, PlayerProgressArrow* progressArrow);
+    static RemotePlayer* create(GameCameraState* gameCameraState, PlayerProgressIcon* progressIcon, PlayerProgressArrow* progressArrow, const PlayerAccountData& data, bool lightweight = false);
+    static RemotePlayer* create(GameCameraState* gameCameraState, PlayerProgressIcon* progressIcon, PlayerProgressArrow* progressArrow, bool lightweight = false);
 
     Ref<PlayerProgressIcon> progressIcon;
     Ref<PlayerProgressArrow> progressArrow;
-    ComplexVisualPlayer* player1;
-    ComplexVisualPlayer* player2;
+    BaseVisualPlayer* player1;
+    BaseVisualPlayer* player2;
 
     FrameFlags lastFrameFlags;
     VisualPlayerState lastVisualState;
 
 protected:
-    unsigned int defaultTicks = 0;
     float lastPercentage = 0.f;
     bool wasPracticing = false;
     bool isForciblyHidden = false;
     bool isEditorBuilding = false;
-
+    bool lightweight = false;
 
     GameCameraState* gameCameraState;
 
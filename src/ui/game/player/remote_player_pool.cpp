@@ -0,0 +1,86 @@
+#include "remote_player_pool.hpp"
+
+#include <util/misc.hpp>
+
+using namespace geode::prelude;
+
+Ref<RemotePlayer> RemotePlayerPool::acquire(
+    GameCameraState* camState,
+    PlayerProgressIcon* progressIcon,
+    PlayerProgressArrow* progressArrow,
+    const PlayerAccountData& data
+) {
+    if (nodes.empty()) {
+        return this->build(camState, progressIcon, progressArrow, data);
+    }
+
+    Ref<RemotePlayer> player = std::move(nodes.back());
+    nodes.pop_back();
+
+    player->setProgressIndicators(progressIcon, progressArrow);
+    player->updateAccountData(data, true);
+
+    stats.reused++;
+
+    return player;
+}
+
+void RemotePlayerPool::release(RemotePlayer* player) {
+    if (nodes.size() >= MAX_SIZE) return;
+
+    player->resetState();
+    nodes.push_back(player);
+
+    stats.released++;
+}
+
+bool RemotePlayerPool::prewarmOne(GameCameraState* camState) {
+    if (nodes.size() >= PREWARM_SIZE) return false;
+
+    nodes.push_back(this->build(camState, nullptr, nullptr, PlayerAccountData::DEFAULT_DATA));
+
+    return true;
+}
+
+void RemotePlayerPool::setLightweight(bool state) {
+    lightweight = state;
+}
+
+bool RemotePlayerPool::isLightweight() const {
+    return lightweight;
+}
+
+size_t RemotePlayerPool::size() const {
+    return nodes.size();
+}
+
+const RemotePlayerPool::Stats& RemotePlayerPool::getStats() const {
+    return stats;
+}
+
+Ref<RemotePlayer> RemotePlayerPool::build(
+    GameCameraState* camState,
+    PlayerProgressIcon* progressIcon,
+    PlayerProgressArrow* progressArrow,
+    const PlayerAccountData& data
+) {
+    stats.created++;
+
+#ifdef GLOBED_DEBUG
+    // the first node also loads the icon textures and frames into the caches, so it isn't measured
+    if (stats.created > 1 && stats.measured < MEASURE_COUNT) {
+        size_t before = util::misc::heapUsage();
+        auto player = RemotePlayer::create(camState, progressIcon, progressArrow, data, lightweight);
+        size_t after = util::misc::heapUsage();
+
+        if (after > before) {
+            stats.measured++;
+            stats.measuredBytes += after - before;
+        }
+
+        return player;
+    }
+#endif
+
+    return RemotePlayer::create(camState, progressIcon, progressArrow, data, lightweight);
+}
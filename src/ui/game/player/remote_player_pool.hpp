@@ -0,0 +1,59 @@
+#pragma once
+#include <defs/geode.hpp>
+
+#include "remote_player.hpp"
+
+// Keeps the nodes of players that left the level around, so that the next player to join can reuse them
+// instead of building two new `PlayerObject`s.
+class RemotePlayerPool {
+public:
+    struct Stats {
+        size_t created = 0;
+        size_t reused = 0;
+        size_t released = 0;
+
+        // debug builds only, heap growth caused by building new nodes
+        size_t measured = 0;
+        size_t measuredBytes = 0;
+    };
+
+    // nodes built ahead of time while nothing else is happening
+    static constexpr size_t PREWARM_SIZE = 8;
+    // players that leave when the pool is this large are destroyed
+    static constexpr size_t MAX_SIZE = 64;
+    // how many new nodes get their heap usage measured, this is slow on some platforms
+    static constexpr size_t MEASURE_COUNT = 4;
+
+    // reuses a pooled node if there is one, the returned node has no parent
+    geode::Ref<RemotePlayer> acquire(
+        GameCameraState* camState,
+        PlayerProgressIcon* progressIcon,
+        PlayerProgressArrow* progressArrow,
+        const PlayerAccountData& data
+    );
+    // the node must already be removed from its parent
+    void release(RemotePlayer* player);
+
+    // builds one node if the pool holds less than `PREWARM_SIZE`, returns `false` if nothing was built
+    bool prewarmOne(GameCameraState* camState);
+
+    // whether new nodes are built with `LightVisualPlayer`s, should be set before any are built
+    void setLightweight(bool state);
+    bool isLightweight() const;
+
+    size_t size() const;
+    const Stats& getStats() const;
+
+private:
+    std::vector<geode::Ref<RemotePlayer>> nodes;
+
+    geode::Ref<RemotePlayer> build(
+        GameCameraState* camState,
+        PlayerProgressIcon* progressIcon,
+        PlayerProgressArrow* progressArrow,
+        const PlayerAccountData& data
+    );
+
+    Stats stats;
+    bool lightweight = false;
+};
@@ -16,7 +16,7 @@ bool GlobedUserActionsPopup::setup(int accountId, CCArray* buttons) {
     auto data = pcm.getData(accountId);
 
     std::string name = "Player";
-    if (data.has_value()) {
+    if (data) {
         name = data->name;
     }
 
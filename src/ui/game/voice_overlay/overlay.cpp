@@ -26,12 +26,7 @@ void GlobedVoiceOverlay::addPlayer(int accountId) {
     auto& pcm = ProfileCacheManager::get();
     auto data = pcm.getData(accountId);
 
-    PlayerAccountData accdata = PlayerAccountData::DEFAULT_DATA;
-    if (data.has_value()) {
-        accdata = data.value();
-    }
-
-    auto* cell = VoiceOverlayCell::create(accdata);
+    auto* cell = VoiceOverlayCell::create(data ? *data : PlayerAccountData::DEFAULT_DATA);
     this->addChild(cell);
 }
 
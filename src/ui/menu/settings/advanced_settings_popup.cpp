@@ -1,11 +1,14 @@
 #include "advanced_settings_popup.hpp"
 
+#include <game/lerp_logger.hpp>
 #include <managers/account.hpp>
 #include <managers/settings.hpp>
 #include <net/manager.hpp>
 #include <net/address.hpp>
+#include <util/bench.hpp>
 #include <util/debug.hpp>
 #include <util/format.hpp>
+#include <util/time.hpp>
 #include <util/ui.hpp>
 
 using namespace geode::prelude;
@@ -68,6 +71,36 @@ bool AdvancedSettingsPopup::setup() {
         .pos(rlayout.center - CCPoint{0.f, 60.f})
         .parent(menu);
 
+#ifdef GLOBED_DEBUG
+    // runs synchronously and takes a few seconds, writing wav files to the save dir along the way
+    Build<ButtonSprite>::create("Benchmarks", "bigFont.fnt", "GJ_button_01.png", 0.75f)
+        .scale(0.8f)
+        .intoMenuItem([this](auto) {
+            util::bench::runAll();
+            Notification::create("Benchmarks finished, results are in the logs", NotificationIcon::Success)->show();
+        })
+        .pos(rlayout.center - CCPoint{0.f, 90.f})
+        .parent(menu);
+#endif
+
+    Build<ButtonSprite>::create("Dump interpolation", "bigFont.fnt", "GJ_button_01.png", 0.75f)
+        .scale(0.8f)
+        .intoMenuItem([this](auto) {
+            auto folder = Mod::get()->getSaveDir() / "interpolation-dumps";
+            (void) geode::utils::file::createDirectoryAll(folder);
+
+            auto res = LerpLogger::get().dumpRings(folder / fmt::format("{}.bin", util::time::sinceEpoch().count()));
+
+            if (res) {
+                Notification::create("Saved the interpolation log to the save folder", NotificationIcon::Success)->show();
+            } else {
+                log::warn("failed to dump the interpolation log: {}", res.unwrapErr());
+                Notification::create("Failed to save the interpolation log", NotificationIcon::Error)->show();
+            }
+        })
+        .pos(rlayout.center - CCPoint{0.f, 120.f})
+        .parent(menu);
+
     auto* thing = Build(CCMenuItemToggler::createWithStandardSprites(this, menu_selector(AdvancedSettingsPopup::onPacketLog), 0.7f))
         .parent(menu)
         .collect();
@@ -225,6 +225,7 @@ void GlobedSettingsLayer::createSettingsCells(int category) {
             registerSetting(cat, settings.globed.editorSupport, "View players in editor", "Enables the ability to see people playing your level while in the editor. Note: <cy>this does not let you build levels together!</c>");
             registerSetting(cat, settings.globed.fragmentationLimit, "Packet limit", "Press the \"Test\" button to calibrate the maximum packet size. Should fix some of the issues with players not appearing in a level.", Type::PacketFragmentation);
             registerSetting(cat, settings.globed.tpsCap, "TPS cap", "Maximum amount of packets per second sent between the client and the server. Useful only for very silly things.");
+            registerSetting(cat, settings.globed.adaptiveSendRate, "Adaptive send rate", "Only send your position when other players can't guess it from the previous ones (for example when standing still or moving in a straight line), and send less often when the connection is struggling.");
 
 #ifndef GEODE_IS_ANDROID
             registerSetting(cat, settings.globed.useDiscordRPC, "Discord RPC", "If you have the Discord Rich Presence standalone mod, this option will toggle a Globed-specific RPC on your profile.", Type::DiscordRPC);
@@ -248,7 +249,11 @@ void GlobedSettingsLayer::createSettingsCells(int category) {
             registerSetting(cat, settings.communication.voiceVolume, "Voice volume", "Controls how loud other players are.");
             registerSetting(cat, settings.communication.onlyFriends, "Only friends", "When enabled, you won't hear players that are not on your friend list in-game.");
             registerSetting(cat, settings.communication.lowerAudioLatency, "Lower audio latency", "Decreases the audio buffer size by 2 times, reducing the latency but potentially causing audio issues.");
+            registerSetting(cat, settings.communication.lowLatencyVoice, "Low latency voice", "Sends your voice in small 20ms pieces as soon as they are recorded instead of in bigger chunks, greatly reducing the delay at the cost of sending more packets. Overrides Lower audio latency.");
+            registerSetting(cat, settings.communication.voiceActivityDetection, "Voice activity detection", "Stops sending your voice while you are silent, even when the voice chat key is held, reducing bandwidth usage.");
+            registerSetting(cat, settings.communication.voiceBitrate, "Voice bitrate", "The target bitrate of your voice in bits per second (6000 - 64000). Higher values sound better but use more bandwidth.");
             registerSetting(cat, settings.communication.deafenNotification, "Deafen notification", "Shows a notification when you deafen & undeafen.");
+            registerSetting(cat, settings.communication.softwareMixer, "Software mixing", "Mixes the voices of all players into a single audio stream instead of playing a separate stream for every player. Takes effect after rejoining the level.");
             registerSetting(cat, settings.communication.audioDevice, "Audio device", "The input device used for recording your voice.", Type::AudioDevice);
             // MAKE_SETTING(communication, voiceLoopback, "Voice loopback", "When enabled, you will hear your own voice as you speak.");
 #endif // GLOBED_VOICE_SUPPORT
@@ -278,6 +283,8 @@ void GlobedSettingsLayer::createSettingsCells(int category) {
             registerSetting(cat, settings.players.hideNearby, "Hide nearby players", "Increases the transparency of players as they get closer to you, so that they don't obstruct your view.");
             registerSetting(cat, settings.players.statusIcons, "Status icons", "Show an icon above a player if they are paused, in practice mode, or currently speaking.");
             registerSetting(cat, settings.players.hidePracticePlayers, "Hide players in practice", "Hide players that are in practice mode.");
+            registerSetting(cat, settings.players.extrapolation, "Extrapolation", "When a player's data arrives late, keep moving them in the direction they were going instead of freezing them in place. May cause them to briefly overshoot.");
+            registerSetting(cat, settings.players.lightweightPlayers, "Lightweight players", "Draw other players with simple icons instead of full game players. Some effects are simplified. Has no effect when collision or 2 player mode is enabled.");
         } break;
     }
 }
@@ -14,4 +14,5 @@
 #include "net.hpp"
 #include "rng.hpp"
 #include "time.hpp"
+#include "timer_wheel.hpp"
 #include "ui.hpp"
@@ -0,0 +1,1035 @@
+#include "bench.hpp"
+
+#include <audio/voice_mixer.hpp>
+#include <audio/manager.hpp>
+#include <audio/backend/file_backend.hpp>
+#include <game/collision_grid.hpp>
+#include <game/interpolation_suite.hpp>
+#include <game/interpolator.hpp>
+#include <game/lerp_logger.hpp>
+#include <game/send_rate_suite.hpp>
+#include <data/bytebuffer.hpp>
+#include <util/debug.hpp>
+#include <util/format.hpp>
+#include <util/math.hpp>
+#include <util/misc.hpp>
+#include <util/timer_wheel.hpp>
+#include <util/wav.hpp>
+
+#include <array>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+using namespace geode::prelude;
+
+namespace util::bench {
+    void runAll() {
+        log::debug("Running benchmarks..");
+
+        voiceMixer();
+        voiceLatency();
+        voiceHeadless();
+        simdKernels();
+        interpolation();
+        interpolationSuite();
+        sendRate();
+        collisionBroadphase();
+        timerWheel();
+        lerpLogger();
+
+        log::debug("Benchmarks finished.");
+    }
+
+    void voiceMixer() {
+#ifdef GLOBED_VOICE_SUPPORT
+        constexpr size_t ITERATIONS = 500;
+        constexpr size_t BLOCK = VOICE_TARGET_FRAMESIZE;
+
+        // 1 second of a quiet sine wave, fed into every stream before each run
+        std::vector<float> pcm(VOICE_TARGET_SAMPLERATE);
+        for (size_t i = 0; i < pcm.size(); i++) {
+            pcm[i] = 0.25f * std::sin(static_cast<float>(i) * 0.05f);
+        }
+
+        std::vector<float> out(BLOCK);
+        util::debug::Benchmarker bb;
+
+        for (size_t speakers : {1, 16, 64}) {
+            std::vector<std::unique_ptr<AudioStream>> streams;
+            VoiceMixer mixer;
+
+            for (size_t i = 0; i < speakers; i++) {
+                auto& stream = streams.emplace_back(std::make_unique<AudioStream>(
+                    AudioDecoder(VOICE_TARGET_SAMPLERATE, VOICE_TARGET_FRAMESIZE, VOICE_CHANNELS), nullptr
+                ));
+                stream->setVolume(0.8f);
+                mixer.addSource(stream.get());
+            }
+
+            // the queues of the streams only fit about a second of audio, so they are refilled between rounds
+            constexpr size_t ROUND = AudioSampleQueue::DEFAULT_CAPACITY / BLOCK;
+
+            auto timeRounds = [&](auto&& pullBlock) {
+                util::time::micros total{0};
+
+                for (size_t done = 0; done < ITERATIONS; done += ROUND) {
+                    size_t blocks = std::min(ROUND, ITERATIONS - done);
+
+                    for (auto& stream : streams) {
+                        for (size_t i = 0; i < BLOCK * blocks; i += pcm.size()) {
+                            stream->writeData(pcm.data(), std::min(pcm.size(), BLOCK * blocks - i));
+                        }
+                    }
+
+                    total += bb.run([&] {
+                        for (size_t it = 0; it < blocks; it++) {
+                            pullBlock();
+                        }
+                    });
+                }
+
+                return total;
+            };
+
+            // baseline: every stream is pulled separately, like the FMOD callbacks of standalone streams do
+            auto separate = timeRounds([&] {
+                for (auto& stream : streams) {
+                    stream->readSamples(out.data(), BLOCK);
+                }
+            });
+
+            auto mixed = timeRounds([&] {
+                mixer.mixInto(out.data(), BLOCK);
+            });
+
+            // the mixer has to remove sources before they are destroyed
+            for (auto& stream : streams) {
+                mixer.removeSource(stream.get());
+            }
+
+            double audioSeconds = static_cast<double>(BLOCK * ITERATIONS) / VOICE_TARGET_SAMPLERATE;
+
+            log::debug(
+                "voice mixer, {} speakers: separate {} ({:.2f}μs/block), mixed {} ({:.2f}μs/block), mixing cost {:.4f}% of realtime",
+                speakers,
+                util::format::duration(separate),
+                static_cast<double>(separate.count()) / ITERATIONS,
+                util::format::duration(mixed),
+                static_cast<double>(mixed.count()) / ITERATIONS,
+                static_cast<double>(mixed.count()) / (audioSeconds * 1'000'000.0) * 100.0
+            );
+        }
+#else
+        log::debug("voice mixer benchmark skipped, voice support is disabled");
+#endif
+    }
+
+    void voiceLatency() {
+#ifdef GLOBED_VOICE_SUPPORT
+        std::vector<float> source;
+
+        auto sourcePath = Mod::get()->getSaveDir() / "latency-source.wav";
+        if (std::filesystem::exists(sourcePath)) {
+            auto res = util::wav::readFile(sourcePath);
+            if (!res) {
+                log::warn("voice latency: failed to read {}: {}", sourcePath, res.unwrapErr());
+                return;
+            }
+
+            auto wavData = std::move(res.unwrap());
+            if (wavData.sampleRate != VOICE_TARGET_SAMPLERATE) {
+                log::warn("voice latency: {} must be {}hz, got {}hz", sourcePath, VOICE_TARGET_SAMPLERATE, wavData.sampleRate);
+                return;
+            }
+
+            source = std::move(wavData.samples);
+        } else {
+            // 3 seconds of a sine wave
+            source.resize(VOICE_TARGET_SAMPLERATE * 3);
+            for (size_t i = 0; i < source.size(); i++) {
+                source[i] = 0.25f * std::sin(static_cast<float>(i) * 0.05f);
+            }
+        }
+
+        struct Mode {
+            const char* name;
+            size_t frameSize;
+            size_t framesPerPacket;
+        };
+
+        constexpr Mode modes[] = {
+            {"regular", VOICE_TARGET_FRAMESIZE, EncodedAudioFrame::LIMIT_REGULAR},
+            {"lower audio latency", VOICE_TARGET_FRAMESIZE, EncodedAudioFrame::LIMIT_LOW_LATENCY},
+            {"low latency voice", VOICE_STREAMING_FRAMESIZE, 1},
+        };
+
+        // FMOD pulls data from the stream in chunks of this size (the length of the stream sound)
+        constexpr size_t PLAYOUT_CHUNK = VOICE_TARGET_FRAMESIZE;
+
+        // the clock is in samples, sample N of the source is captured at time N.
+        // network time is zero, so only the buffering of the pipeline itself is measured.
+        for (const auto& mode : modes) {
+            AudioEncoder encoder(VOICE_TARGET_SAMPLERATE, mode.frameSize, VOICE_CHANNELS);
+            AudioStream stream(AudioDecoder(VOICE_TARGET_SAMPLERATE, VOICE_TARGET_FRAMESIZE, VOICE_CHANNELS), nullptr);
+            EncodedAudioFrame frame(mode.framesPerPacket);
+
+            uint32_t sequence = 0;
+            size_t played = 0; // index of the next source sample to be played
+            size_t starvedChunks = 0, totalChunks = 0;
+            double latencySum = 0.0;
+            size_t latencyMax = 0;
+
+            std::vector<float> out(PLAYOUT_CHUNK);
+            bool failed = false;
+
+            for (size_t now = 1; now <= source.size() && !failed; now++) {
+                if (now % mode.frameSize == 0) {
+                    auto encoded = encoder.encode(source.data() + now - mode.frameSize);
+                    if (!encoded) {
+                        log::warn("voice latency: encoding failed: {}", encoded.unwrapErr());
+                        failed = true;
+                        break;
+                    }
+
+                    auto opusFrame = encoded.unwrap();
+
+                    if (mode.framesPerPacket == 1) {
+                        // streamed mode skips the frame entirely, like VoiceRecordingManager does
+                        failed = stream.writeSequencedData(sequence++, opusFrame).isErr();
+                        AudioEncoder::freeData(opusFrame);
+                    } else {
+                        (void) frame.pushOpusFrame(opusFrame);
+                        AudioEncoder::freeData(opusFrame);
+
+                        if (frame.size() == frame.capacity()) {
+                            // send it over the "network"
+                            ByteBuffer buf;
+                            buf.writeValue(frame);
+                            buf.setPosition(0);
+                            frame.clear();
+
+                            auto received = buf.readValue<EncodedAudioFrame>();
+                            failed = received.isErr() || stream.writeData(received.unwrap()).isErr();
+                        }
+                    }
+                }
+
+                if (now % PLAYOUT_CHUNK == 0) {
+                    size_t copied = stream.readSamples(out.data(), PLAYOUT_CHUNK);
+
+                    totalChunks++;
+                    if (copied != PLAYOUT_CHUNK) starvedChunks++;
+
+                    // the chunk starts playing now, so sample i of it gets played at now + i
+                    for (size_t i = 0; i < copied; i++) {
+                        size_t latency = now + i - played;
+                        latencySum += static_cast<double>(latency);
+                        latencyMax = std::max(latencyMax, latency);
+                        played++;
+                    }
+                }
+            }
+
+            if (failed) {
+                log::warn("voice latency: pipeline failed in mode '{}'", mode.name);
+                continue;
+            }
+
+            auto toMs = [](double samples) {
+                return samples * 1000.0 / VOICE_TARGET_SAMPLERATE;
+            };
+
+            log::debug(
+                "voice latency, {}: avg {:.1f}ms, max {:.1f}ms capture to playout (excluding network), {}/{} playout chunks starved",
+                mode.name,
+                played ? toMs(latencySum / static_cast<double>(played)) : 0.0,
+                toMs(static_cast<double>(latencyMax)),
+                starvedChunks,
+                totalChunks
+            );
+        }
+#else
+        log::debug("voice latency benchmark skipped, voice support is disabled");
+#endif
+    }
+
+    void voiceHeadless() {
+#ifdef GLOBED_VOICE_SUPPORT
+        constexpr size_t SECONDS = 10;
+        // how far the clock moves at once, similar to how often the audio thread wakes up
+        constexpr size_t STEP = VOICE_TARGET_SAMPLERATE / 100;
+
+        FileAudioBackend backend;
+
+        auto sourcePath = Mod::get()->getSaveDir() / "latency-source.wav";
+        if (std::filesystem::exists(sourcePath)) {
+            auto res = backend.setCaptureFile(sourcePath);
+            if (!res) {
+                log::warn("headless voice: failed to read {}: {}", sourcePath, res.unwrapErr());
+                return;
+            }
+        } else {
+            std::vector<float> source(VOICE_TARGET_SAMPLERATE);
+            for (size_t i = 0; i < source.size(); i++) {
+                source[i] = 0.25f * std::sin(static_cast<float>(i) * 0.05f);
+            }
+
+            backend.setCaptureData(std::move(source));
+        }
+
+        size_t packets = 0, bytes = 0;
+        auto began = util::time::now();
+
+        {
+            AudioEncoder encoder(VOICE_TARGET_SAMPLERATE, VOICE_TARGET_FRAMESIZE, VOICE_CHANNELS);
+            AudioStream stream(AudioDecoder(VOICE_TARGET_SAMPLERATE, VOICE_TARGET_FRAMESIZE, VOICE_CHANNELS), &backend);
+            stream.setVolume(1.f);
+            stream.start();
+
+            EncodedAudioFrame frame(EncodedAudioFrame::LIMIT_REGULAR);
+            AudioSampleQueue captured;
+            ByteBuffer network;
+
+            (void) backend.startCapture(0);
+
+            for (size_t clock = 0; clock < SECONDS * VOICE_TARGET_SAMPLERATE; clock += STEP) {
+                backend.advance(STEP);
+                (void) backend.readCapture(&captured);
+
+                while (captured.size() >= VOICE_TARGET_FRAMESIZE) {
+                    float pcm[VOICE_TARGET_FRAMESIZE];
+                    captured.copyTo(pcm, VOICE_TARGET_FRAMESIZE);
+
+                    auto space = frame.reserveOpusFrame().unwrap();
+                    frame.commitOpusFrame(encoder.encode(pcm, space).unwrap());
+
+                    if (frame.size() < frame.capacity()) continue;
+
+                    network.clear();
+                    network.writeValue(frame);
+                    frame.clear();
+
+                    packets++;
+                    bytes += network.size();
+
+                    network.setPosition(0);
+                    (void) stream.writeData(network.readValue<EncodedAudioFrame>().unwrap());
+                }
+            }
+
+            backend.stopCapture();
+        }
+
+        auto took = util::time::now() - began;
+
+        auto outputPath = Mod::get()->getSaveDir() / "headless-output.wav";
+        auto res = backend.writeOutputFile(outputPath);
+        if (!res) {
+            log::warn("headless voice: failed to write {}: {}", outputPath, res.unwrapErr());
+        }
+
+        log::debug(
+            "headless voice: {}s of audio through the whole pipeline in {} ({:.0f}x realtime), {} packets, {:.1f} kbit/s, output in {}",
+            SECONDS,
+            util::format::duration(took),
+            static_cast<double>(SECONDS) * 1'000'000.0 / static_cast<double>(std::max<long long>(1, util::time::asMicros(took))),
+            packets,
+            static_cast<double>(bytes) * 8.0 / 1000.0 / SECONDS,
+            outputPath
+        );
+#else
+        log::debug("headless voice benchmark skipped, voice support is disabled");
+#endif
+    }
+
+    void simdKernels() {
+        using namespace util::misc;
+
+        std::mt19937 rng(1337);
+        // wide enough that a good chunk of samples is out of range, so clamping and clipping actually do something
+        std::normal_distribution<float> dist(0.f, 0.8f);
+
+        auto randomPcm = [&](size_t n) {
+            std::vector<float> out(n);
+            for (auto& s : out) s = dist(rng);
+            return out;
+        };
+
+        auto randomInts = [&](size_t n) {
+            std::vector<int16_t> out(n);
+            for (auto& s : out) s = static_cast<int16_t>(rng());
+            return out;
+        };
+
+        auto maxDiff = [](const auto& a, const auto& b) {
+            double diff = 0.0;
+            for (size_t i = 0; i < a.size(); i++) {
+                diff = std::max(diff, std::abs(static_cast<double>(a[i]) - static_cast<double>(b[i])));
+            }
+            return diff;
+        };
+
+        size_t failures = 0;
+        auto expect = [&](const char* kernel, size_t n, bool ok) {
+            if (!ok) {
+                failures++;
+                log::warn("simd kernel {} does not match the scalar reference with {} samples", kernel, n);
+            }
+        };
+
+        // every length up to a few avx512 vectors to hit each tail, plus a couple of large odd ones
+        std::vector<size_t> lengths;
+        for (size_t n = 0; n <= 40; n++) lengths.push_back(n);
+        lengths.push_back(1021);
+        lengths.push_back(4099);
+
+        for (size_t n : lengths) {
+            auto pcm = randomPcm(n);
+            auto src = randomPcm(n);
+            auto ints = randomInts(n);
+
+            auto a = pcm, b = pcm;
+            applyPcmGain(a.data(), n, 0.37f);
+            pcmGainSlow(b.data(), n, 0.37f);
+            expect("gain", n, maxDiff(a, b) == 0.0);
+
+            a = pcm;
+            b = pcm;
+            mixPcm(a.data(), src.data(), n, 0.6f);
+            pcmMixSlow(b.data(), src.data(), n, 0.6f);
+            expect("mix", n, maxDiff(a, b) < 1e-5);
+
+            a = pcm;
+            b = pcm;
+            clampPcm(a.data(), n);
+            pcmClampSlow(b.data(), n);
+            expect("clamp", n, maxDiff(a, b) == 0.0);
+
+            a = pcm;
+            b = pcm;
+            softClipPcm(a.data(), n);
+            pcmSoftClipSlow(b.data(), n);
+            expect("soft clip", n, maxDiff(a, b) < 1e-5);
+
+            expect("peak", n, calculatePcmPeak(pcm.data(), n) == pcmPeakSlow(pcm.data(), n));
+
+            float rms = calculatePcmRms(pcm.data(), n);
+            float rmsRef = n == 0 ? 0.f : std::sqrt(pcmSumSquaresSlow(pcm.data(), n) / static_cast<float>(n));
+            expect("rms", n, std::abs(rms - rmsRef) <= 1e-4f * std::max(1.f, rmsRef));
+
+            expect("zero crossings", n, countPcmZeroCrossings(pcm.data(), n) == pcmZeroCrossingsSlow(pcm.data(), n));
+
+            std::vector<int16_t> ia(n), ib(n);
+            pcmToInt16(pcm.data(), ia.data(), n);
+            pcmToInt16Slow(pcm.data(), ib.data(), n);
+            expect("float to int16", n, maxDiff(ia, ib) == 0.0);
+
+            a.assign(n, 0.f);
+            b.assign(n, 0.f);
+            pcmFromInt16(ints.data(), a.data(), n);
+            pcmFromInt16Slow(ints.data(), b.data(), n);
+            expect("int16 to float", n, maxDiff(a, b) == 0.0);
+
+            auto ratios = randomPcm(n);
+            a.assign(n, 0.f);
+            b.assign(n, 0.f);
+            util::math::lerpArrays(pcm.data(), src.data(), ratios.data(), a.data(), n);
+            util::math::lerpArraysSlow(pcm.data(), src.data(), ratios.data(), b.data(), n);
+            expect("lerp", n, maxDiff(a, b) < 1e-5);
+        }
+
+        if (failures == 0) {
+            log::debug("simd kernels: all kernels match the scalar reference across {} lengths", lengths.size());
+        } else {
+            log::warn("simd kernels: {} mismatches across {} lengths", failures, lengths.size());
+        }
+
+        constexpr size_t SAMPLES = 4096;
+        constexpr size_t ITERATIONS = 2000;
+
+        auto pcm = randomPcm(SAMPLES);
+        auto src = randomPcm(SAMPLES);
+        auto ints = randomInts(SAMPLES);
+        std::vector<int16_t> intOut(SAMPLES);
+        std::vector<float> floatOut(SAMPLES);
+
+        // keeps the reductions from being optimized out
+        volatile float sink = 0.f;
+
+        util::debug::Benchmarker bb;
+        auto compare = [&](const char* kernel, auto&& fast, auto&& slow) {
+            auto fastTime = bb.run([&] { for (size_t i = 0; i < ITERATIONS; i++) fast(); });
+            auto slowTime = bb.run([&] { for (size_t i = 0; i < ITERATIONS; i++) slow(); });
+
+            double total = static_cast<double>(SAMPLES * ITERATIONS);
+            double fastNs = static_cast<double>(fastTime.count()) * 1000.0 / total;
+            double slowNs = static_cast<double>(slowTime.count()) * 1000.0 / total;
+
+            log::debug(
+                "simd kernel {}: {:.3f}ns/sample, scalar {:.3f}ns/sample ({:.1f}x)",
+                kernel, fastNs, slowNs, fastNs > 0.0 ? slowNs / fastNs : 0.0
+            );
+        };
+
+        // the in place kernels run over the same buffer repeatedly, gain 1 and clamping are idempotent so the data stays the same
+        compare("gain",
+            [&] { applyPcmGain(pcm.data(), SAMPLES, 1.f); },
+            [&] { pcmGainSlow(pcm.data(), SAMPLES, 1.f); });
+        compare("mix",
+            [&] { mixPcm(floatOut.data(), src.data(), SAMPLES, 0.f); },
+            [&] { pcmMixSlow(floatOut.data(), src.data(), SAMPLES, 0.f); });
+        compare("peak",
+            [&] { sink = calculatePcmPeak(pcm.data(), SAMPLES); },
+            [&] { sink = pcmPeakSlow(pcm.data(), SAMPLES); });
+        compare("sum of squares",
+            [&] { sink = calculatePcmSumSquares(pcm.data(), SAMPLES); },
+            [&] { sink = pcmSumSquaresSlow(pcm.data(), SAMPLES); });
+        compare("zero crossings",
+            [&] { sink = static_cast<float>(countPcmZeroCrossings(pcm.data(), SAMPLES)); },
+            [&] { sink = static_cast<float>(pcmZeroCrossingsSlow(pcm.data(), SAMPLES)); });
+        compare("float to int16",
+            [&] { pcmToInt16(pcm.data(), intOut.data(), SAMPLES); },
+            [&] { pcmToInt16Slow(pcm.data(), intOut.data(), SAMPLES); });
+        compare("int16 to float",
+            [&] { pcmFromInt16(ints.data(), floatOut.data(), SAMPLES); },
+            [&] { pcmFromInt16Slow(ints.data(), floatOut.data(), SAMPLES); });
+        compare("clamp",
+            [&] { clampPcm(pcm.data(), SAMPLES); },
+            [&] { pcmClampSlow(pcm.data(), SAMPLES); });
+        compare("lerp",
+            [&] { util::math::lerpArrays(pcm.data(), src.data(), src.data(), floatOut.data(), SAMPLES); },
+            [&] { util::math::lerpArraysSlow(pcm.data(), src.data(), src.data(), floatOut.data(), SAMPLES); });
+        // soft clipping is not idempotent, but once the samples are in range it keeps them there, which is all that matters here
+        compare("soft clip",
+            [&] { softClipPcm(pcm.data(), SAMPLES); },
+            [&] { pcmSoftClipSlow(pcm.data(), SAMPLES); });
+
+        (void) sink;
+    }
+
+    void interpolation() {
+        constexpr float DURATION = 30.f;
+        constexpr float SEND_DELTA = 1.f / 30.f;
+        constexpr float RENDER_DELTA = 1.f / 240.f;
+        constexpr float BASE_LATENCY = 0.05f;
+        constexpr float SPEED = 311.58f; // normal speed in units per second
+
+        // a cube going right with a bit of vertical movement, so both axes get checked
+        auto truth = [](float t) {
+            return CCPoint{SPEED * t, 105.f + 60.f * std::sin(t * 3.f)};
+        };
+
+        struct Scenario {
+            const char* name;
+            float jitter; // standard deviation of the latency, in seconds
+            float loss;
+        };
+
+        constexpr Scenario scenarios[] = {
+            {"perfect network", 0.f, 0.f},
+            {"10ms jitter", 0.01f, 0.f},
+            {"30ms jitter, 2% loss", 0.03f, 0.02f},
+            {"60ms jitter, 5% loss", 0.06f, 0.05f},
+        };
+
+        for (const auto& scenario : scenarios) {
+            for (bool extrapolation : {false, true}) {
+                std::mt19937 rng(42);
+                std::normal_distribution<float> jitterDist(0.f, scenario.jitter);
+                std::uniform_real_distribution<float> lossDist(0.f, 1.f);
+
+                // simulate the network first, packets sorted by arrival time
+                std::vector<std::pair<float, PlayerData>> packets;
+                for (float t = 0.f; t < DURATION; t += SEND_DELTA) {
+                    if (lossDist(rng) < scenario.loss) continue;
+
+                    PlayerData data{};
+                    data.timestamp = t;
+                    data.player1.position = truth(t);
+                    data.player1.iconType = PlayerIconType::Cube;
+                    data.player1.isVisible = true;
+
+                    packets.emplace_back(t + BASE_LATENCY + std::abs(jitterDist(rng)), data);
+                }
+
+                std::stable_sort(packets.begin(), packets.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+                PlayerInterpolator interpolator(InterpolatorSettings {
+                    .realtime = false,
+                    .isPlatformer = false,
+                    .expectedDelta = SEND_DELTA,
+                    .extrapolation = extrapolation,
+                });
+                interpolator.addPlayer(1);
+
+                size_t nextPacket = 0;
+                size_t ticks = 0, stutters = 0;
+                double errorSquared = 0.0, delaySum = 0.0;
+                float lastX = 0.f;
+                bool started = false;
+
+                for (float now = 0.f; now < DURATION; now += RENDER_DELTA) {
+                    while (nextPacket < packets.size() && packets[nextPacket].first <= now) {
+                        interpolator.updatePlayer(1, packets[nextPacket].second);
+                        nextPacket++;
+                    }
+
+                    interpolator.tick(RENDER_DELTA);
+
+                    if (nextPacket == 0) continue;
+
+                    const auto& stats = interpolator.getPlayerStats(1);
+                    auto pos = interpolator.getPlayerState(1).player1.position;
+
+                    // error against where the player really was at the moment that is being displayed
+                    auto expected = truth(stats.playoutTime);
+                    errorSquared += static_cast<double>(pos.getDistanceSq(expected));
+                    delaySum += static_cast<double>(now - stats.playoutTime);
+
+                    // a stutter is any frame where the player visibly stops, goes back or jumps ahead
+                    float step = pos.x - lastX;
+                    float expectedStep = SPEED * RENDER_DELTA;
+                    if (started && (step < expectedStep * 0.5f || step > expectedStep * 1.5f)) {
+                        stutters++;
+                    }
+
+                    lastX = pos.x;
+                    started = true;
+                    ticks++;
+                }
+
+                const auto& stats = interpolator.getPlayerStats(1);
+
+                log::debug(
+                    "interpolation, {}{}: rms error {:.2f} units, avg delay {:.1f}ms, {} stutters ({:.2f}% of frames), {} starved, {} extrapolated, {} clock snaps, {} dropped",
+                    scenario.name,
+                    extrapolation ? " + extrapolation" : "",
+                    std::sqrt(errorSquared / std::max<size_t>(ticks, 1)),
+                    delaySum / std::max<size_t>(ticks, 1) * 1000.0,
+                    stutters,
+                    static_cast<double>(stutters) * 100.0 / std::max<size_t>(ticks, 1),
+                    stats.starvedTicks,
+                    stats.extrapolatedTicks,
+                    stats.clockSnaps,
+                    stats.droppedFrames
+                );
+            }
+        }
+
+        // cost of interpolating a full room every rendered frame
+        constexpr size_t TICKS = 2400;
+
+        for (int playerCount : {50, 200, 1000}) {
+            PlayerInterpolator interpolator(InterpolatorSettings {
+                .realtime = false,
+                .isPlatformer = false,
+                .expectedDelta = SEND_DELTA,
+            });
+
+            for (int id = 0; id < playerCount; id++) {
+                interpolator.addPlayer(id);
+            }
+
+            float now = 0.f;
+            size_t sinceSend = 0;
+
+            util::debug::Benchmarker bb;
+            auto took = bb.run([&] {
+                for (size_t tick = 0; tick < TICKS; tick++) {
+                    // everyone sends at the same rate, a packet every 8 frames at 240hz
+                    if (sinceSend++ % 8 == 0) {
+                        for (int id = 0; id < playerCount; id++) {
+                            PlayerData data{};
+                            data.timestamp = now;
+                            data.player1.position = truth(now + static_cast<float>(id));
+                            data.player2.position = data.player1.position;
+                            data.player1.isVisible = true;
+                            interpolator.updatePlayer(id, data);
+                        }
+                    }
+
+                    interpolator.tick(RENDER_DELTA);
+                    now += RENDER_DELTA;
+                }
+            });
+
+            log::debug(
+                "interpolation, {} players: {:.2f}μs per tick, {:.1f}ns per player per tick (including packet ingestion)",
+                playerCount,
+                static_cast<double>(took.count()) / TICKS,
+                static_cast<double>(took.count()) * 1000.0 / TICKS / playerCount
+            );
+        }
+    }
+
+    static Result<std::vector<PlayerData>> readSendTrace(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            return Err(fmt::format("failed to open {}", path.string()));
+        }
+
+        util::data::bytevector data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        ByteBuffer bb(std::move(data));
+
+        auto result = bb.readValue<std::vector<PlayerData>>();
+        if (!result) {
+            return Err(ByteBuffer::strerror(result.unwrapErr()));
+        }
+
+        return Ok(std::move(result.unwrap()));
+    }
+
+    void interpolationSuite() {
+        for (const auto& result : InterpolationSuite::measureAccuracy()) {
+            log::debug(
+                "interpolation suite, {}, {}: rms error {:.2f} units (max {:.1f}), {} snaps, {} clock snaps, {} starved, {} dropped",
+                result.trajectory,
+                result.network,
+                result.rmsError,
+                result.maxError,
+                result.snaps,
+                result.clockSnaps,
+                result.starvedTicks,
+                result.droppedFrames
+            );
+        }
+
+        for (const auto& result : InterpolationSuite::measureCost()) {
+            log::debug(
+                "interpolation suite, {}, {} players: {:.1f}ns per player per tick (including packet ingestion), {:.1f}ns per received frame",
+                result.trajectory,
+                result.players,
+                result.nanosPerPlayerTick,
+                result.nanosPerFrame
+            );
+        }
+    }
+
+    void sendRate() {
+        auto traces = SendRateSuite::syntheticTraces();
+
+        // recorded traces, see `GLOBED_RECORD_SEND_TRACES` in config.hpp
+        auto traceDir = Mod::get()->getSaveDir() / "send-traces";
+        std::error_code ec;
+        if (std::filesystem::is_directory(traceDir, ec)) {
+            for (const auto& entry : std::filesystem::directory_iterator(traceDir, ec)) {
+                auto res = readSendTrace(entry.path());
+                if (!res) {
+                    log::warn("send rate: failed to read {}: {}", entry.path(), res.unwrapErr());
+                    continue;
+                }
+
+                traces.push_back(SendRateSuite::Trace {
+                    .name = entry.path().filename().string(),
+                    .frames = std::move(res.unwrap()),
+                });
+            }
+        }
+
+        for (const auto& result : SendRateSuite::measure(traces)) {
+            log::debug(
+                "send rate, {} ({}): {} frames sent out of {}, {} polls, {} skipped, {} abrupt; {:.1f} datagrams/s and {:.0f} bytes/s "
+                "with rms error {:.2f} units (max {:.1f}), sending every frame: {:.1f} datagrams/s and {:.0f} bytes/s with rms {:.2f} (max {:.1f})",
+                result.trace, result.network,
+                result.stats.sent, result.frames,
+                result.stats.polled, result.stats.skipped, result.stats.abrupt,
+                result.adaptive.datagramsPerSecond, result.adaptive.bytesPerSecond,
+                result.adaptive.rmsError, result.adaptive.maxError,
+                result.always.datagramsPerSecond, result.always.bytesPerSecond,
+                result.always.rmsError, result.always.maxError
+            );
+        }
+    }
+
+    void collisionBroadphase() {
+        // a frame at 240 fps with the default physics has 4 substeps, each checking both local players
+        constexpr size_t QUERIES_PER_FRAME = 8;
+        constexpr size_t FRAMES = 200;
+        constexpr float PLAYER_SIZE = 30.f;
+
+        // stands in for a `PlayerObject`, which is large and scattered around the heap, and computes its rect from its position
+        struct SyntheticPlayer {
+            CCPoint position;
+            float scale = 1.f;
+            char rest[2048];
+
+            CCRect getObjectRect() const {
+                float size = PLAYER_SIZE * scale;
+                return CCRect{position.x - size / 2.f, position.y - size / 2.f, size, size};
+            }
+        };
+
+        struct Distribution {
+            const char* name;
+            CCRect area;
+        };
+
+        const Distribution distributions[] = {
+            {"spread over a level", CCRect{0.f, 100.f, 30000.f, 500.f}},
+            {"crowded at the start", CCRect{0.f, 100.f, 400.f, 300.f}},
+            {"vertical platformer", CCRect{0.f, 0.f, 600.f, 20000.f}},
+        };
+
+        std::mt19937 rng(41);
+
+        for (const auto& dist : distributions) {
+            for (int playerCount : {50, 200, 1000}) {
+                std::uniform_real_distribution<float> xDist(dist.area.getMinX(), dist.area.getMaxX());
+                std::uniform_real_distribution<float> yDist(dist.area.getMinY(), dist.area.getMaxY());
+
+                // both icons of every player
+                std::vector<std::unique_ptr<SyntheticPlayer>> players;
+                for (int i = 0; i < playerCount * 2; i++) {
+                    players.push_back(std::make_unique<SyntheticPlayer>());
+                }
+
+                // every frame has new positions
+                std::vector<std::vector<CCPoint>> positions(FRAMES);
+                std::vector<std::array<CCRect, QUERIES_PER_FRAME>> queries(FRAMES);
+
+                for (size_t i = 0; i < FRAMES; i++) {
+                    for (size_t j = 0; j < players.size(); j++) {
+                        positions[i].emplace_back(xDist(rng), yDist(rng));
+                    }
+
+                    for (auto& query : queries[i]) {
+                        query = CCRect{xDist(rng), yDist(rng), PLAYER_SIZE, PLAYER_SIZE};
+                    }
+                }
+
+                auto movePlayers = [&](size_t frame) {
+                    for (size_t j = 0; j < players.size(); j++) {
+                        players[j]->position = positions[frame][j];
+                    }
+                };
+
+                size_t bruteHits = 0, gridHits = 0;
+
+                // what `CollisionModule` used to do, every remote player on every query
+                util::debug::Benchmarker bb;
+                auto bruteTook = bb.run([&] {
+                    for (size_t i = 0; i < FRAMES; i++) {
+                        movePlayers(i);
+
+                        for (const auto& query : queries[i]) {
+                            for (const auto& player : players) {
+                                bruteHits += query.intersectsRect(player->getObjectRect());
+                            }
+                        }
+                    }
+                });
+
+                CollisionGrid grid;
+                auto gridTook = bb.run([&] {
+                    for (size_t i = 0; i < FRAMES; i++) {
+                        movePlayers(i);
+
+                        grid.clear();
+                        for (size_t j = 0; j < players.size(); j++) {
+                            grid.insert(players[j]->getObjectRect(), j);
+                        }
+                        grid.build();
+
+                        for (const auto& query : queries[i]) {
+                            grid.query(query, [&](uint32_t, const CCRect&) { gridHits++; });
+                        }
+                    }
+                });
+
+                if (bruteHits != gridHits) {
+                    log::warn("collision broadphase, {} with {} players: grid found {} hits, brute force found {}", dist.name, playerCount, gridHits, bruteHits);
+                }
+
+                log::debug(
+                    "collision broadphase, {} with {} players: brute force {:.2f}μs per frame, grid {:.2f}μs per frame (including the rebuild), {} hits",
+                    dist.name, playerCount,
+                    static_cast<double>(bruteTook.count()) / FRAMES,
+                    static_cast<double>(gridTook.count()) / FRAMES,
+                    gridHits
+                );
+            }
+        }
+    }
+
+    void timerWheel() {
+        constexpr size_t TIMERS = 10000;
+        // milliseconds, like the stale player checks
+        constexpr uint64_t HORIZON = 30000;
+        constexpr uint64_t STEP = 250;
+
+        using Wheel = util::time::TimerWheel<uint32_t>;
+
+        std::mt19937 rng(47);
+        std::uniform_int_distribution<uint64_t> deadlineDist(0, HORIZON);
+
+        // 0 means cancelled
+        std::vector<uint64_t> deadlines(TIMERS);
+        for (auto& deadline : deadlines) {
+            deadline = deadlineDist(rng) + 1;
+        }
+
+        Wheel wheel;
+        std::vector<Wheel::Id> ids(TIMERS);
+
+        util::debug::Benchmarker bb;
+        auto scheduleTook = bb.run([&] {
+            for (uint32_t i = 0; i < TIMERS; i++) {
+                ids[i] = wheel.schedule(deadlines[i], i);
+            }
+        });
+
+        // every 4th timer gets cancelled, and every 4th one after that gets moved
+        auto changeTook = bb.run([&] {
+            for (uint32_t i = 0; i < TIMERS; i += 4) {
+                wheel.cancel(ids[i]);
+                deadlines[i] = 0;
+
+                deadlines[i + 1] = deadlineDist(rng) + 1;
+                wheel.reschedule(ids[i + 1], deadlines[i + 1]);
+            }
+        });
+
+        std::vector<uint32_t> firedCount(TIMERS, 0);
+        size_t wrongStep = 0;
+
+        uint64_t now = 0;
+        auto advanceTook = bb.run([&] {
+            for (now = STEP; now <= HORIZON + STEP; now += STEP) {
+                wheel.advance(now, [&](uint32_t i) {
+                    firedCount[i]++;
+                    wrongStep += deadlines[i] > now || deadlines[i] <= now - STEP;
+                });
+            }
+        });
+
+        size_t missed = 0, duplicates = 0;
+        for (size_t i = 0; i < TIMERS; i++) {
+            uint32_t expected = deadlines[i] == 0 ? 0 : 1;
+            missed += firedCount[i] < expected;
+            duplicates += firedCount[i] > expected;
+        }
+
+        if (missed || duplicates || wrongStep || wheel.size() != 0) {
+            log::warn(
+                "timer wheel: {} timers missed, {} fired more than once, {} fired at the wrong step, {} left over",
+                missed, duplicates, wrongStep, wheel.size()
+            );
+        }
+
+        // the same steps, but looking at every deadline each time
+        size_t scanned = 0;
+        auto scanTook = bb.run([&] {
+            for (uint64_t step = STEP; step <= HORIZON + STEP; step += STEP) {
+                for (auto& deadline : deadlines) {
+                    if (deadline != 0 && deadline <= step) {
+                        scanned++;
+                        deadline = 0;
+                    }
+                }
+            }
+        });
+
+        size_t steps = HORIZON / STEP + 1;
+
+        log::debug(
+            "timer wheel, {} timers: schedule {}μs, cancel + reschedule {}μs, {:.2f}μs per step (scanning every deadline: {:.2f}μs), {} fired",
+            TIMERS,
+            scheduleTook.count(),
+            changeTook.count(),
+            static_cast<double>(advanceTook.count()) / steps,
+            static_cast<double>(scanTook.count()) / steps,
+            scanned
+        );
+    }
+
+    void lerpLogger() {
+        constexpr int PLAYERS = 200;
+        constexpr size_t TICKS = 2400;
+        constexpr float SEND_DELTA = 1.f / 30.f;
+        constexpr float RENDER_DELTA = 1.f / 240.f;
+
+        auto& logger = LerpLogger::get();
+
+        // the same room as in `interpolation`, once with the rings and once without
+        auto runRoom = [&](bool rings) {
+            logger.setRingsEnabled(rings);
+
+            PlayerInterpolator interpolator(InterpolatorSettings {
+                .realtime = false,
+                .isPlatformer = false,
+                .expectedDelta = SEND_DELTA,
+            });
+
+            for (int id = 0; id < PLAYERS; id++) {
+                interpolator.addPlayer(id);
+            }
+
+            float now = 0.f;
+
+            util::debug::Benchmarker bb;
+            return bb.run([&] {
+                for (size_t tick = 0; tick < TICKS; tick++) {
+                    if (tick % 8 == 0) {
+                        for (int id = 0; id < PLAYERS; id++) {
+                            PlayerData data{};
+                            data.timestamp = now;
+                            data.player1.position = CCPoint{311.58f * now + static_cast<float>(id), 105.f};
+                            data.player1.isVisible = true;
+                            interpolator.updatePlayer(id, data);
+                        }
+                    }
+
+                    interpolator.tick(RENDER_DELTA);
+                    now += RENDER_DELTA;
+                }
+            });
+        };
+
+        // benchmarks are ran from the menu, so this only drops the rings of the last level
+        logger.clearInactiveRings();
+
+        // warm up, so that neither run pays for allocating the rings
+        runRoom(true);
+
+        auto without = runRoom(false);
+        auto with = runRoom(true);
+
+        logger.setRingsEnabled(true);
+
+        double perTick = static_cast<double>(TICKS) * PLAYERS;
+        double overhead = (static_cast<double>(with.count()) - static_cast<double>(without.count())) * 1000.0 / perTick;
+
+        log::debug(
+            "lerp logger, {} players: {:.2f}μs per tick without rings, {:.2f}μs with ({:.1f}ns per player per tick, {:.1f}% slower)",
+            PLAYERS,
+            static_cast<double>(without.count()) / TICKS,
+            static_cast<double>(with.count()) / TICKS,
+            overhead,
+            (static_cast<double>(with.count()) / std::max<double>(without.count(), 1.0) - 1.0) * 100.0
+        );
+
+        // the last room left its rings behind, dump those
+        auto path = Mod::get()->getSaveDir() / "bench-lerp-rings.bin";
+
+        auto dumpStart = util::time::now();
+        auto res = logger.dumpRings(path);
+        auto dumpTook = util::time::now() - dumpStart;
+
+        if (!res) {
+            log::warn("lerp logger: dump failed: {}", res.unwrapErr());
+        } else {
+            size_t expected = 16 + PLAYERS * (8 + LerpLogger::RING_SIZE * sizeof(LerpLogger::Entry));
+            if (res.unwrap() != expected) {
+                log::warn("lerp logger: dump has {} bytes, expected {}", res.unwrap(), expected);
+            }
+
+            log::debug("lerp logger: dumping {} rings took {} ({} bytes)", PLAYERS, util::format::duration(dumpTook), res.unwrap());
+        }
+
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        logger.clearInactiveRings();
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+// Micro benchmarks for the hot paths of the mod, ran on demand from the advanced settings in debug builds.
+// Everything is printed with log::debug, nothing here is meant to be called during normal gameplay.
+namespace util::bench {
+    // run every benchmark below
+    void runAll();
+
+    // mixing N speakers through `VoiceMixer` vs pulling N separate streams
+    void voiceMixer();
+
+    // capture-to-playout latency of the voice pipeline in every transmission mode, on a simulated clock.
+    // uses `latency-source.wav` from the save directory as the audio source if it exists.
+    void voiceLatency();
+
+    // runs the capture -> encode -> network -> decode -> playback pipeline on a `FileAudioBackend`, without audio hardware.
+    // `audio_pipeline` in test/ checks the same pipeline without the game.
+    // captures `latency-source.wav` from the save directory if it exists, and writes what was played to `headless-output.wav`.
+    void voiceHeadless();
+
+    // checks every pcm simd kernel against its scalar reference on random data and odd lengths,
+    // then compares their throughput. mismatches are logged as warnings.
+    void simdKernels();
+
+    // drives `PlayerInterpolator` with a synthetic player moving at a constant speed, sent over a simulated network
+    // with jitter and packet loss. reports the position error, display delay and stutters for every scenario.
+    // also measures the cost of a tick with a full room of players.
+    void interpolation();
+
+    // feeds ground truth cube, ship, wave and spider (with teleports) trajectories through `PlayerInterpolator`, sampled at
+    // server tps over networks with different jitter and packet loss. reports the rms position error and visible snaps
+    // for every combination, and the cost per player per tick of a full room on every trajectory.
+    // the same suite runs without the game as `interpolation_suite` in test/.
+    void interpolationSuite();
+
+    // replays player traces through `SendRateController` on a stable, a congested and a lossy connection, and reports the
+    // datagrams and bytes per second that go out (polls included), and how far the interpolated player on the receiving end
+    // is from the trace, compared to sending every frame. besides the synthetic ones from `SendRateSuite`, replays every
+    // trace recorded into `send-traces` in the save directory. the synthetic ones also run as `send_rate_suite` in test/.
+    void sendRate();
+
+    // compares `CollisionGrid` against checking every remote player, on random rooms where players are spread over a level,
+    // crowded at the start, or spread vertically. both sides run a frame worth of physics steps per set of positions.
+    void collisionBroadphase();
+
+    // schedules 10k timers in `TimerWheel`, cancels and moves some of them, then advances in periodic update sized steps.
+    // checks that every timer fires exactly once and at the right step, and compares the cost against scanning every deadline.
+    void timerWheel();
+
+    // cost of the always on `LerpLogger` rings in `PlayerInterpolator::tick` with a full room, compared to having them disabled,
+    // and how long dumping every ring takes.
+    void lerpLogger();
+}
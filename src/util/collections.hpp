@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include <vector>
 #include <queue>
 #include <map>
@@ -238,6 +239,106 @@ public:
     }
 };
 
+/*
+* BatchHandoff passes batches of values (for example every frame of a packet) from one thread to another, in order,
+* without either of them ever waiting. Unlike a triple buffer nothing is lost when the reader falls behind,
+* the batches just queue up. Batches are recycled once read, so after warming up nothing gets allocated.
+* Exactly one writer thread and one reader thread. `T` must have a `clear()` method.
+*/
+
+template <typename T>
+class BatchHandoff {
+public:
+    BatchHandoff() = default;
+    BatchHandoff(const BatchHandoff&) = delete;
+    BatchHandoff& operator=(const BatchHandoff&) = delete;
+
+    ~BatchHandoff() {
+        freeList(published.load(std::memory_order_acquire));
+        freeList(recycled.load(std::memory_order_acquire));
+        delete writing;
+    }
+
+    // writer: the batch to fill in before calling `publish`. it is always empty.
+    T& writeBuffer() {
+        if (!writing) {
+            writing = popRecycled();
+        }
+
+        if (!writing) {
+            writing = new Node();
+        }
+
+        return writing->value;
+    }
+
+    // writer: queue the batch for the reader
+    void publish() {
+        if (!writing) return;
+
+        push(published, writing);
+        writing = nullptr;
+    }
+
+    // reader: calls `f` with every batch published since the last call, oldest first. returns the amount of batches.
+    template <typename F>
+    size_t read(F&& f) {
+        Node* list = published.exchange(nullptr, std::memory_order_acquire);
+
+        // the list is newest first
+        Node* ordered = nullptr;
+        while (list) {
+            Node* next = list->next;
+            list->next = ordered;
+            ordered = list;
+            list = next;
+        }
+
+        size_t count = 0;
+        while (ordered) {
+            Node* next = ordered->next;
+            f(ordered->value);
+            ordered->value.clear();
+            push(recycled, ordered);
+            ordered = next;
+            count++;
+        }
+
+        return count;
+    }
+
+private:
+    struct Node {
+        T value;
+        Node* next = nullptr;
+    };
+
+    std::atomic<Node*> published = nullptr;
+    std::atomic<Node*> recycled = nullptr;
+    // writer only
+    Node* writing = nullptr;
+
+    static void push(std::atomic<Node*>& stack, Node* node) {
+        node->next = stack.load(std::memory_order_relaxed);
+        while (!stack.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {}
+    }
+
+    // only the writer pops recycled nodes, and nodes are never freed while both threads run, so there is no aba problem
+    Node* popRecycled() {
+        Node* head = recycled.load(std::memory_order_acquire);
+        while (head && !recycled.compare_exchange_weak(head, head->next, std::memory_order_acquire, std::memory_order_acquire)) {}
+        return head;
+    }
+
+    static void freeList(Node* node) {
+        while (node) {
+            Node* next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+};
+
 template <typename K, typename V>
 std::vector<K> mapKeys(const std::map<K, V>& map) {
     std::vector<K> out;
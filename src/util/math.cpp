@@ -1,4 +1,15 @@
 #include "math.hpp"
 
+#include <util/simd.hpp>
+
 namespace util::math {
-}
\ No newline at end of file
+    void lerpArrays(const float* from, const float* to, const float* ratio, float* out, size_t count) {
+        simd::lerpArrays(from, to, ratio, out, count);
+    }
+
+    void lerpArraysSlow(const float* from, const float* to, const float* ratio, float* out, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            out[i] = from[i] + (to[i] - from[i]) * ratio[i];
+        }
+    }
+}
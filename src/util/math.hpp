@@ -103,4 +103,9 @@ namespace util::math {
     inline constexpr Out (max)(T1 a, T2 b) {
         return a > b ? a : b;
     }
+
+    // out[i] = from[i] + (to[i] - from[i]) * ratio[i], vectorized. `out` may be the same array as `from` or `to`.
+    void lerpArrays(const float* from, const float* to, const float* ratio, float* out, size_t count);
+
+    void lerpArraysSlow(const float* from, const float* to, const float* ratio, float* out, size_t count);
 }
\ No newline at end of file
@@ -32,19 +32,6 @@ namespace util::misc {
         callOnce(key, func);
     }
 
-    float calculatePcmVolume(const float* pcm, size_t samples) {
-        return simd::calcPcmVolume(pcm, samples);
-    }
-
-    float pcmVolumeSlow(const float* pcm, size_t samples) {
-        double sum = 0.0f;
-        for (size_t i = 0; i < samples; i++) {
-            sum += static_cast<double>(std::abs(pcm[i]));
-        }
-
-        return static_cast<float>(sum / static_cast<double>(samples));
-    }
-
     bool compareName(const std::string_view nv1, const std::string_view nv2) {
         std::string name1(nv1);
         std::string name2(nv2);
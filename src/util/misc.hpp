@@ -2,6 +2,7 @@
 #include <defs/essential.hpp>
 #include <defs/geode.hpp>
 #include <data/types/basic/either.hpp>
+#include "pcm.hpp"
 
 #include <functional>
 #include <string_view>
@@ -21,7 +22,6 @@
 #define _GLOBED_STRURL _GLOBED_STRALPHANUM ":/%._-?#"
 #define _GLOBED_STRWHITESPACE " \t\n\r\x0b\x0c"
 
-
 struct PlayerIconData;
 enum class PlayerIconType : uint8_t;
 enum class IconType;
@@ -74,11 +74,6 @@ namespace util::misc {
     // When using this, it is recommended that the function does not take long to execute, due to the simplicity of the implementation.
     void callOnceSync(const char* key, std::function<void()> func);
 
-    // Calculate the average volume of pcm samples
-    float calculatePcmVolume(const float* pcm, size_t samples);
-
-    float pcmVolumeSlow(const float* pcm, size_t samples);
-
     bool compareName(const std::string_view name1, const std::string_view name2);
 
     bool isEditorCollabLevel(LevelId levelId);
@@ -115,4 +110,7 @@ namespace util::misc {
 
     // If you are reading this, feel free to trace all usages of this function.
     // The fingerprint is never sent anywhere, and is only used for local encryption.
+
+    // Bytes currently allocated on the heap, or 0 if the platform can't tell. Can be slow, only meant for debugging.
+    size_t heapUsage(); // different definition per platform.
 }
@@ -0,0 +1,131 @@
+#include "pcm.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace util::misc {
+    float calculatePcmVolume(const float* pcm, size_t samples) {
+        return simd::calcPcmVolume(pcm, samples);
+    }
+
+    float calculatePcmSumSquares(const float* pcm, size_t samples) {
+        return simd::calcPcmSumSquares(pcm, samples);
+    }
+
+    void mixPcm(float* dest, const float* src, size_t samples, float gain) {
+        simd::mixPcm(dest, src, samples, gain);
+    }
+
+    size_t countPcmZeroCrossings(const float* pcm, size_t samples) {
+        return simd::countPcmZeroCrossings(pcm, samples);
+    }
+
+    void applyPcmGain(float* pcm, size_t samples, float gain) {
+        simd::applyPcmGain(pcm, samples, gain);
+    }
+
+    void clampPcm(float* pcm, size_t samples, float limit) {
+        simd::clampPcm(pcm, samples, limit);
+    }
+
+    void softClipPcm(float* pcm, size_t samples) {
+        simd::softClipPcm(pcm, samples);
+    }
+
+    float calculatePcmPeak(const float* pcm, size_t samples) {
+        return simd::calcPcmPeak(pcm, samples);
+    }
+
+    float calculatePcmRms(const float* pcm, size_t samples) {
+        if (samples == 0) return 0.f;
+
+        return std::sqrt(simd::calcPcmSumSquares(pcm, samples) / static_cast<float>(samples));
+    }
+
+    void pcmToInt16(const float* pcm, int16_t* out, size_t samples) {
+        simd::pcmToInt16(pcm, out, samples);
+    }
+
+    void pcmFromInt16(const int16_t* in, float* pcm, size_t samples) {
+        simd::pcmFromInt16(in, pcm, samples);
+    }
+
+    float pcmVolumeSlow(const float* pcm, size_t samples) {
+        double sum = 0.0f;
+        for (size_t i = 0; i < samples; i++) {
+            sum += static_cast<double>(std::abs(pcm[i]));
+        }
+
+        return static_cast<float>(sum / static_cast<double>(samples));
+    }
+
+    float pcmSumSquaresSlow(const float* pcm, size_t samples) {
+        double sum = 0.0;
+        for (size_t i = 0; i < samples; i++) {
+            sum += static_cast<double>(pcm[i]) * static_cast<double>(pcm[i]);
+        }
+
+        return static_cast<float>(sum);
+    }
+
+    void pcmMixSlow(float* dest, const float* src, size_t samples, float gain) {
+        for (size_t i = 0; i < samples; i++) {
+            dest[i] += src[i] * gain;
+        }
+    }
+
+    size_t pcmZeroCrossingsSlow(const float* pcm, size_t samples) {
+        size_t count = 0;
+        for (size_t i = 1; i < samples; i++) {
+            count += std::signbit(pcm[i - 1]) != std::signbit(pcm[i]);
+        }
+
+        return count;
+    }
+
+    void pcmGainSlow(float* pcm, size_t samples, float gain) {
+        for (size_t i = 0; i < samples; i++) {
+            pcm[i] *= gain;
+        }
+    }
+
+    void pcmClampSlow(float* pcm, size_t samples, float limit) {
+        for (size_t i = 0; i < samples; i++) {
+            pcm[i] = std::clamp(pcm[i], -limit, limit);
+        }
+    }
+
+    void pcmSoftClipSlow(float* pcm, size_t samples) {
+        // linear up to the knee, then bends towards 1 with a matching slope, so there is no kink at the knee
+        constexpr float KNEE = 0.8f;
+        constexpr float RANGE = 1.f - KNEE;
+
+        for (size_t i = 0; i < samples; i++) {
+            float a = std::min(std::abs(pcm[i]), 64.f);
+            float over = std::max(a - KNEE, 0.f);
+            pcm[i] = std::copysign(std::min(a, KNEE) + over * RANGE / (RANGE + over), pcm[i]);
+        }
+    }
+
+    float pcmPeakSlow(const float* pcm, size_t samples) {
+        float peak = 0.f;
+        for (size_t i = 0; i < samples; i++) {
+            peak = std::max(peak, std::abs(pcm[i]));
+        }
+
+        return peak;
+    }
+
+    void pcmToInt16Slow(const float* pcm, int16_t* out, size_t samples) {
+        for (size_t i = 0; i < samples; i++) {
+            out[i] = static_cast<int16_t>(std::lrintf(std::clamp(pcm[i], -1.f, 1.f) * 32767.f));
+        }
+    }
+
+    void pcmFromInt16Slow(const int16_t* in, float* pcm, size_t samples) {
+        for (size_t i = 0; i < samples; i++) {
+            pcm[i] = static_cast<float>(in[i]) / 32768.f;
+        }
+    }
+}
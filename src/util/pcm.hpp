@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Pcm helpers used by the voice pipeline. They dispatch to the simd kernels of the platform (see `util/simd.hpp`),
+// and don't depend on anything else so that the audio code can be built outside the game.
+
+namespace util::misc {
+    // Calculate the average volume of pcm samples
+    float calculatePcmVolume(const float* pcm, size_t samples);
+
+    // Calculate the sum of squares of pcm samples, used for RMS
+    float calculatePcmSumSquares(const float* pcm, size_t samples);
+
+    // Add the pcm samples from `src` multiplied by `gain` into `dest`
+    void mixPcm(float* dest, const float* src, size_t samples, float gain);
+
+    // Count how many times the sign changes between adjacent pcm samples
+    size_t countPcmZeroCrossings(const float* pcm, size_t samples);
+
+    // Multiply pcm samples by `gain` in place
+    void applyPcmGain(float* pcm, size_t samples, float gain);
+
+    // Hard clamp pcm samples to [-limit, limit] in place
+    void clampPcm(float* pcm, size_t samples, float limit = 1.f);
+
+    // Soft clip pcm samples in place. Samples up to 0.8 are left untouched, louder ones are squashed so that the output never exceeds [-1, 1]
+    void softClipPcm(float* pcm, size_t samples);
+
+    // Calculate the highest absolute value of pcm samples
+    float calculatePcmPeak(const float* pcm, size_t samples);
+
+    // Calculate the root mean square of pcm samples
+    float calculatePcmRms(const float* pcm, size_t samples);
+
+    // Convert pcm samples to signed 16-bit integers, clamping anything out of range
+    void pcmToInt16(const float* pcm, int16_t* out, size_t samples);
+
+    // Convert signed 16-bit integer samples to pcm
+    void pcmFromInt16(const int16_t* in, float* pcm, size_t samples);
+
+    // Scalar versions of the functions above. Every simd kernel must give the same results as these.
+    float pcmVolumeSlow(const float* pcm, size_t samples);
+    float pcmSumSquaresSlow(const float* pcm, size_t samples);
+    void pcmMixSlow(float* dest, const float* src, size_t samples, float gain);
+    size_t pcmZeroCrossingsSlow(const float* pcm, size_t samples);
+    void pcmGainSlow(float* pcm, size_t samples, float gain);
+    void pcmClampSlow(float* pcm, size_t samples, float limit = 1.f);
+    void pcmSoftClipSlow(float* pcm, size_t samples);
+    float pcmPeakSlow(const float* pcm, size_t samples);
+    void pcmToInt16Slow(const float* pcm, int16_t* out, size_t samples);
+    void pcmFromInt16Slow(const int16_t* in, float* pcm, size_t samples);
+}
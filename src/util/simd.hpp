@@ -4,6 +4,16 @@
 
 namespace util::simd {
     float calcPcmVolume(const float* pcm, size_t samples);
+    float calcPcmSumSquares(const float* pcm, size_t samples);
+    void mixPcm(float* dest, const float* src, size_t samples, float gain);
+    size_t countPcmZeroCrossings(const float* pcm, size_t samples);
+    void applyPcmGain(float* pcm, size_t samples, float gain);
+    void clampPcm(float* pcm, size_t samples, float limit);
+    void softClipPcm(float* pcm, size_t samples);
+    float calcPcmPeak(const float* pcm, size_t samples);
+    void pcmToInt16(const float* pcm, int16_t* out, size_t samples);
+    void pcmFromInt16(const int16_t* in, float* pcm, size_t samples);
+    void lerpArrays(const float* from, const float* to, const float* ratio, float* out, size_t count);
 
     uint32_t adler32(const uint8_t* data, size_t len);
 }
\ No newline at end of file
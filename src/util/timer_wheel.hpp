@@ -0,0 +1,304 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace util::time {
+    // Hierarchical timer wheel. Scheduling and cancelling are O(1), and advancing only visits the timers that expire
+    // (plus, once every 64 ticks, the ones that move down to a finer level).
+    // Time is measured in integer ticks, the owner decides how long a tick is. `T` is stored by value and handed
+    // to the callback when the timer expires, so it should be something small like an id.
+    // Not thread safe.
+    template <typename T>
+    class TimerWheel {
+    public:
+        using Id = uint64_t;
+        static constexpr Id INVALID_ID = 0;
+
+        explicit TimerWheel(uint64_t startTick = 0) : current(startTick) {
+            for (auto& head : slots) {
+                head = NIL;
+            }
+        }
+
+        // schedules a timer that expires at `deadline`, or on the next `advance` if that is already in the past
+        Id schedule(uint64_t deadline, T value) {
+            uint32_t index;
+
+            if (freeHead != NIL) {
+                index = freeHead;
+                freeHead = nodes[index].next;
+            } else {
+                index = static_cast<uint32_t>(nodes.size());
+                nodes.emplace_back();
+            }
+
+            auto& node = nodes[index];
+            node.deadline = deadline;
+            node.value = std::move(value);
+            node.active = true;
+
+            this->link(index);
+            count++;
+
+            return makeId(index, node.generation);
+        }
+
+        // returns `false` if the timer already expired or was cancelled
+        bool cancel(Id id) {
+            uint32_t index;
+            if (!this->resolve(id, index)) return false;
+
+            this->unlink(index);
+            this->release(index);
+            count--;
+
+            return true;
+        }
+
+        // moves a timer to a new deadline, returns `false` if it already expired or was cancelled
+        bool reschedule(Id id, uint64_t deadline) {
+            uint32_t index;
+            if (!this->resolve(id, index)) return false;
+
+            this->unlink(index);
+            nodes[index].deadline = deadline;
+            this->link(index);
+
+            return true;
+        }
+
+        // processes every tick up to and including `tick`, calling `f(value)` for each timer that expires.
+        // `f` may schedule and cancel timers.
+        template <typename F>
+        size_t advance(uint64_t tick, F&& f) {
+            size_t expired = 0;
+
+            while (current <= tick) {
+                if (count == 0) {
+                    current = tick + 1;
+                    break;
+                }
+
+                uint64_t target = this->nextBusyTick();
+                if (target > tick) {
+                    current = tick + 1;
+                    break;
+                }
+
+                current = target;
+                uint32_t slot = current & SLOT_MASK;
+
+                // every time a level wraps around, the next slot of the level above is spread into the levels below
+                if (slot == 0) {
+                    for (uint32_t level = 1; level < LEVELS; level++) {
+                        uint32_t levelSlot = (current >> (SLOT_BITS * level)) & SLOT_MASK;
+                        this->cascade(level, levelSlot);
+
+                        if (levelSlot != 0) break;
+                    }
+                }
+
+                uint32_t& head = slots[slot];
+                while (head != NIL) {
+                    uint32_t index = head;
+                    this->unlink(index);
+
+                    // only timers scheduled further away than the wheel spans can get here early
+                    if (nodes[index].deadline > current) {
+                        this->link(index);
+                        continue;
+                    }
+
+                    T value = std::move(nodes[index].value);
+                    this->release(index);
+                    count--;
+                    expired++;
+
+                    f(value);
+                }
+
+                if (head == NIL) {
+                    occupied[0] &= ~(uint64_t(1) << slot);
+                }
+
+                current++;
+            }
+
+            return expired;
+        }
+
+        size_t size() const {
+            return count;
+        }
+
+        // the next tick that `advance` will process
+        uint64_t now() const {
+            return current;
+        }
+
+        void clear() {
+            nodes.clear();
+            freeHead = NIL;
+            count = 0;
+
+            for (auto& mask : occupied) {
+                mask = 0;
+            }
+
+            for (auto& head : slots) {
+                head = NIL;
+            }
+        }
+
+    private:
+        static constexpr uint32_t SLOT_BITS = 6;
+        static constexpr uint32_t SLOTS = 1 << SLOT_BITS;
+        static constexpr uint32_t SLOT_MASK = SLOTS - 1;
+        static constexpr uint32_t LEVELS = 4;
+        // 2^24 ticks, anything further away is parked in the top level and rescheduled as it comes closer
+        static constexpr uint64_t SPAN = uint64_t(1) << (SLOT_BITS * LEVELS);
+        static constexpr uint32_t NIL = UINT32_MAX;
+
+        struct Node {
+            uint64_t deadline = 0;
+            T value{};
+            uint32_t prev = NIL, next = NIL;
+            uint32_t slot = NIL;
+            // bumped every time the node is reused, so that stale ids don't match
+            uint32_t generation = 1;
+            bool active = false;
+        };
+
+        std::vector<Node> nodes;
+        uint32_t slots[SLOTS * LEVELS];
+        // bit per non-empty slot, for every level
+        uint64_t occupied[LEVELS] = {};
+        uint32_t freeHead = NIL;
+        uint64_t current;
+        size_t count = 0;
+
+        static Id makeId(uint32_t index, uint32_t generation) {
+            return (static_cast<Id>(generation) << 32) | index;
+        }
+
+        bool resolve(Id id, uint32_t& index) const {
+            index = static_cast<uint32_t>(id);
+            uint32_t generation = static_cast<uint32_t>(id >> 32);
+
+            return index < nodes.size() && nodes[index].active && nodes[index].generation == generation;
+        }
+
+        uint32_t slotFor(uint64_t deadline) const {
+            if (deadline < current) deadline = current;
+
+            uint64_t delta = deadline - current;
+            if (delta >= SPAN) {
+                deadline = current + SPAN - 1;
+                delta = SPAN - 1;
+            }
+
+            uint32_t level = 0;
+            while (delta >= (uint64_t(1) << (SLOT_BITS * (level + 1)))) {
+                level++;
+            }
+
+            return level * SLOTS + static_cast<uint32_t>((deadline >> (SLOT_BITS * level)) & SLOT_MASK);
+        }
+
+        void link(uint32_t index) {
+            auto& node = nodes[index];
+            uint32_t slot = this->slotFor(node.deadline);
+
+            node.slot = slot;
+            node.prev = NIL;
+            node.next = slots[slot];
+
+            if (node.next != NIL) {
+                nodes[node.next].prev = index;
+            }
+
+            slots[slot] = index;
+            occupied[slot / SLOTS] |= uint64_t(1) << (slot % SLOTS);
+        }
+
+        void unlink(uint32_t index) {
+            auto& node = nodes[index];
+
+            if (node.prev != NIL) {
+                nodes[node.prev].next = node.next;
+            } else {
+                slots[node.slot] = node.next;
+
+                if (node.next == NIL) {
+                    occupied[node.slot / SLOTS] &= ~(uint64_t(1) << (node.slot % SLOTS));
+                }
+            }
+
+            if (node.next != NIL) {
+                nodes[node.next].prev = node.prev;
+            }
+
+            node.prev = node.next = NIL;
+            node.slot = NIL;
+        }
+
+        void release(uint32_t index) {
+            auto& node = nodes[index];
+            node.active = false;
+            node.value = T{};
+            node.generation++;
+            node.next = freeHead;
+            freeHead = index;
+        }
+
+        // the first tick from `current` onwards where a slot has to be expired or cascaded
+        uint64_t nextBusyTick() const {
+            uint32_t slot = current & SLOT_MASK;
+
+            if (slot != 0) {
+                uint64_t pending = occupied[0] >> slot;
+                if (pending != 0) {
+                    return current + std::countr_zero(pending);
+                }
+            }
+
+            uint64_t boundary = slot == 0 ? current : (current | SLOT_MASK) + 1;
+
+            while (true) {
+                // whatever is left in the first level belongs to the rotation that starts here
+                if (occupied[0] != 0) return boundary;
+
+                for (uint32_t level = 1; level < LEVELS; level++) {
+                    uint32_t levelSlot = (boundary >> (SLOT_BITS * level)) & SLOT_MASK;
+                    if (occupied[level] & (uint64_t(1) << levelSlot)) return boundary;
+                    if (levelSlot != 0) break;
+                }
+
+                // jump to the next occupied slot of the second level, or to where the second level wraps around
+                uint32_t slot1 = (boundary >> SLOT_BITS) & SLOT_MASK;
+                uint64_t pending = slot1 == SLOT_MASK ? 0 : occupied[1] >> (slot1 + 1);
+
+                if (pending != 0) {
+                    boundary = ((boundary >> SLOT_BITS) + 1 + std::countr_zero(pending)) << SLOT_BITS;
+                } else {
+                    boundary = ((boundary >> (SLOT_BITS * 2)) + 1) << (SLOT_BITS * 2);
+                }
+            }
+        }
+
+        void cascade(uint32_t level, uint32_t slot) {
+            uint32_t index = slots[level * SLOTS + slot];
+            slots[level * SLOTS + slot] = NIL;
+            occupied[level] &= ~(uint64_t(1) << slot);
+
+            while (index != NIL) {
+                uint32_t next = nodes[index].next;
+                this->link(index);
+                index = next;
+            }
+        }
+    };
+}
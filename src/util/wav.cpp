@@ -0,0 +1,138 @@
+#include "wav.hpp"
+
+#include <util/pcm.hpp>
+
+#include <fstream>
+
+using namespace geode::prelude;
+
+namespace util::wav {
+    constexpr uint16_t FORMAT_PCM = 1;
+    constexpr uint16_t FORMAT_FLOAT = 3;
+
+    // wav is little endian, as are all the platforms we run on, so fields can be copied as is
+    template <typename T>
+    static T readLe(const std::vector<uint8_t>& data, size_t offset) {
+        T out;
+        std::memcpy(&out, data.data() + offset, sizeof(T));
+        return out;
+    }
+
+    template <typename T>
+    static void writeLe(std::ofstream& file, T value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    Result<WavData> readFile(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            return Err(fmt::format("failed to open {}", path.string()));
+        }
+
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        if (data.size() < 12 || std::memcmp(data.data(), "RIFF", 4) != 0 || std::memcmp(data.data() + 8, "WAVE", 4) != 0) {
+            return Err("not a wav file");
+        }
+
+        uint16_t format = 0, channels = 0, bitsPerSample = 0;
+        uint32_t sampleRate = 0;
+        size_t dataOffset = 0, dataSize = 0;
+
+        // walk the chunks, we only care about "fmt " and "data"
+        size_t pos = 12;
+        while (pos + 8 <= data.size()) {
+            uint32_t chunkSize = readLe<uint32_t>(data, pos + 4);
+            size_t body = pos + 8;
+
+            if (body + chunkSize > data.size()) {
+                chunkSize = data.size() - body;
+            }
+
+            if (std::memcmp(data.data() + pos, "fmt ", 4) == 0 && chunkSize >= 16) {
+                format = readLe<uint16_t>(data, body);
+                channels = readLe<uint16_t>(data, body + 2);
+                sampleRate = readLe<uint32_t>(data, body + 4);
+                bitsPerSample = readLe<uint16_t>(data, body + 14);
+            } else if (std::memcmp(data.data() + pos, "data", 4) == 0) {
+                dataOffset = body;
+                dataSize = chunkSize;
+            }
+
+            // chunks are padded to an even size
+            pos = body + chunkSize + (chunkSize & 1);
+        }
+
+        if (channels == 0 || dataOffset == 0) {
+            return Err("wav file is missing the fmt or data chunk");
+        }
+
+        bool isInt16 = format == FORMAT_PCM && bitsPerSample == 16;
+        bool isFloat = format == FORMAT_FLOAT && bitsPerSample == 32;
+
+        if (!isInt16 && !isFloat) {
+            return Err(fmt::format("unsupported wav format {} with {} bits per sample", format, bitsPerSample));
+        }
+
+        size_t frameBytes = channels * (bitsPerSample / 8);
+        size_t frames = dataSize / frameBytes;
+
+        WavData out;
+        out.sampleRate = sampleRate;
+        out.samples.resize(frames);
+
+        // mono is by far the most common case, convert it in bulk
+        if (channels == 1) {
+            if (isFloat) {
+                std::memcpy(out.samples.data(), data.data() + dataOffset, frames * sizeof(float));
+            } else {
+                std::vector<int16_t> raw(frames);
+                std::memcpy(raw.data(), data.data() + dataOffset, frames * sizeof(int16_t));
+                util::misc::pcmFromInt16(raw.data(), out.samples.data(), frames);
+            }
+
+            return Ok(std::move(out));
+        }
+
+        for (size_t i = 0; i < frames; i++) {
+            float sum = 0.f;
+
+            for (size_t ch = 0; ch < channels; ch++) {
+                size_t offset = dataOffset + i * frameBytes + ch * (bitsPerSample / 8);
+                sum += isFloat ? readLe<float>(data, offset) : static_cast<float>(readLe<int16_t>(data, offset)) / 32768.f;
+            }
+
+            out.samples[i] = sum / channels;
+        }
+
+        return Ok(std::move(out));
+    }
+
+    Result<> writeFile(const std::filesystem::path& path, const float* samples, size_t count, int sampleRate) {
+        std::ofstream file(path, std::ios::binary);
+        if (!file) {
+            return Err(fmt::format("failed to open {}", path.string()));
+        }
+
+        uint32_t dataSize = count * sizeof(float);
+
+        file.write("RIFF", 4);
+        writeLe<uint32_t>(file, 4 + (8 + 16) + (8 + dataSize));
+        file.write("WAVE", 4);
+
+        file.write("fmt ", 4);
+        writeLe<uint32_t>(file, 16);
+        writeLe<uint16_t>(file, FORMAT_FLOAT);
+        writeLe<uint16_t>(file, 1); // channels
+        writeLe<uint32_t>(file, sampleRate);
+        writeLe<uint32_t>(file, sampleRate * sizeof(float)); // byte rate
+        writeLe<uint16_t>(file, sizeof(float)); // block align
+        writeLe<uint16_t>(file, 32); // bits per sample
+
+        file.write("data", 4);
+        writeLe<uint32_t>(file, dataSize);
+        file.write(reinterpret_cast<const char*>(samples), dataSize);
+
+        return Ok();
+    }
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <defs/geode.hpp>
+
+#include <filesystem>
+#include <vector>
+
+// Minimal WAV file support, used for feeding recorded audio into the voice pipeline without a microphone.
+namespace util::wav {
+    struct WavData {
+        std::vector<float> samples; // mono
+        int sampleRate;
+    };
+
+    // Reads a 16-bit integer or 32-bit float PCM wav file. Multichannel files are downmixed to mono.
+    Result<WavData> readFile(const std::filesystem::path& path);
+
+    // Writes mono 32-bit float samples into a wav file.
+    Result<> writeFile(const std::filesystem::path& path, const float* samples, size_t count, int sampleRate);
+}
@@ -0,0 +1,405 @@
+#include <audio/backend/file_backend.hpp>
+#include <audio/constants.hpp>
+#include <audio/encoder.hpp>
+#include <audio/frame.hpp>
+#include <audio/stream.hpp>
+#include <util/wav.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <numbers>
+#include <thread>
+
+#include "check.hpp"
+
+// The voice pipeline without the game: capture from `FileAudioBackend`, opus encoding, `EncodedAudioFrame` on the wire,
+// decoding in `AudioStream` and playback mixed by the backend again. Time only moves when the tests advance the backend.
+
+namespace {
+    constexpr size_t STEP = VOICE_STREAMING_FRAMESIZE;
+
+    // two tones that repeat exactly every 100ms, so the output can be lined up with the source
+    constexpr size_t SOURCE_PERIOD = VOICE_TARGET_SAMPLERATE / 10;
+
+    std::vector<float> makeSource() {
+        std::vector<float> out(SOURCE_PERIOD);
+        for (size_t i = 0; i < out.size(); i++) {
+            float t = static_cast<float>(i) / static_cast<float>(SOURCE_PERIOD);
+            out[i] = 0.3f * std::sin(2.f * std::numbers::pi_v<float> * 30.f * t)
+                + 0.15f * std::sin(2.f * std::numbers::pi_v<float> * 73.f * t);
+        }
+
+        return out;
+    }
+
+    float rms(const float* pcm, size_t samples) {
+        double sum = 0.0;
+        for (size_t i = 0; i < samples; i++) {
+            sum += static_cast<double>(pcm[i]) * pcm[i];
+        }
+
+        return static_cast<float>(std::sqrt(sum / static_cast<double>(std::max<size_t>(samples, 1))));
+    }
+
+    // the best normalized correlation between `pcm` and the looping `source`, over every offset into the source
+    float bestCorrelation(const float* pcm, size_t samples, const std::vector<float>& source) {
+        float best = -1.f;
+
+        for (size_t lag = 0; lag < source.size(); lag++) {
+            double dot = 0.0, a = 0.0, b = 0.0;
+            for (size_t i = 0; i < samples; i++) {
+                float s = source[(i + lag) % source.size()];
+                dot += static_cast<double>(pcm[i]) * s;
+                a += static_cast<double>(pcm[i]) * pcm[i];
+                b += static_cast<double>(s) * s;
+            }
+
+            if (a > 0.0 && b > 0.0) {
+                best = std::max(best, static_cast<float>(dot / std::sqrt(a * b)));
+            }
+        }
+
+        return best;
+    }
+
+    AudioDecoder makeDecoder() {
+        return AudioDecoder(VOICE_TARGET_SAMPLERATE, VOICE_TARGET_FRAMESIZE, VOICE_CHANNELS);
+    }
+
+    // encodes consecutive 20ms frames of the source, like low latency voice does
+    struct StreamingEncoder {
+        AudioEncoder encoder{VOICE_TARGET_SAMPLERATE, VOICE_STREAMING_FRAMESIZE, VOICE_CHANNELS};
+        std::vector<float> source = makeSource();
+        size_t pos = 0;
+        util::data::byte buf[VOICE_MAX_BYTES_IN_FRAME];
+
+        EncodedOpusData next() {
+            float pcm[VOICE_STREAMING_FRAMESIZE];
+            for (auto& s : pcm) {
+                s = source[pos];
+                pos = (pos + 1) % source.size();
+            }
+
+            size_t written = encoder.encode(pcm, buf).unwrap();
+            return EncodedOpusData { .ptr = buf, .length = static_cast<int64_t>(written) };
+        }
+    };
+
+    size_t drain(AudioStream& stream) {
+        std::vector<float> out(VOICE_TARGET_SAMPLERATE);
+        return stream.readSamples(out.data(), out.size());
+    }
+}
+
+TEST_CASE(pipeline_through_file_backend) {
+    constexpr size_t SECONDS = 3;
+
+    auto source = makeSource();
+
+    FileAudioBackend backend;
+    backend.setCaptureData(source);
+
+    size_t packets = 0;
+
+    {
+        AudioEncoder encoder(VOICE_TARGET_SAMPLERATE, VOICE_TARGET_FRAMESIZE, VOICE_CHANNELS);
+        AudioStream stream(makeDecoder(), &backend);
+        CHECK(stream.isStandalone());
+        stream.setVolume(1.f);
+        stream.start();
+
+        EncodedAudioFrame frame(EncodedAudioFrame::LIMIT_LOW_LATENCY);
+        AudioSampleQueue captured;
+        ByteBuffer network;
+
+        CHECK(backend.startCapture(0).isOk());
+
+        for (size_t clock = 0; clock < SECONDS * VOICE_TARGET_SAMPLERATE; clock += STEP) {
+            backend.advance(STEP);
+            CHECK(backend.readCapture(&captured).isOk());
+
+            while (captured.size() >= VOICE_TARGET_FRAMESIZE) {
+                float pcm[VOICE_TARGET_FRAMESIZE];
+                captured.copyTo(pcm, VOICE_TARGET_FRAMESIZE);
+
+                auto space = frame.reserveOpusFrame().unwrap();
+                frame.commitOpusFrame(encoder.encode(pcm, space).unwrap());
+
+                if (frame.size() < frame.capacity()) continue;
+
+                network = ByteBuffer();
+                network.writeValue(frame);
+                frame.clear();
+                packets++;
+
+                network.setPosition(0);
+                auto received = network.readValue<EncodedAudioFrame>();
+                CHECK(received.isOk());
+                CHECK(stream.writeData(received.unwrap()).isOk());
+            }
+        }
+
+        backend.stopCapture();
+    }
+
+    CHECK_EQ(backend.getClock(), SECONDS * VOICE_TARGET_SAMPLERATE);
+
+    // 5 opus frames of 60ms in every packet
+    CHECK_EQ(packets, SECONDS * VOICE_TARGET_SAMPLERATE / (VOICE_TARGET_FRAMESIZE * EncodedAudioFrame::LIMIT_LOW_LATENCY));
+
+    // the first packet is out after 300ms, by the last second playback has long caught up
+    auto output = backend.getOutput();
+    CHECK_EQ(output.size(), SECONDS * VOICE_TARGET_SAMPLERATE);
+
+    const float* window = output.data() + (SECONDS - 1) * VOICE_TARGET_SAMPLERATE;
+    size_t windowSize = SOURCE_PERIOD * 2;
+
+    float outRms = rms(window, windowSize);
+    float srcRms = rms(source.data(), source.size());
+    float correlation = bestCorrelation(window, windowSize, source);
+
+    std::printf("  %zu packets, output rms %.3f (source %.3f), correlation %.3f\n", packets, outRms, srcRms, correlation);
+
+    CHECK(outRms > srcRms * 0.8f && outRms < srcRms * 1.25f);
+    CHECK(correlation > 0.9f);
+}
+
+TEST_CASE(volume_and_stopped_outputs) {
+    FileAudioBackend backend;
+
+    std::vector<float> pcm(STEP, 0.5f);
+
+    {
+        AudioStream loud(makeDecoder(), &backend), quiet(makeDecoder(), &backend), stopped(makeDecoder(), &backend);
+        loud.setVolume(1.f);
+        quiet.setVolume(0.5f);
+        loud.start();
+        quiet.start();
+
+        loud.writeData(pcm.data(), pcm.size());
+        quiet.writeData(pcm.data(), pcm.size());
+        stopped.writeData(pcm.data(), pcm.size());
+
+        // the second step has nothing left to play
+        backend.advance(STEP);
+        backend.advance(STEP);
+
+        CHECK(loud.starving);
+        CHECK_EQ(drain(stopped), STEP);
+    }
+
+    auto output = backend.getOutput();
+    CHECK_EQ(output.size(), 2 * STEP);
+    CHECK(std::abs(output[0] - 0.75f) < 1e-6f);
+    CHECK(std::abs(output[STEP - 1] - 0.75f) < 1e-6f);
+    CHECK(output[STEP] == 0.f);
+    CHECK(output[2 * STEP - 1] == 0.f);
+}
+
+TEST_CASE(non_standalone_pads_with_silence) {
+    AudioStream stream(makeDecoder(), nullptr);
+    CHECK(!stream.isStandalone());
+
+    std::vector<float> pcm(100, 0.25f);
+    stream.writeData(pcm.data(), pcm.size());
+
+    std::vector<float> out(200, 1.f);
+    CHECK_EQ(stream.readSamples(out.data(), out.size()), 100);
+    CHECK(stream.starving);
+    CHECK(out[99] == 0.25f);
+    CHECK(out[100] == 0.f);
+    CHECK(out[199] == 0.f);
+}
+
+TEST_CASE(sequenced_frames) {
+    StreamingEncoder enc;
+    AudioStream stream(makeDecoder(), nullptr);
+
+    auto write = [&](uint32_t sequence) {
+        CHECK(stream.writeSequencedData(sequence, enc.next()).isOk());
+    };
+
+    write(0);
+    write(1);
+    CHECK_EQ(drain(stream), 2 * STEP);
+
+    // 2 and 3 are lost, and get concealed when 4 arrives
+    write(4);
+    CHECK_EQ(drain(stream), 3 * STEP);
+
+    // late and duplicate frames are dropped
+    write(3);
+    write(4);
+    CHECK_EQ(drain(stream), 0);
+
+    // too big of a gap to conceal, playback continues from the new frame
+    write(20);
+    CHECK_EQ(drain(stream), STEP);
+
+    // far behind means that the sender started over
+    write(100);
+    write(0);
+    write(1);
+    CHECK_EQ(drain(stream), 3 * STEP);
+}
+
+TEST_CASE(frame_wire_format) {
+    StreamingEncoder enc;
+
+    EncodedAudioFrame frame(EncodedAudioFrame::LIMIT_LOW_LATENCY);
+    std::vector<std::vector<util::data::byte>> sent;
+
+    for (size_t i = 0; i < 3; i++) {
+        auto data = enc.next();
+        sent.emplace_back(data.ptr, data.ptr + data.length);
+        CHECK(frame.pushOpusFrame(data).isOk());
+    }
+
+    ByteBuffer buf;
+    buf.writeValue(frame);
+
+    // every slot is an optional, the empty ones are a single byte
+    size_t expected = EncodedAudioFrame::VOICE_MAX_FRAMES_IN_AUDIO_FRAME;
+    for (auto& s : sent) {
+        expected += sizeof(uint32_t) + s.size();
+    }
+
+    CHECK_EQ(buf.size(), expected);
+
+    buf.setPosition(0);
+    auto decoded = buf.readValue<EncodedAudioFrame>();
+    CHECK(decoded.isOk());
+
+    const auto& frames = decoded.unwrap().getFrames();
+    CHECK_EQ(frames.size(), sent.size());
+
+    for (size_t i = 0; i < std::min(frames.size(), sent.size()); i++) {
+        CHECK(std::vector<util::data::byte>(frames[i].ptr, frames[i].ptr + frames[i].length) == sent[i]);
+    }
+
+    // a frame can't hold more than its capacity
+    for (size_t i = 3; i < EncodedAudioFrame::LIMIT_LOW_LATENCY; i++) {
+        CHECK(frame.pushOpusFrame(enc.next()).isOk());
+    }
+
+    CHECK(frame.pushOpusFrame(enc.next()).isErr());
+    CHECK(frame.reserveOpusFrame().isErr());
+}
+
+TEST_CASE(frame_rejects_bad_data) {
+    ByteBuffer tooLong;
+    tooLong.writeBool(true);
+    tooLong.writeU32(VOICE_MAX_BYTES_IN_FRAME + 1);
+    tooLong.setPosition(0);
+
+    auto res = tooLong.readValue<EncodedAudioFrame>();
+    CHECK(res.isErr() && res.unwrapErr() == ByteBuffer::DecodeError::DataTooLong);
+
+    ByteBuffer truncated;
+    truncated.writeBool(true);
+    truncated.writeU32(100);
+    truncated.setPosition(0);
+
+    res = truncated.readValue<EncodedAudioFrame>();
+    CHECK(res.isErr() && res.unwrapErr() == ByteBuffer::DecodeError::NotEnoughData);
+}
+
+TEST_CASE(capture_from_wav_file) {
+    auto source = makeSource();
+    auto path = std::filesystem::temp_directory_path() / "globed-audio-pipeline-test.wav";
+
+    CHECK(util::wav::writeFile(path, source.data(), source.size(), VOICE_TARGET_SAMPLERATE).isOk());
+
+    FileAudioBackend backend;
+    CHECK(backend.setCaptureFile(path).isOk());
+    std::filesystem::remove(path);
+
+    CHECK(backend.readCapture(nullptr).isErr());
+    CHECK(backend.startCapture(0).isOk());
+
+    // goes past the end of the file, which loops
+    backend.advance(source.size() + STEP);
+
+    AudioSampleQueue captured;
+    CHECK_EQ(backend.readCapture(&captured).unwrap(), source.size() + STEP);
+    std::vector<float> pcm(source.size() + STEP);
+    CHECK_EQ(captured.copyTo(pcm.data(), pcm.size()), pcm.size());
+    CHECK(std::equal(source.begin(), source.end(), pcm.begin()));
+    CHECK(std::equal(source.begin(), source.begin() + STEP, pcm.begin() + source.size()));
+
+    // a second read only has what was captured since the first one
+    CHECK_EQ(backend.readCapture(nullptr).unwrap(), 0);
+}
+
+TEST_CASE(sample_queue_wraps_around) {
+    AudioSampleQueue queue(5);
+    CHECK_EQ(queue.capacity(), 8);
+
+    float in[8], out[8];
+    for (size_t i = 0; i < 8; i++) in[i] = static_cast<float>(i);
+
+    CHECK_EQ(queue.writeData(in, 5), 5);
+    CHECK_EQ(queue.copyTo(out, 3), 3);
+    CHECK(out[0] == 0.f && out[2] == 2.f);
+
+    // the next write goes over the end of the buffer, and what doesn't fit is dropped
+    CHECK_EQ(queue.writeData(in, 8), 6);
+    CHECK_EQ(queue.size(), 8);
+    CHECK_EQ(queue.writeData(in, 1), 0);
+
+    CHECK_EQ(queue.copyTo(out, 8), 8);
+    CHECK(out[0] == 3.f && out[1] == 4.f);
+    for (size_t i = 0; i < 6; i++) {
+        CHECK(out[2 + i] == static_cast<float>(i));
+    }
+
+    CHECK_EQ(queue.copyTo(out, 8), 0);
+
+    CHECK_EQ(queue.writeData(in, 4), 4);
+    queue.clear();
+    CHECK_EQ(queue.size(), 0);
+    CHECK_EQ(queue.copyTo(out, 8), 0);
+}
+
+TEST_CASE(sample_queue_across_threads) {
+    constexpr size_t TOTAL = 200000;
+
+    AudioSampleQueue queue(1024);
+
+    // odd chunk sizes on both sides, so the positions keep moving relative to each other
+    std::thread producer([&] {
+        float chunk[97];
+        size_t next = 0;
+
+        while (next < TOTAL) {
+            size_t count = std::min<size_t>(97, TOTAL - next);
+            for (size_t i = 0; i < count; i++) chunk[i] = static_cast<float>(next + i);
+
+            next += queue.writeData(chunk, count);
+        }
+    });
+
+    float chunk[61];
+    size_t expected = 0;
+    bool ordered = true;
+
+    while (expected < TOTAL) {
+        size_t count = queue.copyTo(chunk, 61);
+        for (size_t i = 0; i < count; i++) {
+            ordered = ordered && chunk[i] == static_cast<float>(expected + i);
+        }
+
+        expected += count;
+    }
+
+    producer.join();
+
+    CHECK(ordered);
+    CHECK_EQ(expected, TOTAL);
+    CHECK_EQ(queue.size(), 0);
+}
+
+int main() {
+    return test::runAll();
+}
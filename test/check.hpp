@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+// Minimal test harness, so that the tests don't need anything besides the standard library.
+// Each file defines its cases with `TEST_CASE(name) { ... }` and calls `test::runAll()` from main.
+
+namespace test {
+    struct Case {
+        const char* name;
+        void (*func)();
+    };
+
+    inline std::vector<Case>& registry() {
+        static std::vector<Case> cases;
+        return cases;
+    }
+
+    inline int& currentFailures() {
+        static int failures = 0;
+        return failures;
+    }
+
+    struct Registrar {
+        Registrar(const char* name, void (*func)()) {
+            registry().push_back(Case{name, func});
+        }
+    };
+
+    inline int runAll() {
+        int failed = 0;
+
+        for (auto& c : registry()) {
+            currentFailures() = 0;
+            c.func();
+
+            if (currentFailures() == 0) {
+                std::printf("[ OK ] %s\n", c.name);
+            } else {
+                std::printf("[FAIL] %s (%d failed checks)\n", c.name, currentFailures());
+                failed++;
+            }
+        }
+
+        std::printf("%zu cases, %d failed\n", registry().size(), failed);
+        return failed == 0 ? 0 : 1;
+    }
+}
+
+#define TEST_CASE(name) \
+    static void name(); \
+    static test::Registrar name##_registrar(#name, &name); \
+    static void name()
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::printf("  %s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            test::currentFailures()++; \
+        } \
+    } while (0)
+
+#define CHECK_EQ(a, b) \
+    do { \
+        auto _a = static_cast<long long>(a); auto _b = static_cast<long long>(b); \
+        if (_a != _b) { \
+            std::printf("  %s:%d: check failed: %s == %s (%lld vs %lld)\n", __FILE__, __LINE__, #a, #b, _a, _b); \
+            test::currentFailures()++; \
+        } \
+    } while (0)
@@ -0,0 +1,220 @@
+#include <game/collision_grid.hpp>
+
+#include <algorithm>
+#include <random>
+#include <utility>
+
+#include "check.hpp"
+
+using cocos2d::CCRect;
+
+// Every query is checked against the plain loop over all rects that the grid replaces.
+
+namespace {
+    struct Scene {
+        std::vector<CCRect> rects;
+        CollisionGrid grid;
+
+        void add(const CCRect& rect) {
+            grid.insert(rect, static_cast<uint32_t>(rects.size()));
+            rects.push_back(rect);
+        }
+
+        std::vector<uint32_t> bruteForce(const CCRect& query) const {
+            std::vector<uint32_t> out;
+            for (size_t i = 0; i < rects.size(); i++) {
+                if (query.intersectsRect(rects[i])) {
+                    out.push_back(static_cast<uint32_t>(i));
+                }
+            }
+
+            return out;
+        }
+
+        // returns false if the grid reported anything twice or found something else than the loop
+        bool matches(const CCRect& query) const {
+            std::vector<uint32_t> found;
+            grid.query(query, [&](uint32_t id, const CCRect&) {
+                found.push_back(id);
+            });
+
+            std::sort(found.begin(), found.end());
+            bool unique = std::adjacent_find(found.begin(), found.end()) == found.end();
+
+            if (!unique || found != this->bruteForce(query)) {
+                std::printf(
+                    "  query at (%.2f, %.2f) %.2fx%.2f: grid found %zu%s, brute force %zu\n",
+                    query.getMinX(), query.getMinY(), query.size.width, query.size.height,
+                    found.size(), unique ? "" : " with duplicates", this->bruteForce(query).size()
+                );
+                return false;
+            }
+
+            return true;
+        }
+    };
+
+    CCRect randomRect(std::mt19937& rng, float extent, float minSize, float maxSize) {
+        std::uniform_real_distribution<float> pos(-extent, extent);
+        std::uniform_real_distribution<float> size(minSize, maxSize);
+        return CCRect{pos(rng), pos(rng), size(rng), size(rng)};
+    }
+}
+
+TEST_CASE(random_rects) {
+    std::mt19937 rng(1);
+
+    Scene scene;
+    for (int i = 0; i < 500; i++) {
+        scene.add(randomRect(rng, 2000.f, 5.f, CollisionGrid::CELL_SIZE));
+    }
+
+    scene.grid.build();
+    CHECK_EQ(scene.grid.size(), 500);
+
+    for (int i = 0; i < 500; i++) {
+        CHECK(scene.matches(randomRect(rng, 2100.f, 1.f, 200.f)));
+    }
+}
+
+TEST_CASE(oversized_entries) {
+    std::mt19937 rng(2);
+
+    Scene scene;
+    for (int i = 0; i < 100; i++) {
+        scene.add(randomRect(rng, 1000.f, 10.f, 30.f));
+    }
+
+    // wider or taller than a cell, and exactly one cell large, which still fits
+    scene.add(CCRect{-500.f, 0.f, 1000.f, 20.f});
+    scene.add(CCRect{300.f, -900.f, 10.f, 1800.f});
+    scene.add(CCRect{-100.f, -100.f, CollisionGrid::CELL_SIZE + 0.01f, 5.f});
+    scene.add(CCRect{128.f, 128.f, CollisionGrid::CELL_SIZE, CollisionGrid::CELL_SIZE});
+    scene.grid.build();
+
+    for (int i = 0; i < 300; i++) {
+        CHECK(scene.matches(randomRect(rng, 1100.f, 1.f, 50.f)));
+    }
+
+    // far from any grid entry, only the oversized ones can be hit
+    CHECK(scene.matches(CCRect{-490.f, 5.f, 1.f, 1.f}));
+    CHECK(scene.matches(CCRect{301.f, 850.f, 1.f, 1.f}));
+    CHECK(scene.matches(CCRect{191.f, 191.f, 2.f, 2.f}));
+}
+
+TEST_CASE(negative_coordinates) {
+    Scene scene;
+
+    // around the origin and on cell borders on the negative side, where truncating instead of flooring would go wrong
+    const float coords[] = {-128.f, -64.5f, -64.f, -63.5f, -32.f, -0.5f, -0.f, 0.f, 0.5f, 63.5f, 64.f};
+    for (float x : coords) {
+        for (float y : coords) {
+            scene.add(CCRect{x, y, 1.f, 1.f});
+        }
+    }
+
+    scene.grid.build();
+
+    for (float x : coords) {
+        for (float y : coords) {
+            CHECK(scene.matches(CCRect{x, y, 0.f, 0.f}));
+            CHECK(scene.matches(CCRect{x - 0.75f, y - 0.75f, 0.5f, 0.5f}));
+            CHECK(scene.matches(CCRect{x + 1.f, y + 1.f, 10.f, 10.f}));
+        }
+    }
+
+    // garbage positions get clamped instead of overflowing
+    scene.add(CCRect{-1e30f, -1e30f, 1.f, 1.f});
+    scene.grid.clear();
+    for (size_t i = 0; i < scene.rects.size(); i++) {
+        scene.grid.insert(scene.rects[i], static_cast<uint32_t>(i));
+    }
+    scene.grid.build();
+
+    CHECK(scene.matches(CCRect{-1e30f, -1e30f, 2.f, 2.f}));
+    CHECK(scene.matches(CCRect{-10.f, -10.f, 20.f, 20.f}));
+}
+
+TEST_CASE(shared_buckets) {
+    // a fully occupied 32x32 block of cells, so that every query spans cells that share a bucket with each other.
+    // an entry from a cell that merely shares the bucket must not be reported, and nothing may be reported twice
+    Scene scene;
+    for (int cy = -16; cy < 16; cy++) {
+        for (int cx = -16; cx < 16; cx++) {
+            float x = cx * CollisionGrid::CELL_SIZE + 10.f;
+            float y = cy * CollisionGrid::CELL_SIZE + 10.f;
+            scene.add(CCRect{x, y, 50.f, 50.f});
+        }
+    }
+
+    scene.grid.build();
+
+    std::mt19937 rng(3);
+    for (int i = 0; i < 500; i++) {
+        CHECK(scene.matches(randomRect(rng, 1000.f, 1.f, 600.f)));
+    }
+}
+
+TEST_CASE(huge_query_falls_back) {
+    std::mt19937 rng(4);
+
+    Scene scene;
+    for (int i = 0; i < 50; i++) {
+        scene.add(randomRect(rng, 500.f, 5.f, 60.f));
+    }
+
+    scene.grid.build();
+
+    // more cells than entries, so everything is checked instead of the cells
+    CHECK(scene.matches(CCRect{-1e6f, -1e6f, 2e6f, 2e6f}));
+    CHECK(scene.matches(CCRect{-600.f, -600.f, 1200.f, 1200.f}));
+    CHECK(scene.matches(CCRect{-600.f, 0.f, 1200.f, 1.f}));
+
+    std::vector<uint32_t> all;
+    scene.grid.query(CCRect{-1e6f, -1e6f, 2e6f, 2e6f}, [&](uint32_t id, const CCRect&) { all.push_back(id); });
+    CHECK_EQ(all.size(), 50);
+
+    // right around the point where it switches over
+    for (float size = 64.f; size < 640.f; size += 32.f) {
+        CHECK(scene.matches(CCRect{-size / 2.f, -size / 2.f, size, size}));
+    }
+}
+
+TEST_CASE(touching_edges) {
+    Scene scene;
+    scene.add(CCRect{0.f, 0.f, 10.f, 10.f});
+    scene.grid.build();
+
+    // inclusive on every side, like `CCRect::intersectsRect`
+    CHECK(scene.matches(CCRect{10.f, 0.f, 5.f, 5.f}));
+    CHECK(scene.matches(CCRect{-5.f, -5.f, 5.f, 5.f}));
+    CHECK(scene.matches(CCRect{0.f, 10.f, 0.f, 0.f}));
+    CHECK(scene.matches(CCRect{10.01f, 0.f, 5.f, 5.f}));
+}
+
+TEST_CASE(rebuild) {
+    CollisionGrid grid;
+    grid.insert(CCRect{0.f, 0.f, 10.f, 10.f}, 1);
+    grid.insert(CCRect{0.f, 0.f, 1000.f, 10.f}, 2);
+    grid.build();
+
+    grid.clear();
+    grid.build();
+    CHECK_EQ(grid.size(), 0);
+
+    size_t hits = 0;
+    grid.query(CCRect{0.f, 0.f, 10.f, 10.f}, [&](uint32_t, const CCRect&) { hits++; });
+    CHECK_EQ(hits, 0);
+
+    grid.insert(CCRect{5.f, 5.f, 10.f, 10.f}, 3);
+    grid.build();
+
+    std::vector<uint32_t> found;
+    grid.query(CCRect{0.f, 0.f, 10.f, 10.f}, [&](uint32_t id, const CCRect&) { found.push_back(id); });
+    CHECK_EQ(found.size(), 1);
+    CHECK(found.size() == 1 && found[0] == 3);
+}
+
+int main() {
+    return test::runAll();
+}
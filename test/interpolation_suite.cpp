@@ -0,0 +1,64 @@
+#include <game/interpolation_suite.hpp>
+
+#include <cstdio>
+#include <cstring>
+
+// Prints the results of `InterpolationSuite`, the same ones the in-mod benchmarks log.
+// Fails if any of them got worse than what the interpolator is known to do, see the limits below.
+
+namespace {
+    // upper bounds for the rms error, per trajectory. the wave turns sharply and the spider teleports,
+    // both of which the receiver can only show a frame late
+    float maxRmsError(const char* trajectory) {
+        if (std::strcmp(trajectory, "cube") == 0) return 4.f;
+        if (std::strcmp(trajectory, "ship") == 0) return 2.f;
+        if (std::strcmp(trajectory, "wave") == 0) return 12.f;
+        return 60.f;
+    }
+}
+
+int main() {
+    int failed = 0;
+
+    std::printf("%-8s %-30s %9s %9s %6s %12s %8s %8s\n", "", "", "rms err", "max err", "snaps", "clock snaps", "starved", "dropped");
+
+    for (const auto& result : InterpolationSuite::measureAccuracy()) {
+        std::printf(
+            "%-8s %-30s %9.2f %9.1f %6zu %12zu %8zu %8zu\n",
+            result.trajectory,
+            result.network,
+            result.rmsError,
+            result.maxError,
+            result.snaps,
+            result.clockSnaps,
+            result.starvedTicks,
+            result.droppedFrames
+        );
+
+        // the simulated networks reorder but never duplicate, and no packet is late enough to fall behind the playout
+        // clock, so every reordered frame has to make it into the history
+        bool ok = result.rmsError <= maxRmsError(result.trajectory) && result.snaps <= 1 && result.clockSnaps == 0
+            && result.droppedFrames == 0;
+
+        // nothing should go wrong on a network without jitter or loss
+        if (std::strstr(result.network, "perfect")) {
+            ok = ok && result.snaps == 0 && result.starvedTicks == 0;
+        }
+
+        if (!ok) {
+            std::printf("  ^ worse than expected\n");
+            failed++;
+        }
+    }
+
+    std::printf("\n");
+
+    for (const auto& result : InterpolationSuite::measureCost()) {
+        std::printf(
+            "%-8s %d players: %.1fns per player per tick, %.1fns per received frame\n",
+            result.trajectory, result.players, result.nanosPerPlayerTick, result.nanosPerFrame
+        );
+    }
+
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,291 @@
+#include <game/interpolator.hpp>
+#include <game/interpolation_suite.hpp>
+#include <game/player_data_receiver.hpp>
+
+#include <cmath>
+#include <thread>
+
+#include "check.hpp"
+
+using cocos2d::CCPoint;
+
+namespace {
+    constexpr float SEND_DELTA = 1.f / 30.f;
+    constexpr float RENDER_DELTA = 1.f / 240.f;
+
+    InterpolatorSettings defaultSettings() {
+        return InterpolatorSettings {
+            .realtime = false,
+            .isPlatformer = false,
+            .expectedDelta = SEND_DELTA,
+        };
+    }
+
+    PlayerData frameAt(float t) {
+        return InterpolationSuite::traceFrame(t, {100.f * t, 50.f}, 0.f);
+    }
+
+    bool near(float a, float b, float margin = 0.01f) {
+        return std::abs(a - b) <= margin;
+    }
+}
+
+TEST_CASE(unknown_players_are_reported) {
+    PlayerInterpolator interpolator(defaultSettings());
+    interpolator.addPlayer(1);
+
+    CHECK(interpolator.updatePlayer(1, frameAt(0.f)));
+    CHECK(!interpolator.updatePlayer(2, frameAt(0.f)));
+
+    std::vector<AssociatedPlayerData> frames = {
+        AssociatedPlayerData(1, frameAt(SEND_DELTA)),
+        AssociatedPlayerData(3, frameAt(SEND_DELTA)),
+        AssociatedPlayerData(4, frameAt(SEND_DELTA)),
+    };
+    std::vector<AssociatedPlayerData> unknown;
+
+    interpolator.updatePlayers(frames, unknown);
+
+    CHECK_EQ(unknown.size(), 2);
+    CHECK_EQ(unknown[0].accountId, 3);
+    CHECK_EQ(unknown[1].accountId, 4);
+    CHECK_EQ(interpolator.getPlayerStats(1).realFrames, 2);
+    CHECK(!interpolator.hasPlayer(3));
+}
+
+TEST_CASE(follows_a_steady_stream) {
+    PlayerInterpolator interpolator(defaultSettings());
+    interpolator.addPlayer(1);
+
+    float nextSend = 0.f;
+    size_t checked = 0;
+
+    for (float now = 0.f; now < 3.f; now += RENDER_DELTA) {
+        while (nextSend <= now) {
+            interpolator.updatePlayer(1, frameAt(nextSend));
+            nextSend += SEND_DELTA;
+        }
+
+        interpolator.tick(RENDER_DELTA);
+
+        // once the clock settled, the player is exactly where they were at the playout time
+        if (now > 1.f) {
+            auto stats = interpolator.getPlayerStats(1);
+            auto pos = interpolator.getPlayerState(1).player1.position;
+
+            CHECK(near(pos.x, 100.f * stats.playoutTime, 0.05f));
+            CHECK(near(pos.y, 50.f));
+            CHECK(stats.playoutTime < nextSend - SEND_DELTA);
+            checked++;
+        }
+    }
+
+    CHECK(checked > 0);
+
+    auto stats = interpolator.getPlayerStats(1);
+    CHECK_EQ(stats.starvedTicks, 0);
+    CHECK_EQ(stats.droppedFrames, 0);
+    CHECK_EQ(stats.clockSnaps, 0);
+    CHECK(stats.playoutDelay >= SEND_DELTA);
+}
+
+TEST_CASE(drops_late_frames) {
+    PlayerInterpolator interpolator(defaultSettings());
+    interpolator.addPlayer(1);
+
+    interpolator.updatePlayer(1, frameAt(1.0f));
+    interpolator.updatePlayer(1, frameAt(0.9f));
+    interpolator.updatePlayer(1, frameAt(1.0f));
+
+    auto stats = interpolator.getPlayerStats(1);
+    CHECK_EQ(stats.realFrames, 1);
+    CHECK_EQ(stats.droppedFrames, 2);
+
+    // far enough back that the sender must have restarted their clock
+    interpolator.updatePlayer(1, frameAt(-5.f));
+    stats = interpolator.getPlayerStats(1);
+    CHECK_EQ(stats.realFrames, 2);
+    CHECK_EQ(stats.droppedFrames, 2);
+}
+
+TEST_CASE(inserts_reordered_frames) {
+    PlayerInterpolator interpolator(defaultSettings());
+    interpolator.addPlayer(1);
+
+    interpolator.updatePlayer(1, frameAt(1.0f));
+    interpolator.updatePlayer(1, frameAt(1.2f));
+    interpolator.updatePlayer(1, frameAt(1.1f));
+    interpolator.updatePlayer(1, frameAt(1.1f));
+
+    auto stats = interpolator.getPlayerStats(1);
+    CHECK_EQ(stats.realFrames, 3);
+    CHECK_EQ(stats.droppedFrames, 1);
+
+    // the frame that came late is lerped from, not skipped over
+    while (interpolator.getPlayerStats(1).playoutTime < 1.15f) {
+        interpolator.tick(RENDER_DELTA);
+    }
+
+    stats = interpolator.getPlayerStats(1);
+    CHECK(stats.playoutTime < 1.2f);
+    CHECK(near(interpolator.getPlayerState(1).player1.position.x, 100.f * stats.playoutTime, 0.05f));
+}
+
+TEST_CASE(frame_flags_are_taken_once) {
+    PlayerInterpolator interpolator(defaultSettings());
+    interpolator.addPlayer(1);
+
+    auto first = frameAt(0.f);
+    first.lastDeathTimestamp = 0.f;
+    interpolator.updatePlayer(1, first);
+
+    // the first frame never counts as a death
+    CHECK(!interpolator.swapFrameFlags(1).pendingDeath);
+
+    auto died = frameAt(SEND_DELTA);
+    died.lastDeathTimestamp = SEND_DELTA;
+    died.isLastDeathReal = true;
+    died.player1.spiderTeleportData = SpiderTeleportData {.from = {0.f, 0.f}, .to = {0.f, 100.f}};
+    interpolator.updatePlayer(1, died);
+
+    auto flags = interpolator.swapFrameFlags(1);
+    CHECK(flags.pendingDeath);
+    CHECK(flags.pendingRealDeath);
+    CHECK(flags.pendingP1Teleport.has_value());
+
+    flags = interpolator.swapFrameFlags(1);
+    CHECK(!flags.pendingDeath);
+    CHECK(!flags.pendingRealDeath);
+    CHECK(!flags.pendingP1Teleport.has_value());
+}
+
+TEST_CASE(realtime_shows_the_newest_frame) {
+    auto settings = defaultSettings();
+    settings.realtime = true;
+
+    PlayerInterpolator interpolator(settings);
+    interpolator.addPlayer(1);
+
+    interpolator.updatePlayer(1, frameAt(1.f));
+    interpolator.updatePlayer(1, frameAt(2.f));
+    interpolator.tick(RENDER_DELTA);
+
+    CHECK(near(interpolator.getPlayerState(1).player1.position.x, 200.f));
+}
+
+TEST_CASE(removing_keeps_other_players) {
+    PlayerInterpolator interpolator(defaultSettings());
+
+    for (int id = 1; id <= 3; id++) {
+        interpolator.addPlayer(id);
+    }
+
+    // every player is at a different height
+    for (float t = 0.f; t < 1.f; t += SEND_DELTA) {
+        for (int id = 1; id <= 3; id++) {
+            auto data = frameAt(t);
+            data.player1.position.y = 100.f * id;
+            interpolator.updatePlayer(id, data);
+        }
+
+        for (int i = 0; i < 8; i++) {
+            interpolator.tick(RENDER_DELTA);
+        }
+    }
+
+    interpolator.removePlayer(1);
+    interpolator.tick(RENDER_DELTA);
+
+    CHECK(!interpolator.hasPlayer(1));
+    CHECK(near(interpolator.getPlayerState(2).player1.position.y, 200.f));
+    CHECK(near(interpolator.getPlayerState(3).player1.position.y, 300.f));
+    CHECK_EQ(interpolator.getPlayerStats(3).realFrames, interpolator.getPlayerStats(2).realFrames);
+}
+
+TEST_CASE(extrapolates_when_starved) {
+    auto settings = defaultSettings();
+    settings.extrapolation = true;
+
+    PlayerInterpolator interpolator(settings);
+    interpolator.addPlayer(1);
+
+    float lastSent = 0.f;
+    for (float t = 0.f; t < 1.f; t += SEND_DELTA) {
+        interpolator.updatePlayer(1, frameAt(t));
+        lastSent = t;
+
+        for (int i = 0; i < 8; i++) {
+            interpolator.tick(RENDER_DELTA);
+        }
+    }
+
+    // stop sending, the player keeps moving past the last frame, but only for a bit
+    for (int i = 0; i < 240; i++) {
+        interpolator.tick(RENDER_DELTA);
+    }
+
+    float x = interpolator.getPlayerState(1).player1.position.x;
+    CHECK(x > 100.f * lastSent + 1.f);
+    CHECK(x <= 100.f * (lastSent + 2.f * SEND_DELTA) + 0.05f);
+    CHECK(interpolator.getPlayerStats(1).extrapolatedTicks > 0);
+}
+
+TEST_CASE(receiver_hands_over_every_frame_in_order) {
+    constexpr int PACKETS = 5000;
+    constexpr int PLAYERS = 3;
+
+    PlayerInterpolator interpolator(defaultSettings());
+    PlayerDataReceiver receiver;
+
+    // nobody is added, so every frame comes back out as unknown, in the order it was applied
+    std::thread network([&] {
+        std::vector<AssociatedPlayerData> packet;
+
+        for (int i = 0; i < PACKETS; i++) {
+            packet.clear();
+            for (int id = 0; id < PLAYERS; id++) {
+                packet.emplace_back(id, frameAt(static_cast<float>(i)));
+            }
+
+            receiver.ingest(packet);
+        }
+    });
+
+    std::vector<AssociatedPlayerData> unknown;
+    while (unknown.size() < PACKETS * PLAYERS) {
+        receiver.apply(interpolator, unknown);
+    }
+
+    network.join();
+
+    CHECK(!receiver.apply(interpolator, unknown));
+    CHECK_EQ(unknown.size(), PACKETS * PLAYERS);
+
+    size_t misplaced = 0;
+    for (size_t i = 0; i < unknown.size(); i++) {
+        if (unknown[i].accountId != static_cast<int>(i % PLAYERS) || unknown[i].data.timestamp != static_cast<float>(i / PLAYERS)) {
+            misplaced++;
+        }
+    }
+
+    CHECK_EQ(misplaced, 0);
+}
+
+TEST_CASE(receiver_feeds_known_players) {
+    PlayerInterpolator interpolator(defaultSettings());
+    PlayerDataReceiver receiver;
+    interpolator.addPlayer(1);
+
+    receiver.ingest({AssociatedPlayerData(1, frameAt(0.f)), AssociatedPlayerData(2, frameAt(0.f))});
+    receiver.ingest({AssociatedPlayerData(1, frameAt(SEND_DELTA))});
+
+    std::vector<AssociatedPlayerData> unknown;
+    CHECK(receiver.apply(interpolator, unknown));
+    CHECK_EQ(unknown.size(), 1);
+    CHECK_EQ(unknown[0].accountId, 2);
+    CHECK_EQ(interpolator.getPlayerStats(1).realFrames, 2);
+}
+
+int main() {
+    return test::runAll();
+}
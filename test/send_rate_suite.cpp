@@ -0,0 +1,66 @@
+#include <game/send_rate_suite.hpp>
+
+#include <cstdio>
+#include <cstring>
+
+// Prints the results of `SendRateSuite`, the same ones the in-mod benchmarks log.
+// Rates count every datagram that goes out, including the `RequestLevelDataPacket` sent instead of a skipped frame,
+// which keeps the datagram rate at the full tps on a stable connection. Only the bytes go down there.
+// Fails if the controller sends more than sending every frame would, or the error got worse than the limits below.
+
+namespace {
+    // upper bounds for the rms and max error, the congested networks skip every other tick
+    float maxRmsError(const char* network) {
+        return std::strcmp(network, "stable") == 0 ? 1.f : 4.f;
+    }
+
+    float maxError(const char* network) {
+        return std::strcmp(network, "stable") == 0 ? 15.f : 45.f;
+    }
+}
+
+int main() {
+    int failed = 0;
+
+    std::printf(
+        "%-32s %-10s %5s %5s %5s %6s %8s %8s %8s %8s | %8s %8s %8s\n",
+        "", "", "sent", "polls", "skips", "abrupt", "dgram/s", "bytes/s", "rms err", "max err", "dgram/s", "bytes/s", "rms err"
+    );
+
+    for (const auto& result : SendRateSuite::measure(SendRateSuite::syntheticTraces())) {
+        const auto& adaptive = result.adaptive;
+        const auto& always = result.always;
+
+        std::printf(
+            "%-32s %-10s %5zu %5zu %5zu %6zu %8.1f %8.0f %8.2f %8.1f | %8.1f %8.0f %8.2f\n",
+            result.trace.c_str(),
+            result.network,
+            result.stats.sent,
+            result.stats.polled,
+            result.stats.skipped,
+            result.stats.abrupt,
+            adaptive.datagramsPerSecond,
+            adaptive.bytesPerSecond,
+            adaptive.rmsError,
+            adaptive.maxError,
+            always.datagramsPerSecond,
+            always.bytesPerSecond,
+            always.rmsError
+        );
+
+        // catch-up frames go out as their own datagram, so a few more than one per tick are fine
+        bool ok = adaptive.bytes < always.bytes
+            && adaptive.datagramsPerSecond <= always.datagramsPerSecond * 1.05
+            && adaptive.rmsError <= maxRmsError(result.network)
+            && adaptive.maxError <= maxError(result.network);
+
+        if (!ok) {
+            std::printf("  ^ worse than expected\n");
+            failed++;
+        }
+    }
+
+    std::printf("\nthe right side is sending every frame\n");
+
+    return failed == 0 ? 0 : 1;
+}
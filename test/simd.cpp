@@ -0,0 +1,312 @@
+#include <platform/arch/x86/x86simd.hpp>
+#include <util/math.hpp>
+#include <util/pcm.hpp>
+
+#include <cmath>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "check.hpp"
+
+// Every x86 kernel against its scalar reference, on every length from 0 to 17 so that every tail of every vector
+// width gets hit, both on its own and after a run of full vectors. Variants the cpu can't run are skipped.
+// The pcm ones are checked against `util/pcm.hpp`, the lerp against `util::math::lerpArraysSlow`.
+
+using namespace globed::simd::x86;
+
+namespace {
+    enum class Isa { SSE, AVX2, AVX512 };
+
+    const char* isaName(Isa isa) {
+        switch (isa) {
+            case Isa::SSE: return "sse";
+            case Isa::AVX2: return "avx2";
+            default: return "avx512";
+        }
+    }
+
+    bool supported(Isa isa, bool needsDq = false) {
+        const auto& features = asp::simd::getFeatures();
+
+        switch (isa) {
+            case Isa::SSE: return true;
+            case Isa::AVX2: return features.avx2;
+            default: return features.avx512f && (!needsDq || features.avx512dq);
+        }
+    }
+
+    template <typename F>
+    struct Variant {
+        Isa isa;
+        F func;
+    };
+
+    template <typename F>
+    std::vector<Variant<F>> variants(F sse, F avx2, F avx512, bool avx512NeedsDq = false) {
+        std::vector<Variant<F>> out;
+
+        for (auto [isa, func] : {std::pair{Isa::SSE, sse}, std::pair{Isa::AVX2, avx2}, std::pair{Isa::AVX512, avx512}}) {
+            if (supported(isa, isa == Isa::AVX512 && avx512NeedsDq)) {
+                out.push_back({isa, func});
+            } else {
+                std::printf("  skipping %s, not supported by this cpu\n", isaName(isa));
+            }
+        }
+
+        return out;
+    }
+
+    std::vector<size_t> lengths() {
+        std::vector<size_t> out;
+
+        for (size_t tail = 0; tail <= 17; tail++) {
+            out.push_back(tail);
+            out.push_back(64 + tail);
+        }
+
+        return out;
+    }
+
+    // louder than full scale, so clamping and clipping have something to do
+    std::vector<float> randomPcm(size_t samples, uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> dist(-3.f, 3.f);
+
+        std::vector<float> out(samples);
+        for (auto& s : out) {
+            s = dist(rng);
+        }
+
+        return out;
+    }
+
+    // sums are added up in a different order, and the tails of the wider kernels may be fused into fma
+    bool close(float a, float b, float relative = 1e-5f) {
+        return std::abs(a - b) <= relative * std::max(1.f, std::abs(b));
+    }
+
+    bool sameFloats(const std::vector<float>& a, const std::vector<float>& b, float relative) {
+        for (size_t i = 0; i < a.size(); i++) {
+            if (!close(a[i], b[i], relative) || std::signbit(a[i]) != std::signbit(b[i])) return false;
+        }
+
+        return true;
+    }
+
+    void report(bool ok, const char* kernel, Isa isa, size_t samples) {
+        if (!ok) {
+            std::printf("  %s %s differs from the reference with %zu samples\n", kernel, isaName(isa), samples);
+            test::currentFailures()++;
+        }
+    }
+}
+
+TEST_CASE(volume) {
+    for (const auto& v : variants(pcmVolumeSSE, pcmVolumeAVX2, pcmVolumeAVX512, true)) {
+        for (size_t n : lengths()) {
+            if (n == 0) continue; // averages nothing
+
+            auto pcm = randomPcm(n, n);
+            report(close(v.func(pcm.data(), n), util::misc::pcmVolumeSlow(pcm.data(), n)), "volume", v.isa, n);
+        }
+    }
+}
+
+TEST_CASE(sum_squares) {
+    for (const auto& v : variants(pcmSumSquaresSSE, pcmSumSquaresAVX2, pcmSumSquaresAVX512)) {
+        for (size_t n : lengths()) {
+            auto pcm = randomPcm(n, n);
+            report(close(v.func(pcm.data(), n), util::misc::pcmSumSquaresSlow(pcm.data(), n)), "sumSquares", v.isa, n);
+        }
+    }
+}
+
+TEST_CASE(mix) {
+    for (const auto& v : variants(pcmMixSSE, pcmMixAVX2, pcmMixAVX512)) {
+        for (size_t n : lengths()) {
+            auto src = randomPcm(n, n);
+            auto dest = randomPcm(n, n + 1000);
+            auto expected = dest;
+
+            v.func(dest.data(), src.data(), n, 0.7f);
+            util::misc::pcmMixSlow(expected.data(), src.data(), n, 0.7f);
+            report(sameFloats(dest, expected, 1e-6f), "mix", v.isa, n);
+        }
+    }
+}
+
+TEST_CASE(zero_crossings) {
+    // avx512 has no zero crossing kernel, the avx2 one is used instead
+    for (const auto& v : variants(pcmZeroCrossingsSSE, pcmZeroCrossingsAVX2, pcmZeroCrossingsAVX2)) {
+        for (size_t n : lengths()) {
+            auto pcm = randomPcm(n, n);
+
+            // zeroes of both signs
+            for (size_t i = 0; i < n; i += 5) {
+                pcm[i] = (i % 2) ? -0.f : 0.f;
+            }
+
+            report(v.func(pcm.data(), n) == util::misc::pcmZeroCrossingsSlow(pcm.data(), n), "zeroCrossings", v.isa, n);
+        }
+    }
+}
+
+TEST_CASE(gain) {
+    for (const auto& v : variants(pcmGainSSE, pcmGainAVX2, pcmGainAVX512)) {
+        for (size_t n : lengths()) {
+            auto pcm = randomPcm(n, n);
+            auto expected = pcm;
+
+            v.func(pcm.data(), n, 1.3f);
+            util::misc::pcmGainSlow(expected.data(), n, 1.3f);
+            report(pcm == expected, "gain", v.isa, n);
+        }
+    }
+}
+
+TEST_CASE(clamp) {
+    for (const auto& v : variants(pcmClampSSE, pcmClampAVX2, pcmClampAVX512)) {
+        for (size_t n : lengths()) {
+            auto pcm = randomPcm(n, n);
+            auto expected = pcm;
+
+            v.func(pcm.data(), n, 1.f);
+            util::misc::pcmClampSlow(expected.data(), n, 1.f);
+            report(pcm == expected, "clamp", v.isa, n);
+        }
+    }
+}
+
+TEST_CASE(soft_clip) {
+    // the ends of the linear region, both sides of the knee, the input limit and past it
+    const float edges[] = {
+        0.f, -0.f, 1.f, -1.f, 0.8f, -0.8f, 0.79999995f, 0.80000007f, -0.80000007f,
+        64.f, -64.f, 63.99999f, 64.00001f, 1000.f, -1000.f, 3.f, -3.f, 1e-30f,
+    };
+
+    for (const auto& v : variants(pcmSoftClipSSE, pcmSoftClipAVX2, pcmSoftClipAVX512)) {
+        for (size_t n : lengths()) {
+            auto pcm = randomPcm(n, n);
+
+            // spread the edge cases over both the vector part and the tail
+            for (size_t i = 0; i < n; i++) {
+                if (i % 3 == 0) pcm[i] = edges[(i / 3 + n) % std::size(edges)];
+            }
+
+            auto expected = pcm;
+
+            v.func(pcm.data(), n);
+            util::misc::pcmSoftClipSlow(expected.data(), n);
+            report(sameFloats(pcm, expected, 1e-6f), "softClip", v.isa, n);
+
+            for (float s : pcm) {
+                CHECK(std::abs(s) <= 1.f);
+            }
+        }
+
+        // every edge case in every lane
+        for (size_t lane = 0; lane < 16; lane++) {
+            for (float edge : edges) {
+                std::vector<float> pcm(17, 0.5f);
+                pcm[lane] = edge;
+                auto expected = pcm;
+
+                v.func(pcm.data(), pcm.size());
+                util::misc::pcmSoftClipSlow(expected.data(), expected.size());
+                report(sameFloats(pcm, expected, 1e-6f), "softClip", v.isa, pcm.size());
+            }
+        }
+    }
+}
+
+TEST_CASE(peak) {
+    for (const auto& v : variants(pcmPeakSSE, pcmPeakAVX2, pcmPeakAVX512)) {
+        for (size_t n : lengths()) {
+            auto pcm = randomPcm(n, n);
+
+            // the loudest sample in the tail
+            if (n > 0) pcm[n - 1] = -5.f;
+
+            report(v.func(pcm.data(), n) == util::misc::pcmPeakSlow(pcm.data(), n), "peak", v.isa, n);
+        }
+    }
+}
+
+TEST_CASE(to_int16) {
+    const float edges[] = {1.f, -1.f, 0.5f / 32767.f, 1.5f / 32767.f, -0.5f / 32767.f, 2.f, -2.f, 0.99999f};
+
+    for (const auto& v : variants(pcmToInt16SSE, pcmToInt16AVX2, pcmToInt16AVX512)) {
+        for (size_t n : lengths()) {
+            auto pcm = randomPcm(n, n);
+            for (size_t i = 0; i < n; i += 2) {
+                pcm[i] = edges[(i / 2) % std::size(edges)];
+            }
+
+            std::vector<int16_t> out(n), expected(n);
+
+            v.func(pcm.data(), out.data(), n);
+            util::misc::pcmToInt16Slow(pcm.data(), expected.data(), n);
+            report(out == expected, "pcmToInt16", v.isa, n);
+        }
+    }
+}
+
+TEST_CASE(from_int16) {
+    for (const auto& v : variants(pcmFromInt16SSE, pcmFromInt16AVX2, pcmFromInt16AVX512)) {
+        for (size_t n : lengths()) {
+            std::mt19937 rng(n);
+            std::uniform_int_distribution<int> dist(-32768, 32767);
+
+            std::vector<int16_t> in(n);
+            for (size_t i = 0; i < n; i++) {
+                in[i] = i % 4 == 0 ? (i % 8 == 0 ? -32768 : 32767) : static_cast<int16_t>(dist(rng));
+            }
+
+            std::vector<float> out(n), expected(n);
+
+            v.func(in.data(), out.data(), n);
+            util::misc::pcmFromInt16Slow(in.data(), expected.data(), n);
+            report(out == expected, "pcmFromInt16", v.isa, n);
+        }
+    }
+}
+
+TEST_CASE(lerp) {
+    static constexpr float SENTINEL = 12345.f;
+
+    auto check = [](const char* name, Isa isa, auto func) {
+        for (size_t n : lengths()) {
+            auto from = randomPcm(n, n);
+            auto to = randomPcm(n, n + 1000);
+            auto ratio = randomPcm(n, n + 2000);
+
+            // the interpolator extrapolates, so ratios go past 1
+            for (auto& r : ratio) r = std::abs(r) / 2.f;
+
+            // nothing past `n` may be written
+            std::vector<float> out(n + 16, SENTINEL), expected(n + 16, SENTINEL);
+
+            func(from.data(), to.data(), ratio.data(), out.data(), n);
+            util::math::lerpArraysSlow(from.data(), to.data(), ratio.data(), expected.data(), n);
+            report(sameFloats(out, expected, 1e-6f), name, isa, n);
+
+            // in place, like the interpolator does it
+            auto inPlace = from;
+            func(inPlace.data(), to.data(), ratio.data(), inPlace.data(), n);
+            report(sameFloats(inPlace, std::vector<float>(expected.begin(), expected.begin() + n), 1e-6f), name, isa, n);
+        }
+    };
+
+    for (const auto& v : variants(lerpArraysSSE, lerpArraysAVX2, lerpArraysAVX512)) {
+        check("lerpArrays", v.isa, v.func);
+    }
+
+    // and whatever the dispatch picks on this cpu
+    check("lerpArrays (dispatch)", Isa::SSE, util::math::lerpArrays);
+}
+
+int main() {
+    return test::runAll();
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+// None of the GEODE_IS_* platforms on x86, code that picks between x86 and arm treats this as x86.
+// arm hosts pretend to be android, which is the only platform besides arm macs that picks arm.
+#if defined(__aarch64__) || defined(__arm__)
+# define GEODE_IS_ANDROID
+#endif
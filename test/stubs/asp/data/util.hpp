@@ -0,0 +1,39 @@
+#pragma once
+
+// The byte helpers that `util/data.hpp` forwards to.
+
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace asp::data {
+    template <typename T>
+    constexpr bool is_primitive = std::is_arithmetic_v<T>;
+
+    template <typename To, typename From>
+    To bit_cast(From value) noexcept {
+        To out;
+        std::memcpy(&out, &value, sizeof(To));
+        return out;
+    }
+
+    template <typename T>
+    constexpr T byteswap(T val) {
+        if constexpr (sizeof(T) == 1) {
+            return val;
+        } else if constexpr (std::is_floating_point_v<T>) {
+            using U = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+            return std::bit_cast<T>(byteswap(std::bit_cast<U>(val)));
+        } else {
+            using U = std::make_unsigned_t<T>;
+            U in = static_cast<U>(val), out = 0;
+            for (size_t i = 0; i < sizeof(T); i++) {
+                out = static_cast<U>((out << 8) | ((in >> (i * 8)) & 0xff));
+            }
+
+            return static_cast<T>(out);
+        }
+    }
+}
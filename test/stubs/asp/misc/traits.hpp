@@ -0,0 +1,26 @@
+#pragma once
+
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace asp {
+    template <typename T>
+    struct is_std_vector : std::false_type {};
+
+    template <typename T, typename A>
+    struct is_std_vector<std::vector<T, A>> : std::true_type {};
+
+    template <typename T>
+    struct is_std_optional : std::false_type {};
+
+    template <typename T>
+    struct is_std_optional<std::optional<T>> : std::true_type {};
+
+    template <typename T>
+    struct is_std_pair : std::false_type {};
+
+    template <typename T1, typename T2>
+    struct is_std_pair<std::pair<T1, T2>> : std::true_type {};
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+// The cpu feature detection and helpers from asp that the simd kernels use, with the same behavior as the real thing.
+
+#include <immintrin.h>
+
+namespace asp::simd {
+    struct CPUFeatures {
+        bool sse2, avx, avx2, avx512f, avx512dq;
+    };
+
+    inline const CPUFeatures& getFeatures() {
+        static const CPUFeatures features = [] {
+            __builtin_cpu_init();
+
+            return CPUFeatures {
+                .sse2 = static_cast<bool>(__builtin_cpu_supports("sse2")),
+                .avx = static_cast<bool>(__builtin_cpu_supports("avx")),
+                .avx2 = static_cast<bool>(__builtin_cpu_supports("avx2")),
+                .avx512f = static_cast<bool>(__builtin_cpu_supports("avx512f")),
+                .avx512dq = static_cast<bool>(__builtin_cpu_supports("avx512dq")),
+            };
+        }();
+
+        return features;
+    }
+
+    inline float vec128sum(__m128 vec) {
+        __m128 sums = _mm_add_ps(vec, _mm_movehl_ps(vec, vec));
+        sums = _mm_add_ss(sums, _mm_shuffle_ps(sums, sums, 1));
+        return _mm_cvtss_f32(sums);
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+// `asp::Mutex` and the atomics, on top of the standard library like the real ones.
+
+#include <atomic>
+#include <mutex>
+#include <utility>
+
+namespace asp {
+    template <typename T = void>
+    class Mutex {
+    public:
+        class Guard {
+        public:
+            Guard(std::mutex& mtx, T& data) : lock(mtx), data(data) {}
+
+            T* operator->() {
+                return &data;
+            }
+
+            T& operator*() {
+                return data;
+            }
+
+        private:
+            std::unique_lock<std::mutex> lock;
+            T& data;
+        };
+
+        Mutex() : data() {}
+        Mutex(T&& data) : data(std::move(data)) {}
+
+        Guard lock() {
+            return Guard(mtx, data);
+        }
+
+    private:
+        std::mutex mtx;
+        T data;
+    };
+
+    template <>
+    class Mutex<void> {
+    public:
+        std::unique_lock<std::mutex> lock() {
+            return std::unique_lock<std::mutex>(mtx);
+        }
+
+    private:
+        std::mutex mtx;
+    };
+
+    using AtomicBool = std::atomic<bool>;
+    using AtomicU32 = std::atomic<uint32_t>;
+    using AtomicU64 = std::atomic<uint64_t>;
+    using AtomicF32 = std::atomic<float>;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+// The parts of cocos2d that the game independent code of the mod uses, with the same behavior as the real thing.
+
+#include <cmath>
+#include <cstdint>
+
+namespace cocos2d {
+    class CCPoint {
+    public:
+        float x, y;
+
+        CCPoint() : x(0.f), y(0.f) {}
+        CCPoint(float x, float y) : x(x), y(y) {}
+
+        CCPoint operator+(const CCPoint& other) const {
+            return CCPoint(x + other.x, y + other.y);
+        }
+
+        CCPoint operator-(const CCPoint& other) const {
+            return CCPoint(x - other.x, y - other.y);
+        }
+
+        CCPoint operator-() const {
+            return CCPoint(-x, -y);
+        }
+
+        CCPoint operator*(float a) const {
+            return CCPoint(x * a, y * a);
+        }
+
+        CCPoint operator/(float a) const {
+            return CCPoint(x / a, y / a);
+        }
+
+        bool operator==(const CCPoint& other) const {
+            return x == other.x && y == other.y;
+        }
+
+        float getLength() const {
+            return std::sqrt(x * x + y * y);
+        }
+
+        float getDistance(const CCPoint& other) const {
+            return (*this - other).getLength();
+        }
+    };
+
+    class CCSize {
+    public:
+        float width, height;
+
+        CCSize() : width(0.f), height(0.f) {}
+        CCSize(float width, float height) : width(width), height(height) {}
+    };
+
+    class CCRect {
+    public:
+        CCPoint origin;
+        CCSize size;
+
+        CCRect() {}
+        CCRect(float x, float y, float width, float height) : origin(x, y), size(width, height) {}
+
+        float getMinX() const { return origin.x; }
+        float getMaxX() const { return origin.x + size.width; }
+        float getMinY() const { return origin.y; }
+        float getMaxY() const { return origin.y + size.height; }
+
+        // edges that only touch count as intersecting
+        bool intersectsRect(const CCRect& rect) const {
+            return !(getMaxX() < rect.getMinX() || rect.getMaxX() < getMinX() || getMaxY() < rect.getMinY() || rect.getMaxY() < getMinY());
+        }
+    };
+
+    struct ccColor3B {
+        uint8_t r, g, b;
+    };
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+// Reflection based serialization is not tested here, the macros only have to accept the same arguments as the real ones.
+// `ByteBuffer` only handles primitives, optionals and types with a `customEncode`/`customDecode`, which is enough
+// for the voice frames. It writes the same bytes as the real one.
+
+#include <cocos2d.h>
+#include <defs/assert.hpp>
+#include <defs/geode.hpp>
+#include <asp/misc/traits.hpp>
+#include <util/data.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+
+#define GLOBED_SERIALIZABLE_STRUCT(type, fields) static_assert(true)
+#define GLOBED_SERIALIZABLE_ENUM(type, ...) static_assert(true)
+
+class ByteBuffer {
+public:
+    enum class DecodeError {
+        Ok,
+        NotEnoughData,
+        InvalidEnumValue,
+        DataTooLong,
+        LengthPrefixTooLong
+    };
+
+    template <typename T = std::monostate>
+    using DecodeResult = geode::Result<T, DecodeError>;
+
+    static const char* strerror(DecodeError err) {
+        switch (err) {
+            case DecodeError::Ok: return "No error";
+            case DecodeError::NotEnoughData: return "Could not read enough bytes from the buffer";
+            case DecodeError::InvalidEnumValue: return "Invalid enum value was read";
+            case DecodeError::DataTooLong: return "Object was too long";
+            case DecodeError::LengthPrefixTooLong: return "Length prefix was too long";
+        }
+
+        return "Unknown error";
+    }
+
+    ByteBuffer() {}
+    ByteBuffer(util::data::bytevector&& data) : _data(std::move(data)) {}
+
+    template <typename T>
+    DecodeResult<T> readValue() {
+        if constexpr (util::data::IsPrimitive<T>) {
+            return this->readPrimitive<T>();
+        } else if constexpr (asp::is_std_optional<T>::value) {
+            GLOBED_UNWRAP_INTO(this->readBool(), bool present);
+            if (!present) return Ok(T{});
+
+            GLOBED_UNWRAP_INTO(this->readValue<typename T::value_type>(), auto value);
+            return Ok(T{std::move(value)});
+        } else {
+            return this->customDecode<T>();
+        }
+    }
+
+    template <typename T>
+    void writeValue(const T& value) {
+        if constexpr (util::data::IsPrimitive<T>) {
+            this->writePrimitive<T>(value);
+        } else if constexpr (asp::is_std_optional<T>::value) {
+            this->writeBool(value.has_value());
+            if (value) this->writeValue(*value);
+        } else {
+            this->customEncode(value);
+        }
+    }
+
+    template <typename T>
+    DecodeResult<T> customDecode();
+
+    template <typename T>
+    void customEncode(const T& value);
+
+    void clear() {
+        _data.clear();
+        _position = 0;
+    }
+
+    const util::data::bytevector& data() const { return _data; }
+    util::data::bytevector& data() { return _data; }
+    size_t size() const { return _data.size(); }
+    size_t getPosition() const { return _position; }
+    void setPosition(size_t pos) { _position = pos; }
+
+    DecodeResult<> boundsCheck(size_t count) {
+        if (_position + count > _data.size()) {
+            return Err(DecodeError::NotEnoughData);
+        }
+
+        return Ok();
+    }
+
+    DecodeResult<bool> readBool() {
+        GLOBED_UNWRAP_INTO(this->readPrimitive<uint8_t>(), auto value);
+        return Ok(value != 0);
+    }
+
+    DecodeResult<uint32_t> readU32() { return this->readPrimitive<uint32_t>(); }
+
+    void writeBool(bool value) { this->writePrimitive<uint8_t>(value ? 1 : 0); }
+    void writeU32(uint32_t value) { this->writePrimitive(value); }
+
+    DecodeResult<> readBytesInto(util::data::byte* buf, size_t bytes) {
+        GLOBED_UNWRAP(this->boundsCheck(bytes));
+
+        std::memcpy(buf, _data.data() + _position, bytes);
+        _position += bytes;
+
+        return Ok();
+    }
+
+protected:
+    util::data::bytevector _data;
+    size_t _position = 0;
+
+    void rawWriteBytes(const util::data::byte* bytes, size_t length) {
+        if (_position + length > _data.size()) {
+            _data.resize(_position + length);
+        }
+
+        std::memcpy(_data.data() + _position, bytes, length);
+        _position += length;
+    }
+
+    template <typename T>
+    DecodeResult<T> readPrimitive() {
+        GLOBED_UNWRAP(this->boundsCheck(sizeof(T)));
+
+        T value;
+        std::memcpy(&value, _data.data() + _position, sizeof(T));
+        _position += sizeof(T);
+
+        return Ok(util::data::maybeByteswap(value));
+    }
+
+    template <typename T>
+    void writePrimitive(T value) {
+        value = util::data::maybeByteswap(value);
+        this->rawWriteBytes(reinterpret_cast<const util::data::byte*>(&value), sizeof(T));
+    }
+};
@@ -0,0 +1,44 @@
+#pragma once
+#include <config.hpp>
+
+#include <source_location>
+#include <stdexcept>
+#include <string>
+
+// The macros from the real header that the game independent code uses, with the same behavior.
+
+#define GEODE_CONCAT_(a, b) a##b
+#define GEODE_CONCAT(a, b) GEODE_CONCAT_(a, b)
+
+#define GLOBED_REQUIRE(condition,message) \
+    if (!(condition)) [[unlikely]] { \
+        auto ev_msg = (message); \
+        auto loc = std::source_location::current(); \
+        geode::log::warn("Condition failed at {}:{}: {}", loc.file_name(), loc.line(), ev_msg); \
+        throw(std::runtime_error(std::string(ev_msg))); \
+    }
+
+#define GLOBED_REQUIRE_SAFE(condition, message) \
+    if (!(condition)) [[unlikely]] { \
+        auto ev_msg = (message); \
+        auto loc = std::source_location::current(); \
+        geode::log::warn("Condition failed at {}:{}: {}", loc.file_name(), loc.line(), ev_msg); \
+        return geode::Err(std::string(ev_msg)); \
+    }
+
+#define GLOBED_UNWRAP(value) \
+    do { \
+        auto __resv = (value); \
+        if (__resv.isErr()) return geode::Err(std::move(__resv.unwrapErr())); \
+    } while (0); \
+
+#define GLOBED_UNWRAP_INTO(value, dest) \
+    auto GEODE_CONCAT(_uval_, __LINE__) = std::move((value)); \
+    if (GEODE_CONCAT(_uval_, __LINE__).isErr()) return geode::Err(std::move(GEODE_CONCAT(_uval_, __LINE__).unwrapErr())); \
+    dest = std::move(GEODE_CONCAT(_uval_, __LINE__).unwrap());
+
+namespace globed {
+    [[noreturn]] static inline void unreachable() {
+        __builtin_unreachable();
+    }
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+// Just enough of geode for the game independent code of the mod: `Result`, logging to stderr and the prelude namespace.
+
+#include <cocos2d.h>
+#include <config.hpp>
+#include <defs/platform.hpp>
+
+#include <fmt/format.h>
+#include <fmt/std.h>
+
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <variant>
+
+namespace geode {
+    template <typename T>
+    struct OkValue {
+        T value;
+    };
+
+    template <typename E>
+    struct ErrValue {
+        E value;
+    };
+
+    // `Result<>` holds a monostate instead of nothing
+    inline OkValue<std::monostate> Ok() {
+        return {};
+    }
+
+    template <typename T>
+    OkValue<std::decay_t<T>> Ok(T&& value) {
+        return {std::forward<T>(value)};
+    }
+
+    template <typename E>
+    ErrValue<std::decay_t<E>> Err(E&& value) {
+        return {std::forward<E>(value)};
+    }
+
+    template <typename... Args>
+        requires (sizeof...(Args) > 0)
+    ErrValue<std::string> Err(fmt::format_string<Args...> format, Args&&... args) {
+        return {fmt::format(format, std::forward<Args>(args)...)};
+    }
+
+    template <typename T = std::monostate, typename E = std::string>
+    class Result {
+    public:
+        template <typename U>
+        Result(OkValue<U>&& ok) : value(std::in_place_index<0>, std::move(ok.value)) {}
+
+        template <typename U>
+        Result(ErrValue<U>&& err) : value(std::in_place_index<1>, std::move(err.value)) {}
+
+        bool isOk() const {
+            return value.index() == 0;
+        }
+
+        bool isErr() const {
+            return value.index() == 1;
+        }
+
+        explicit operator bool() const {
+            return this->isOk();
+        }
+
+        T& unwrap() & {
+            return std::get<0>(value);
+        }
+
+        T&& unwrap() && {
+            return std::get<0>(std::move(value));
+        }
+
+        E& unwrapErr() & {
+            return std::get<1>(value);
+        }
+
+        E&& unwrapErr() && {
+            return std::get<1>(std::move(value));
+        }
+
+    private:
+        std::variant<T, E> value;
+    };
+
+    namespace log {
+        template <typename... Args>
+        void debug(fmt::format_string<Args...> format, Args&&... args) {
+            fmt::print(stderr, "[debug] {}\n", fmt::format(format, std::forward<Args>(args)...));
+        }
+
+        template <typename... Args>
+        void info(fmt::format_string<Args...> format, Args&&... args) {
+            fmt::print(stderr, "[info] {}\n", fmt::format(format, std::forward<Args>(args)...));
+        }
+
+        template <typename... Args>
+        void warn(fmt::format_string<Args...> format, Args&&... args) {
+            fmt::print(stderr, "[warn] {}\n", fmt::format(format, std::forward<Args>(args)...));
+        }
+
+        template <typename... Args>
+        void error(fmt::format_string<Args...> format, Args&&... args) {
+            fmt::print(stderr, "[error] {}\n", fmt::format(format, std::forward<Args>(args)...));
+        }
+    }
+
+    namespace prelude {
+        using namespace ::geode;
+        using namespace ::cocos2d;
+    }
+}
+
+using geode::Result;
+using geode::Ok;
+using geode::Err;
+
+// same workaround as in minimal_geode.hpp, `log` would clash with the one from <cmath>
+namespace __zglobed_log_namespace_shut_up_msvc {
+    namespace log = geode::log;
+}
+
+using namespace __zglobed_log_namespace_shut_up_msvc;
@@ -0,0 +1,27 @@
+#pragma once
+#include <config.hpp>
+
+#include <Geode/platform/cplatform.h>
+
+#include <stdint.h>
+
+// The tests run on a desktop host, which the real header doesn't know about. Voice is always supported here,
+// its backend is `FileAudioBackend` instead of FMOD.
+
+#ifndef _WIN32
+# define GLOBED_IS_UNIX 1
+#endif
+
+#if UINTPTR_MAX > 0xffffffff
+# define GLOBED_IS_64BIT
+#endif
+
+#define GLOBED_HAS_FMOD 0
+#define GLOBED_HAS_DRPC 0
+#define GLOBED_HAS_KEYBINDS 0
+
+#ifndef GLOBED_DISABLE_VOICE_SUPPORT
+# define GLOBED_VOICE_SUPPORT
+#endif
+
+constexpr bool GLOBED_LITTLE_ENDIAN = true;
@@ -0,0 +1,63 @@
+#include <util/simd.hpp>
+#include <platform/basic.hpp>
+
+#ifdef GLOBED_X86
+# include <platform/arch/x86/x86simd.hpp>
+#else
+# include <util/math.hpp>
+# include <util/pcm.hpp>
+#endif
+
+// the same dispatch as in the platform code, for the simd functions that the game independent code uses.
+// hosts that aren't x86 use the scalar versions
+#ifdef GLOBED_X86
+# define GLOBED_SIMD_DISPATCH(fast, slow) globed::simd::x86::fast
+#else
+# define GLOBED_SIMD_DISPATCH(fast, slow) slow
+#endif
+
+namespace util::simd {
+    float calcPcmVolume(const float* pcm, size_t samples) {
+        return GLOBED_SIMD_DISPATCH(pcmVolume, util::misc::pcmVolumeSlow)(pcm, samples);
+    }
+
+    float calcPcmSumSquares(const float* pcm, size_t samples) {
+        return GLOBED_SIMD_DISPATCH(pcmSumSquares, util::misc::pcmSumSquaresSlow)(pcm, samples);
+    }
+
+    void mixPcm(float* dest, const float* src, size_t samples, float gain) {
+        GLOBED_SIMD_DISPATCH(pcmMix, util::misc::pcmMixSlow)(dest, src, samples, gain);
+    }
+
+    size_t countPcmZeroCrossings(const float* pcm, size_t samples) {
+        return GLOBED_SIMD_DISPATCH(pcmZeroCrossings, util::misc::pcmZeroCrossingsSlow)(pcm, samples);
+    }
+
+    void applyPcmGain(float* pcm, size_t samples, float gain) {
+        GLOBED_SIMD_DISPATCH(pcmGain, util::misc::pcmGainSlow)(pcm, samples, gain);
+    }
+
+    void clampPcm(float* pcm, size_t samples, float limit) {
+        GLOBED_SIMD_DISPATCH(pcmClamp, util::misc::pcmClampSlow)(pcm, samples, limit);
+    }
+
+    void softClipPcm(float* pcm, size_t samples) {
+        GLOBED_SIMD_DISPATCH(pcmSoftClip, util::misc::pcmSoftClipSlow)(pcm, samples);
+    }
+
+    float calcPcmPeak(const float* pcm, size_t samples) {
+        return GLOBED_SIMD_DISPATCH(pcmPeak, util::misc::pcmPeakSlow)(pcm, samples);
+    }
+
+    void pcmToInt16(const float* pcm, int16_t* out, size_t samples) {
+        GLOBED_SIMD_DISPATCH(pcmToInt16, util::misc::pcmToInt16Slow)(pcm, out, samples);
+    }
+
+    void pcmFromInt16(const int16_t* in, float* pcm, size_t samples) {
+        GLOBED_SIMD_DISPATCH(pcmFromInt16, util::misc::pcmFromInt16Slow)(in, pcm, samples);
+    }
+
+    void lerpArrays(const float* from, const float* to, const float* ratio, float* out, size_t count) {
+        GLOBED_SIMD_DISPATCH(lerpArrays, util::math::lerpArraysSlow)(from, to, ratio, out, count);
+    }
+}
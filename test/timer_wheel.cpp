@@ -0,0 +1,348 @@
+#include <util/timer_wheel.hpp>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <utility>
+
+#include "check.hpp"
+
+using util::time::TimerWheel;
+
+namespace {
+    // (tick, value) pairs in the order the wheel fired them
+    using Fired = std::vector<std::pair<uint64_t, int>>;
+
+    size_t advanceInto(TimerWheel<int>& wheel, uint64_t tick, Fired& out) {
+        return wheel.advance(tick, [&](int value) {
+            out.emplace_back(wheel.now(), value);
+        });
+    }
+
+    constexpr uint64_t SPAN = uint64_t(1) << 24;
+}
+
+TEST_CASE(fires_at_deadline) {
+    TimerWheel<int> wheel;
+    Fired fired;
+
+    wheel.schedule(5, 1);
+    CHECK_EQ(wheel.size(), 1);
+
+    CHECK_EQ(advanceInto(wheel, 4, fired), 0);
+    CHECK(fired.empty());
+    CHECK_EQ(wheel.now(), 5);
+
+    CHECK_EQ(advanceInto(wheel, 5, fired), 1);
+    CHECK_EQ(fired.size(), 1);
+    CHECK_EQ(fired[0].first, 5);
+    CHECK_EQ(fired[0].second, 1);
+    CHECK_EQ(wheel.size(), 0);
+
+    // nothing left, advancing further is a no-op
+    CHECK_EQ(advanceInto(wheel, 1000, fired), 0);
+    CHECK_EQ(wheel.now(), 1001);
+}
+
+TEST_CASE(fires_in_deadline_order) {
+    TimerWheel<int> wheel;
+    Fired fired;
+
+    wheel.schedule(30, 3);
+    wheel.schedule(10, 1);
+    wheel.schedule(20, 2);
+    wheel.schedule(10, 4);
+
+    CHECK_EQ(advanceInto(wheel, 100, fired), 4);
+    CHECK_EQ(fired.size(), 4);
+    CHECK_EQ(fired[0].first, 10);
+    CHECK_EQ(fired[1].first, 10);
+    CHECK_EQ(fired[2].first, 20);
+    CHECK_EQ(fired[2].second, 2);
+    CHECK_EQ(fired[3].first, 30);
+    CHECK_EQ(fired[3].second, 3);
+}
+
+TEST_CASE(past_deadline_fires_on_next_advance) {
+    TimerWheel<int> wheel(1000);
+    Fired fired;
+
+    wheel.schedule(0, 1);
+    wheel.schedule(999, 2);
+    wheel.schedule(1000, 3);
+
+    CHECK_EQ(advanceInto(wheel, 1000, fired), 3);
+    for (auto& [tick, _] : fired) {
+        CHECK_EQ(tick, 1000);
+    }
+
+    // and the same once the wheel has been running for a while
+    advanceInto(wheel, 5000, fired);
+    fired.clear();
+
+    wheel.schedule(10, 4);
+    CHECK_EQ(advanceInto(wheel, 5001, fired), 1);
+    CHECK_EQ(fired.size(), 1);
+    CHECK_EQ(fired[0].first, 5001);
+}
+
+TEST_CASE(cancel) {
+    TimerWheel<int> wheel;
+    Fired fired;
+
+    auto a = wheel.schedule(10, 1);
+    auto b = wheel.schedule(10, 2);
+    auto c = wheel.schedule(5000, 3);
+
+    CHECK(wheel.cancel(a));
+    CHECK(!wheel.cancel(a));
+    CHECK(wheel.cancel(c));
+    CHECK_EQ(wheel.size(), 1);
+
+    CHECK_EQ(advanceInto(wheel, 10000, fired), 1);
+    CHECK_EQ(fired.size(), 1);
+    CHECK_EQ(fired[0].second, 2);
+
+    // already expired
+    CHECK(!wheel.cancel(b));
+    CHECK(!wheel.cancel(TimerWheel<int>::INVALID_ID));
+}
+
+TEST_CASE(stale_id_does_not_match_reused_node) {
+    TimerWheel<int> wheel;
+    Fired fired;
+
+    auto a = wheel.schedule(10, 1);
+    CHECK(wheel.cancel(a));
+
+    // reuses the node that `a` pointed to
+    auto b = wheel.schedule(20, 2);
+    CHECK(a != b);
+    CHECK(!wheel.cancel(a));
+    CHECK(!wheel.reschedule(a, 5));
+
+    CHECK_EQ(advanceInto(wheel, 20, fired), 1);
+    CHECK_EQ(fired[0].first, 20);
+    CHECK_EQ(fired[0].second, 2);
+}
+
+TEST_CASE(reschedule) {
+    TimerWheel<int> wheel;
+    Fired fired;
+
+    auto later = wheel.schedule(10, 1);
+    auto sooner = wheel.schedule(5000, 2);
+
+    CHECK(wheel.reschedule(later, 300));
+    CHECK(wheel.reschedule(sooner, 7));
+    CHECK_EQ(wheel.size(), 2);
+
+    CHECK_EQ(advanceInto(wheel, 1000, fired), 2);
+    CHECK_EQ(fired[0].first, 7);
+    CHECK_EQ(fired[0].second, 2);
+    CHECK_EQ(fired[1].first, 300);
+    CHECK_EQ(fired[1].second, 1);
+
+    CHECK(!wheel.reschedule(later, 2000));
+
+    // rescheduling into the past fires on the next advance
+    auto past = wheel.schedule(1500, 3);
+    CHECK(wheel.reschedule(past, 3));
+    fired.clear();
+    CHECK_EQ(advanceInto(wheel, 1001, fired), 1);
+    CHECK_EQ(fired[0].first, 1001);
+}
+
+TEST_CASE(cascades_across_levels) {
+    TimerWheel<int> wheel;
+    Fired fired;
+
+    // deadlines on both sides of every level boundary
+    std::vector<uint64_t> deadlines = {
+        63, 64, 65, 127, 128,
+        4095, 4096, 4097, 4160,
+        262143, 262144, 262145, 262144 + 4096 + 64 + 1,
+        SPAN - 1,
+    };
+
+    for (size_t i = 0; i < deadlines.size(); i++) {
+        wheel.schedule(deadlines[i], static_cast<int>(i));
+    }
+
+    // a single large jump, then small steps, must both hit the exact ticks
+    CHECK_EQ(advanceInto(wheel, 262144, fired), 11);
+    for (uint64_t tick = 262145; tick < SPAN; tick += 777) {
+        advanceInto(wheel, tick, fired);
+    }
+    advanceInto(wheel, SPAN, fired);
+
+    CHECK_EQ(fired.size(), deadlines.size());
+    for (size_t i = 0; i < fired.size() && i < deadlines.size(); i++) {
+        CHECK_EQ(fired[i].first, deadlines[i]);
+        CHECK_EQ(fired[i].second, static_cast<int>(i));
+    }
+}
+
+TEST_CASE(cascades_from_nonzero_start) {
+    // same as above, but the wheel starts in the middle of every level, so the slots don't line up with the deadlines
+    uint64_t start = 262144 * 3 + 4096 * 17 + 64 * 33 + 45;
+    TimerWheel<int> wheel(start);
+    Fired fired;
+
+    std::vector<uint64_t> offsets = {0, 1, 18, 19, 20, 63, 64, 83, 84, 4051, 4052, 4096, 200000, 300000};
+    for (size_t i = 0; i < offsets.size(); i++) {
+        wheel.schedule(start + offsets[i], static_cast<int>(i));
+    }
+
+    for (uint64_t tick = start; tick <= start + 300000; tick += 13) {
+        advanceInto(wheel, tick, fired);
+    }
+    advanceInto(wheel, start + 300000, fired);
+
+    CHECK_EQ(fired.size(), offsets.size());
+    for (size_t i = 0; i < fired.size() && i < offsets.size(); i++) {
+        CHECK_EQ(fired[i].first, start + offsets[i]);
+    }
+}
+
+TEST_CASE(far_future) {
+    TimerWheel<int> wheel;
+    Fired fired;
+
+    // further away than the wheel spans, these get parked in the top level and moved down as they come closer
+    wheel.schedule(SPAN, 1);
+    wheel.schedule(SPAN * 3 + 17, 2);
+    wheel.schedule(UINT32_MAX + uint64_t(5), 3);
+
+    CHECK_EQ(advanceInto(wheel, SPAN - 1, fired), 0);
+    CHECK_EQ(wheel.size(), 3);
+
+    CHECK_EQ(advanceInto(wheel, SPAN * 3 + 16, fired), 1);
+    CHECK_EQ(advanceInto(wheel, SPAN * 3 + 17, fired), 1);
+    CHECK_EQ(advanceInto(wheel, UINT32_MAX + uint64_t(5), fired), 1);
+
+    CHECK_EQ(fired.size(), 3);
+    CHECK_EQ(fired[0].first, SPAN);
+    CHECK_EQ(fired[1].first, SPAN * 3 + 17);
+    CHECK_EQ(fired[2].first, UINT32_MAX + uint64_t(5));
+    CHECK_EQ(wheel.size(), 0);
+}
+
+TEST_CASE(callback_can_schedule_and_cancel) {
+    TimerWheel<int> wheel;
+    Fired fired;
+
+    auto victim = wheel.schedule(20, 99);
+    wheel.schedule(10, 1);
+
+    wheel.advance(100, [&](int value) {
+        fired.emplace_back(wheel.now(), value);
+
+        if (value == 1) {
+            CHECK(wheel.cancel(victim));
+            // due right now and in the next tick, both within this advance
+            wheel.schedule(wheel.now(), 2);
+            wheel.schedule(wheel.now() + 1, 3);
+            // far enough to cascade
+            wheel.schedule(wheel.now() + 70, 4);
+        }
+    });
+
+    CHECK_EQ(fired.size(), 4);
+    CHECK_EQ(fired[0].first, 10);
+    CHECK_EQ(fired[1].first, 10);
+    CHECK_EQ(fired[1].second, 2);
+    CHECK_EQ(fired[2].first, 11);
+    CHECK_EQ(fired[3].first, 80);
+    CHECK_EQ(wheel.size(), 0);
+}
+
+TEST_CASE(clear) {
+    TimerWheel<int> wheel;
+    Fired fired;
+
+    auto id = wheel.schedule(10, 1);
+    wheel.schedule(100000, 2);
+    wheel.clear();
+
+    CHECK_EQ(wheel.size(), 0);
+    CHECK(!wheel.cancel(id));
+    CHECK_EQ(advanceInto(wheel, 200000, fired), 0);
+
+    wheel.schedule(200010, 3);
+    CHECK_EQ(advanceInto(wheel, 200010, fired), 1);
+}
+
+// random operations, checked against a map of pending timers
+TEST_CASE(matches_reference) {
+    std::mt19937_64 rng(1234);
+
+    for (int round = 0; round < 20; round++) {
+        uint64_t start = rng() % (SPAN * 4);
+        TimerWheel<int> wheel(start);
+
+        // id -> (tick it should fire at, value)
+        std::map<TimerWheel<int>::Id, std::pair<uint64_t, int>> pending;
+        int nextValue = 0;
+        uint64_t tick = start;
+
+        auto randomDelay = [&]() -> uint64_t {
+            switch (rng() % 6) {
+                case 0: return rng() % 4;
+                case 1: return rng() % 64;
+                case 2: return rng() % 4096;
+                case 3: return rng() % 262144;
+                case 4: return rng() % SPAN;
+                default: return rng() % (SPAN * 3);
+            }
+        };
+
+        for (int op = 0; op < 3000; op++) {
+            uint32_t kind = rng() % 10;
+
+            if (kind < 5) {
+                // sometimes in the past
+                uint64_t deadline = (rng() % 8 == 0) ? tick - std::min<uint64_t>(tick, rng() % 100) : tick + randomDelay();
+                int value = nextValue++;
+                auto id = wheel.schedule(deadline, value);
+                pending[id] = {std::max(deadline, wheel.now()), value};
+            } else if (kind == 5 && !pending.empty()) {
+                auto it = std::next(pending.begin(), rng() % pending.size());
+                CHECK(wheel.cancel(it->first));
+                pending.erase(it);
+            } else if (kind == 6 && !pending.empty()) {
+                auto it = std::next(pending.begin(), rng() % pending.size());
+                uint64_t deadline = tick + randomDelay();
+                CHECK(wheel.reschedule(it->first, deadline));
+                it->second.first = std::max(deadline, wheel.now());
+            } else {
+                tick += randomDelay() / (rng() % 4 == 0 ? 1 : 64);
+
+                Fired fired;
+                advanceInto(wheel, tick, fired);
+
+                Fired expected;
+                for (auto it = pending.begin(); it != pending.end();) {
+                    if (it->second.first <= tick) {
+                        expected.push_back(it->second);
+                        it = pending.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+
+                // timers due on the same tick fire in no particular order
+                std::sort(expected.begin(), expected.end());
+                CHECK(std::is_sorted(fired.begin(), fired.end(), [](auto& a, auto& b) { return a.first < b.first; }));
+                std::sort(fired.begin(), fired.end());
+                CHECK(fired == expected);
+            }
+
+            CHECK_EQ(wheel.size(), pending.size());
+        }
+    }
+}
+
+int main() {
+    return test::runAll();
+}
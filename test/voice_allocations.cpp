@@ -0,0 +1,257 @@
+#include <audio/constants.hpp>
+#include <audio/encoder.hpp>
+#include <audio/frame.hpp>
+#include <audio/stream.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+// Heap allocations per second of active voice, through the old allocating codec API and the current one.
+// Every allocation of the process is counted while a path runs: malloc itself is replaced where that is possible
+// (glibc without sanitizers), which also catches opus and the standard library. Otherwise only `operator new` is counted.
+// Reading the received packet is counted separately, in the game every packet is decoded into a new object like that.
+// Fails if encoding, framing, decoding or queueing allocate at all once warmed up, or the current path allocates more than the old one.
+
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+# define GLOBED_SANITIZED
+#elif defined(__has_feature)
+# if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer) || __has_feature(memory_sanitizer)
+#  define GLOBED_SANITIZED
+# endif
+#endif
+
+#if defined(__GLIBC__) && !defined(GLOBED_SANITIZED)
+# define GLOBED_HOOK_MALLOC
+#endif
+
+namespace {
+    enum class Phase {
+        Idle,
+        Pipeline,
+        Receive,
+    };
+
+    // the test is single threaded, so there is no need for atomics
+    Phase phase = Phase::Idle;
+    size_t pipelineAllocations = 0;
+    size_t receiveAllocations = 0;
+
+    void record() {
+        if (phase == Phase::Pipeline) pipelineAllocations++;
+        else if (phase == Phase::Receive) receiveAllocations++;
+    }
+
+    // counts everything in `func` as reading the packet
+    template <typename F>
+    auto receive(F&& func) {
+        Phase prev = phase;
+        if (prev != Phase::Idle) phase = Phase::Receive;
+
+        auto result = func();
+        phase = prev;
+
+        return result;
+    }
+}
+
+#ifdef GLOBED_HOOK_MALLOC
+
+extern "C" {
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* ptr, size_t size);
+
+    void* malloc(size_t size) {
+        record();
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size) {
+        record();
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* ptr, size_t size) {
+        record();
+        return __libc_realloc(ptr, size);
+    }
+}
+
+#else
+
+void* operator new(size_t size) {
+    record();
+
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+// sanitizers replace the array versions too, so they have to be replaced here as well
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+#endif
+
+namespace {
+    constexpr size_t SECONDS = 5;
+
+    struct Mode {
+        const char* name;
+        size_t frameSize;
+        size_t framesPerPacket;
+    };
+
+    constexpr Mode modes[] = {
+        {"regular", VOICE_TARGET_FRAMESIZE, EncodedAudioFrame::LIMIT_REGULAR},
+        {"lower audio latency", VOICE_TARGET_FRAMESIZE, EncodedAudioFrame::LIMIT_LOW_LATENCY},
+        {"low latency voice", VOICE_STREAMING_FRAMESIZE, 1},
+    };
+}
+
+int main() {
+    std::vector<float> source(VOICE_TARGET_SAMPLERATE * SECONDS);
+    for (size_t i = 0; i < source.size(); i++) {
+        source[i] = 0.25f * std::sin(static_cast<float>(i) * 0.05f);
+    }
+
+    std::vector<float> out(VOICE_TARGET_FRAMESIZE);
+
+    int failed = 0;
+
+    std::printf("hooked: %s\n\n",
+#ifdef GLOBED_HOOK_MALLOC
+        "malloc, calloc, realloc"
+#else
+        "operator new"
+#endif
+    );
+
+    std::printf("%-22s %12s %12s | %12s %12s\n", "", "before /s", "after /s", "before recv", "after recv");
+
+    for (const auto& mode : modes) {
+        AudioEncoder encoder(VOICE_TARGET_SAMPLERATE, mode.frameSize, VOICE_CHANNELS);
+        AudioDecoder decoder(VOICE_TARGET_SAMPLERATE, VOICE_TARGET_FRAMESIZE, VOICE_CHANNELS);
+        AudioStream stream(AudioDecoder(VOICE_TARGET_SAMPLERATE, VOICE_TARGET_FRAMESIZE, VOICE_CHANNELS), nullptr);
+        EncodedAudioFrame frame(mode.framesPerPacket);
+        ByteBuffer network;
+
+        // the way audio went through the pipeline before, every opus frame is allocated when encoded,
+        // when received, and once more when decoded
+        std::vector<EncodedOpusData> pending;
+        auto legacy = [&](const float* pcm) {
+            pending.push_back(encoder.encode(pcm).unwrap());
+            if (pending.size() < mode.framesPerPacket) return;
+
+            network.clear();
+            for (auto& opusFrame : pending) {
+                network.writeValue(opusFrame);
+                AudioEncoder::freeData(opusFrame);
+            }
+            pending.clear();
+
+            network.setPosition(0);
+            for (size_t i = 0; i < mode.framesPerPacket; i++) {
+                auto received = receive([&] { return network.readValue<EncodedOpusData>().unwrap(); });
+                auto decoded = decoder.decode(received).unwrap();
+                stream.writeData(decoded.ptr, decoded.length);
+
+                AudioDecoder::freeData(decoded);
+                AudioEncoder::freeData(received);
+            }
+        };
+
+        // the way audio goes through the pipeline now, see `GlobedAudioManager::audioThreadWork` and `AudioStream`
+        uint32_t sequence = 0;
+        auto current = [&](const float* pcm) {
+            auto space = frame.reserveOpusFrame().unwrap();
+            frame.commitOpusFrame(encoder.encode(pcm, space).unwrap());
+            if (frame.size() < frame.capacity()) return;
+
+            network.clear();
+            if (mode.framesPerPacket == 1) {
+                network.writeValue(frame.getFrames()[0]);
+                frame.clear();
+
+                network.setPosition(0);
+                auto received = receive([&] { return network.readValue<EncodedOpusData>().unwrap(); });
+                (void) stream.writeSequencedData(sequence++, received);
+                AudioEncoder::freeData(received);
+            } else {
+                network.writeValue(frame);
+                frame.clear();
+
+                network.setPosition(0);
+                auto received = receive([&] { return network.readValue<EncodedAudioFrame>().unwrap(); });
+                (void) stream.writeData(received);
+            }
+        };
+
+        auto measure = [&](auto&& path) {
+            auto run = [&] {
+                for (size_t pos = 0; pos + mode.frameSize <= source.size(); pos += mode.frameSize) {
+                    path(source.data() + pos);
+
+                    // keep the playback queue from filling up, like the output would
+                    while (stream.readSamples(out.data(), out.size()) == out.size()) {}
+                }
+            };
+
+            // first run to let all the reusable buffers grow to their final size
+            run();
+
+            pipelineAllocations = 0;
+            receiveAllocations = 0;
+
+            phase = Phase::Pipeline;
+            run();
+            phase = Phase::Idle;
+
+            return std::make_pair(
+                static_cast<double>(pipelineAllocations) / SECONDS,
+                static_cast<double>(receiveAllocations) / SECONDS
+            );
+        };
+
+        auto [before, beforeReceive] = measure(legacy);
+
+        // the source doesn't end on a packet boundary
+        for (auto& opusFrame : pending) {
+            AudioEncoder::freeData(opusFrame);
+        }
+        pending.clear();
+
+        auto [after, afterReceive] = measure(current);
+
+        std::printf("%-22s %12.1f %12.1f | %12.1f %12.1f\n", mode.name, before, after, beforeReceive, afterReceive);
+
+        if (after > 0.0 || after + afterReceive >= before + beforeReceive) {
+            std::printf("  ^ the current path still allocates\n");
+            failed++;
+        }
+    }
+
+    return failed == 0 ? 0 : 1;
+}